@@ -46,9 +46,10 @@ public:
 
 	/// @brief Binds and captures a mutex.
 	/// @param mutex Mutex to capture.
-	constexpr ScopeLock(ReferenceType mutex): BaseType(mutex)	{if (inRunTime()) mutex.capture();}
+	/// @note Not `constexpr`, as mutexes only exist at run-time.
+	ScopeLock(ReferenceType mutex): BaseType(mutex)	{mutex.capture();}
 	/// @brief Releases a mutex.
-	constexpr ~ScopeLock()										{if (inRunTime()) mutex.release();}
+	~ScopeLock()									{mutex.release();}
 
 protected:
 	using BaseType::mutex;
@@ -63,7 +64,7 @@ private:
 
 /// @brief Creates a scope lock for a given mutex.
 template<Type::Derived<Mutex> TMutex = Mutex>
-constexpr ScopeLock<TMutex> lock(TMutex& mutex) {return {mutex};}
+ScopeLock<TMutex> lock(TMutex& mutex) {return {mutex};}
 
 CTL_NAMESPACE_END
 
@@ -34,13 +34,18 @@ struct Mutex: SelfIdentified<Mutex> {
 	};
 
 	/// @brief Empty constuctor.
-	Mutex() {
+	Mutex(): Mutex(false) {}
+
+	/// @brief Constructs the mutex.
+	/// @param recursive Whether the mutex can be captured again by the thread holding it.
+	/// @note On Windows, mutexes are always recursive.
+	explicit Mutex(bool const recursive) {
 		#ifdef CTL_ON_WINDOWS
 		mutex.mutex = CreateMutexA(NULL, FALSE, NULL);
 		#else
 		pthread_mutexattr_t pat;
 		pthread_mutexattr_init(&pat);
-		pthread_mutexattr_settype(&pat, PTHREAD_MUTEX_ERRORCHECK);
+		pthread_mutexattr_settype(&pat, recursive ? PTHREAD_MUTEX_RECURSIVE : PTHREAD_MUTEX_ERRORCHECK);
 		pthread_mutex_init(&mutex.mutex, &pat);
 		pthread_mutexattr_destroy(&pat);
 		#endif
@@ -61,7 +66,8 @@ struct Mutex: SelfIdentified<Mutex> {
 		#ifdef CTL_ON_WINDOWS
 		SignalObjectAndWait(mutex.mutex, mutex.mutex, INFINITE, FALSE);
 		#else
-		pthread_mutex_lock(&mutex.mutex);
+		// Fails when capturing a non-recursive mutex the thread already holds
+		if (pthread_mutex_lock(&mutex.mutex)) return *this;
 		#endif
 		mutex.locked = true;
 		return *this;
@@ -94,12 +100,15 @@ struct Mutex: SelfIdentified<Mutex> {
 	/// @return Reference to self.
 	SelfType& release() {
 		if (!mutex.exists) return *this;
+		// Cleared while still captured, as another thread might capture it as soon as it is released
+		auto const wasLocked = mutex.locked;
+		mutex.locked = false;
 		#ifdef CTL_ON_WINDOWS
-		if (ReleaseMutex(mutex.mutex))
+		if (!ReleaseMutex(mutex.mutex))
 		#else
-		if (pthread_mutex_unlock(&mutex.mutex) != EPERM)
+		if (pthread_mutex_unlock(&mutex.mutex) == EPERM)
 		#endif
-			mutex.locked = false;
+			mutex.locked = wasLocked;
 		return *this;
 	}
 
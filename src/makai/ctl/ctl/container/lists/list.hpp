@@ -133,7 +133,7 @@ public:
 	constexpr explicit List(SizeType const size, DataType const& fill) {
 		invoke(size);
 		for (usize i = 0; i < size; ++i)
-			contents[i] = fill;
+			MX::construct(contents.data() + i, fill);
 		count = size;
 	}
 
@@ -434,7 +434,7 @@ public:
 		reserve(count);
 		if (this->count < count) {
 			for (SizeType i = this->count; i < count; ++i)
-				contents[i] = fill;
+				MX::construct(contents.data() + i, fill);
 			this->count = count;
 		}
 		return *this;
@@ -455,7 +455,7 @@ public:
 		resize(newSize);
 		if (newSize > count)
 			for (SizeType i = count; i < newSize; ++i)
-				contents[i] = fill;
+				MX::construct(contents.data() + i, fill);
 		count = newSize;
 		return *this;
 	}
@@ -564,10 +564,9 @@ public:
 		if (empty()) return 0;
 		SizeType removed = 0;
 		SizeType const ocount = count;
-		auto const start = begin();
-		for(auto i = begin(); i < end();)
-			if (ComparatorType::equals(*i, value)) {
-				squash(i-start);
+		for (SizeType i = 0; i < count;)
+			if (ComparatorType::equals(contents[i], value)) {
+				squash(i);
 				++removed;
 				--count;
 			} else ++i;
@@ -586,10 +585,9 @@ public:
 		if (empty()) return 0;
 		SizeType removed = 0;
 		SizeType const ocount = count;
-		auto const start = begin();
-		for(auto i = begin(); i < end();)
-			if (!ComparatorType::equals(*i, value)) {
-				squash(i-start);
+		for (SizeType i = 0; i < count;)
+			if (!ComparatorType::equals(contents[i], value)) {
+				squash(i);
 				++removed;
 				--count;
 			} else ++i;
@@ -609,10 +607,9 @@ public:
 		if (empty()) return 0;
 		SizeType removed = 0;
 		SizeType const ocount = count;
-		auto const start = begin();
-		for(auto i = begin(); i < end();)
-			if (predicate(*i)) {
-				squash(i-start);
+		for (SizeType i = 0; i < count;)
+			if (predicate(contents[i])) {
+				squash(i);
 				++removed;
 				--count;
 			} else ++i;
@@ -632,10 +629,9 @@ public:
 		if (empty()) return 0;
 		SizeType removed = 0;
 		SizeType const ocount = count;
-		auto const start = begin();
-		for(auto i = start; i < end();)
-			if (!predicate(*i)) {
-				squash(i-start);
+		for (SizeType i = 0; i < count;)
+			if (!predicate(contents[i])) {
+				squash(i);
 				++removed;
 				--count;
 			} else ++i;
@@ -43,7 +43,8 @@ struct AtomicCell:
 	/// @brief Value wrapper.
 	struct Wrapper {
 		/// @brief Thread synchronization barrier.
-		Mutex		oplock;
+		/// @note Recursive, as the value can be accessed while a barrier bound to it is held.
+		Mutex		oplock{true};
 		/// @brief Underlying value.
 		DataType	value;
 		/// @brief Count of reference to value.
@@ -95,7 +96,9 @@ struct AtomicCell:
 	/// @param obj Cell to reference.
 	/// @return Reference to self.
 	SelfType& operator=(SelfType&& other) {
-		wrapper = displace(other.wrapper);
+		auto const incoming = displace(other.wrapper);
+		unbind();
+		wrapper = incoming;
 		return *this;
 	}
 
@@ -109,7 +112,7 @@ struct AtomicCell:
 	/// @throw `NullPointerException` if object does not exist.
 	PointerType operator->() const {
 		if (!exists()) emptyError();
-		auto const _ = wrapper->lock();
+		// Not locked, as the value's address does not change for as long as the cell is bound to it
 		return &wrapper->value;
 	}
 
@@ -118,7 +121,6 @@ struct AtomicCell:
 	/// @throw `NullPointerException` if object does not exist.
 	ReferenceType operator*() const {
 		if (!exists()) emptyError();
-		auto const _ = wrapper->lock();
 		return wrapper->value;
 	}
 
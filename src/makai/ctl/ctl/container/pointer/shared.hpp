@@ -20,8 +20,6 @@ CTL_NAMESPACE_BEGIN
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wmismatched-new-delete"
 
-// TODO: make reference counter thread-safe
-
 /// @brief Base classes for other classes.
 namespace Base {
 	/// @brief Reference counter.
@@ -48,13 +46,38 @@ namespace Base {
 		/// @brief Checks whether the reference is bound.
 		/// @param ptr Reference to check.
 		/// @return Whether it is bound.
-		inline static bool isBound(T const& ptr) {return database.contains(ptr);}
+		inline static bool isBound(T const& ptr) {
+			auto& shard = shardOf(ptr);
+			ScopeLock<Mutex> const lock(shard.mutex);
+			return shard.database.contains(ptr);
+		}
 
 	protected:
+		/// @brief Part of the reference database, with its own lock.
+		struct Shard {
+			/// @brief References in this part of the database.
+			Database	database;
+			/// @brief Mutex for interlocking purposes.
+			Mutex		mutex;
+		};
+
+		/// @brief Amount of parts the reference database is split into.
+		/// @note References to different objects rarely share a part, so threads rarely wait on each other.
+		constexpr static usize SHARDS = 64;
+
+		/// @brief Returns the part of the reference database a given reference lives in.
+		/// @param ptr Reference to get part for.
+		/// @return Database part.
+		inline static Shard& shardOf(T const& ptr) {
+			auto const id = (usize)ptr;
+			return shards[((id >> 4) ^ (id >> 12)) % SHARDS];
+		}
+
 		/// @brief Underlying reference database.
-		inline static Database database;
-		/// @brief Mutex for interlocking purposes.
-		inline static Mutex mutex;
+		inline static Shard shards[SHARDS];
+		/// @brief Mutex for synchronization barriers.
+		/// @note Recursive, as barriers can be nested.
+		inline static Mutex mutex{true};
 	};
 }
 
@@ -160,9 +183,10 @@ public:
 	/// @brief Returns the amount of references holding the current object.
 	/// @return Reference count.
 	constexpr ssize count() const {
-		ScopeLock<> lock{mutex};
-		if (!exists()) return 0;
-		return database[ref].count;
+		if (!ref) return 0;
+		auto& shard = shardOf((pointer)ref);
+		ScopeLock<Mutex> const lock(shard.mutex);
+		return shard.database[(pointer)ref].count;
 	}
 
 	/// @brief Sets the pointer as a reference to an object.
@@ -180,7 +204,6 @@ public:
 	/// @param ptr Object to reference.
 	/// @return Reference to self.
 	constexpr SelfType& bind(SelfType const& ptr) {
-		ScopeLock<> lock{mutex};
 		if (ref == ptr) return (*this);
 		unbind();
 		if (!ptr) return (*this);
@@ -192,7 +215,6 @@ public:
 	/// @param ptr Object to reference.
 	/// @return Reference to self.
 	constexpr SelfType& bind(OtherType const& ptr) {
-		ScopeLock<> lock{mutex};
 		CTL_PTR_ASSERT_WEAK;
 		if (ref == ptr) return (*this);
 		unbind();
@@ -204,14 +226,20 @@ public:
 	/// @brief Removes the pointer as a reference to a bound object.
 	/// @return Reference to self.
 	constexpr SelfType& unbind() {
-		ScopeLock<> lock{mutex};
 		if (!exists()) return (*this);
 		CTL_PTR_IF_STRONG {
-			if (unique())
-				destroy();
-			else {
-				if (count() > 0) database[(pointer)ref].count--;
+			bool last = false;
+			{
+				auto& shard = shardOf((pointer)ref);
+				ScopeLock<Mutex> const lock(shard.mutex);
+				auto& data = shard.database[(pointer)ref];
+				if (data.count == 1) {
+					data = {false, 0};
+					last = true;
+				} else if (data.count > 0) --data.count;
 			}
+			// Deleted outside the lock, as the object might hold references living in other parts of the database
+			if (last) deleter(ref);
 		}
 		ref = nullptr;
 		return (*this);
@@ -220,7 +248,6 @@ public:
 	/// @brief Destroys (deletes) the bound object.
 	/// @return Reference to self.
 	constexpr SelfType& destroy() requires (!WEAK) {
-		ScopeLock<> lock{mutex};
 		if (!exists()) return (*this);
 		release();
 		deleter(ref);
@@ -232,7 +259,6 @@ public:
 	/// @return Reference to self.
 	/// @note Requires shared pointer type to be strong.
 	constexpr SelfType& release() requires (!WEAK) {
-		ScopeLock<> lock{mutex};
 		if (exists())
 			detach(ref);
 		return (*this);
@@ -243,9 +269,10 @@ public:
 	/// @note Requires shared pointer type to be strong.
 	constexpr static void detach(ref<DataType> const& ptr)
 	requires (!WEAK) {
-		ScopeLock<> lock{mutex};
-		if (isBound(ptr))
-			database[(pointer)ptr] = {false, 0};
+		auto& shard = shardOf((pointer)ptr);
+		ScopeLock<Mutex> const lock(shard.mutex);
+		if (shard.database.contains((pointer)ptr))
+			shard.database[(pointer)ptr] = {false, 0};
 	}
 
 	/// @brief `swap` algorithm.
@@ -257,9 +284,10 @@ public:
 	/// @return Whether the object exists.
 	constexpr bool exists() const {
 		if (!ref) return false;
-		ScopeLock<> lock{mutex};
-		CTL_PTR_IF_STRONG	return (database[(pointer)ref].count > 0);
-		else				return (database[(pointer)ref].exists);
+		auto& shard = shardOf((pointer)ref);
+		ScopeLock<Mutex> const lock(shard.mutex);
+		CTL_PTR_IF_STRONG	return (shard.database[(pointer)ref].count > 0);
+		else				return (shard.database[(pointer)ref].exists);
 	}
 
 	/// @brief Returns whether this pointer is the sole owner of the bound object.
@@ -360,7 +388,7 @@ public:
 	/// @brief Creates a synchronization barrier.
 	/// @return Sync barrier.
 	[[nodiscard]]
-	constexpr static ScopeLock<Mutex> sync() {return ::CTL::lock(mutex);}
+	static ScopeLock<Mutex> sync() {return ::CTL::lock(mutex);}
 
 	/// @brief Returns whether the bound object doesn't exist.
 	/// @return Whether the bound object doesn't exist.
@@ -407,7 +435,6 @@ public:
 	/// @brief Returns the value pointed to.
 	/// @return Reference to object being pointed to.
 	constexpr ReferenceType value() const {
-		ScopeLock<> lock{mutex};
 		if (!exists()) nullPointerError();
 		return (*ref);
 	}
@@ -437,29 +464,28 @@ public:
 
 private:
 	constexpr void attach(PointerType const& p) {
-		ScopeLock<> lock{mutex};
 		if (!p) return;
+		auto& shard = shardOf((pointer)p);
+		ScopeLock<Mutex> const lock(shard.mutex);
 		ref = p;
-		database[(pointer)p].exists = true;
-		CTL_PTR_IF_STRONG database[(pointer)p].count++;
+		shard.database[(pointer)p].exists = true;
+		CTL_PTR_IF_STRONG shard.database[(pointer)p].count++;
 	}
 
 	friend SelfType;
 	friend OtherType;
 
-	using ReferenceCounter::database;
+	using ReferenceCounter::shardOf;
 
 	/// @brief Pointer to referenced object.
 	PointerType ref = nullptr;
 
 	constexpr PointerType getPointer() {
-		ScopeLock<> lock{mutex};
 		if (!exists()) nullPointerError();
 		return (ref);
 	}
 
 	constexpr PointerType getPointer() const {
-		ScopeLock<> lock{mutex};
 		if (!exists()) nullPointerError();
 		return (ref);
 	}
@@ -131,8 +131,8 @@ namespace UTF {
 				out[2] = recast<T>(0b1000'0000 | (cid & 0b0011'1111));
 			break;
 			case 4:
-				out[1] = recast<T>(0b1110'0000 | ((cid >> 18) & 0b0000'0111));
-				out[1] = recast<T>(0b1110'0000 | ((cid >> 12) & 0b0011'1111));
+				out[0] = recast<T>(0b1111'0000 | ((cid >> 18) & 0b0000'0111));
+				out[1] = recast<T>(0b1000'0000 | ((cid >> 12) & 0b0011'1111));
 				out[2] = recast<T>(0b1000'0000 | ((cid >> 6) & 0b0011'1111));
 				out[3] = recast<T>(0b1000'0000 | (cid & 0b0011'1111));
 			break;
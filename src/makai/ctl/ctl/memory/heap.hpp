@@ -11,6 +11,7 @@
 #include <heapapi.h>
 #else
 #include <sys/mman.h>
+#include <unistd.h>
 #endif
 
 CTL_NAMESPACE_BEGIN
@@ -25,6 +26,10 @@ struct Heap {
 
 	/// @brief Heap flags.
 	struct Flags {
+		/// @brief Whether memory can hold code to run.
+		/// @note
+		///		Where supported, memory starts writable and not executable.
+		///		It only becomes executable (and stops being writable) once sealed, and reallocating it unseals it.
 		bool executable		= false;
 		bool synchronized	= false;
 		bool readonly		= false;
@@ -38,10 +43,15 @@ struct Heap {
 	~Heap() {close();}
 
 	Heap(Heap const&)	= delete;
-	Heap(Heap&&)		= default;
+	Heap(Heap&& other)	{take(other);}
 
 	Heap& operator=(Heap const&)	= delete;
-	Heap& operator=(Heap&&)			= default;
+	Heap& operator=(Heap&& other)	{
+		if (this == &other) return *this;
+		close();
+		take(other);
+		return *this;
+	}
 
 	void open(Size const sz, Flags flags) {
 		synchronize = flags.synchronized;
@@ -54,6 +64,7 @@ struct Heap {
 		if (!impl)
 			throw HeapCreationFailure();
 		#else
+		executable = flags.executable;
 		#endif
 	}
 
@@ -66,6 +77,18 @@ struct Heap {
 			return p;
 		} else return HeapAlloc(impl, HEAP_ZERO_MEMORY, sz);
 		#else
+		// Anonymous mappings are zero-filled, same as `HEAP_ZERO_MEMORY`
+		auto const size = pageAligned(headerSize() + sz);
+		auto const mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (mapping == MAP_FAILED) return nullptr;
+		auto const block = static_cast<ref<Block>>(mapping);
+		block->size = size;
+		lock();
+		block->next = blocks;
+		if (blocks) blocks->prev = block;
+		blocks = block;
+		unlock();
+		return static_cast<ref<byte>>(mapping) + headerSize();
 		#endif
 	}
 
@@ -78,6 +101,18 @@ struct Heap {
 			return p;
 		} else return HeapReAlloc(impl, HEAP_ZERO_MEMORY, at, sz);
 		#else
+		if (!at) return allocate(sz);
+		auto const capacity = blockOf(at)->size - headerSize();
+		// Reused in place, so it gets unsealed here (new blocks already start out writable)
+		if (sz <= capacity) {
+			unseal(at);
+			return at;
+		}
+		auto const p = allocate(sz);
+		if (!p) return nullptr;
+		__builtin_memcpy(p, at, capacity);
+		free(at);
+		return p;
 		#endif
 	}
 
@@ -89,6 +124,38 @@ struct Heap {
 			HeapUnlock(impl);
 		} else if (at) HeapFree(impl, 0, at);
 		#else
+		if (!at) return;
+		auto const block = blockOf(at);
+		lock();
+		if (block->prev)	block->prev->next = block->next;
+		else				blocks = block->next;
+		if (block->next)	block->next->prev = block->prev;
+		unlock();
+		munmap(block, block->size);
+		#endif
+	}
+
+	/// @brief Makes memory from an executable heap executable, and stops it from being writable.
+	/// @param at Memory to seal.
+	/// @return Whether it succeeded.
+	/// @note Does nothing for heaps that are not executable, or where memory is always writable and executable.
+	bool seal(pointer const at) const {
+		#ifdef CTL_ON_WINDOWS
+		return at;
+		#else
+		return protect(at, PROT_READ | PROT_EXEC);
+		#endif
+	}
+
+	/// @brief Makes sealed memory writable again (and not executable), so it can be patched.
+	/// @param at Memory to unseal.
+	/// @return Whether it succeeded.
+	/// @note Does nothing for heaps that are not executable, or where memory is always writable and executable.
+	bool unseal(pointer const at) const {
+		#ifdef CTL_ON_WINDOWS
+		return at;
+		#else
+		return protect(at, PROT_READ | PROT_WRITE);
 		#endif
 	}
 
@@ -98,23 +165,85 @@ struct Heap {
 			HeapDestroy(impl);
 		impl = nullptr;
 		#else
+		while (blocks) {
+			auto const block = blocks;
+			blocks = block->next;
+			munmap(block, block->size);
+		}
 		#endif
 	}
 
 	static Heap& getDefault() {
 		static Heap heap = [] () -> Heap {
 			Heap heap;
+			#ifdef CTL_ON_WINDOWS
 			heap.impl = GetProcessHeap();
 			heap.synchronize = true;
+			#else
+			heap.open({}, {.synchronized = true});
+			#endif
 			return heap;
 		} ();
 		return heap;
 	}
 
 private:
+	void take(Heap& other) {
+		#ifdef CTL_ON_WINDOWS
+		impl		= other.impl;
+		other.impl	= nullptr;
+		#else
+		blocks			= other.blocks;
+		executable		= other.executable;
+		other.blocks	= nullptr;
+		#endif
+		synchronize = other.synchronize;
+	}
+
 	#ifdef CTL_ON_WINDOWS
 	HANDLE impl = nullptr;
 	#else
+	// Header placed at the start of every mapping.
+	struct [[gnu::aligned(16)]] Block {
+		ref<Block>	prev	= nullptr;
+		ref<Block>	next	= nullptr;
+		usize		size	= 0;
+	};
+
+	static usize pageAligned(usize const sz) {
+		static usize const page = sysconf(_SC_PAGESIZE);
+		return ((sz + page - 1) / page) * page;
+	}
+
+	// Executable memory starts on a page of its own, so sealing it leaves the header (which neighbours update) writable.
+	usize headerSize() const {
+		return executable ? pageAligned(sizeof(Block)) : sizeof(Block);
+	}
+
+	ref<Block> blockOf(pointer const at) const {
+		return reinterpret_cast<ref<Block>>(static_cast<ref<byte>>(at) - headerSize());
+	}
+
+	bool protect(pointer const at, int const protection) const {
+		if (!at) return false;
+		if (!executable) return true;
+		auto const block = blockOf(at);
+		return !mprotect(at, block->size - headerSize(), protection);
+	}
+
+	void lock() const {
+		if (synchronize)
+			while (__atomic_test_and_set(&busy, __ATOMIC_ACQUIRE)) {}
+	}
+
+	void unlock() const {
+		if (synchronize)
+			__atomic_clear(&busy, __ATOMIC_RELEASE);
+	}
+
+	mutable ref<Block>	blocks		= nullptr;
+	bool			executable	= false;
+	mutable bool	busy		= false;
 	#endif
 
 	bool synchronize = false;
@@ -54,7 +54,8 @@ struct MemorySlice:
 	constexpr MemorySlice(SelfType&& other):
 		contents(::CTL::move(other.contents)),
 		length(::CTL::move(other.length)) {
-		other.contents = nullptr;
+		other.contents	= nullptr;
+		other.length	= 0;
 	}
 
 	/// @brief Copy assignment operator (deleted).
@@ -66,7 +67,8 @@ struct MemorySlice:
 		free();
 		contents	= ::CTL::move(other.contents);
 		length		= ::CTL::move(other.length);
-		other.contents = nullptr;
+		other.contents	= nullptr;
+		other.length	= 0;
 		return *this;
 	}
 
@@ -14,8 +14,18 @@
 #include <commdlg.h>
 #else
 #include <unistd.h>
+#include <fcntl.h>
 #include <sys/wait.h>
 #include <spawn.h>
+#include <cerrno>
+// Changing directories as part of a spawn is not available everywhere
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 29))
+#define CTL_OS_SPAWN_CHDIR posix_spawn_file_actions_addchdir_np
+#elif defined(__ENVIRONMENT_MAC_OS_X_VERSION_MIN_REQUIRED__) && (__ENVIRONMENT_MAC_OS_X_VERSION_MIN_REQUIRED__ >= 101500)
+#define CTL_OS_SPAWN_CHDIR posix_spawn_file_actions_addchdir_np
+#elif defined(_POSIX_VERSION) && (_POSIX_VERSION >= 202405L)
+#define CTL_OS_SPAWN_CHDIR posix_spawn_file_actions_addchdir
+#endif
 #endif
 
 CTL_NAMESPACE_BEGIN
@@ -30,6 +40,59 @@ namespace OS {
 			return "'" + arg + "'";
 			#endif
 		}
+
+		#if (CTL_TARGET_OS != CTL_OS_WINDOWS)
+		#ifndef CTL_OS_SPAWN_CHDIR
+		inline pid_t forkInto(String const& path, String const& directory, ref<ref<char>> const args) {
+			// The child reports a failed directory change or exec through the pipe, which closes on a successful exec
+			int report[2];
+			if (pipe(report)) throw Error::FailedAction(toString("could not run '", path,"!"), CTL_CPP_PRETTY_SOURCE);
+			fcntl(report[1], F_SETFD, FD_CLOEXEC);
+			auto const file	= path.cstr();
+			auto const dir	= directory.cstr();
+			pid_t const pid = fork();
+			if (!pid) {
+				close(report[0]);
+				if (!chdir(dir))
+					execvp(file, args);
+				int const error = errno;
+				write(report[1], &error, sizeof(error));
+				_exit(127);
+			}
+			close(report[1]);
+			int error = 0;
+			bool const failed = pid < 0 || read(report[0], &error, sizeof(error)) > 0;
+			close(report[0]);
+			if (!failed) return pid;
+			if (pid > 0) waitpid(pid, NULL, 0);
+			throw Error::FailedAction(toString("could not run '", path,"!"), CTL_CPP_PRETTY_SOURCE);
+		}
+		#endif
+
+		inline pid_t spawn(String const& path, String const& directory, StringList& args) {
+			List<const char*> prgArgs;
+			auto const fname = FS::fileName(path);
+			prgArgs.pushBack(fname.cstr());
+			for (String& arg: args)
+				prgArgs.pushBack(arg.cstr());
+			prgArgs.pushBack(NULL);
+			#ifndef CTL_OS_SPAWN_CHDIR
+			if (!directory.empty())
+				return forkInto(path, directory, Cast::mutate<ref<ref<char>>>(prgArgs.data()));
+			#endif
+			posix_spawn_file_actions_t actions;
+			posix_spawn_file_actions_init(&actions);
+			#ifdef CTL_OS_SPAWN_CHDIR
+			if (!directory.empty())
+				CTL_OS_SPAWN_CHDIR(&actions, directory.cstr());
+			#endif
+			pid_t pid = 0;
+			auto const status = posix_spawnp(&pid, path.cstr(), &actions, NULL, Cast::mutate<ref<ref<char>>>(prgArgs.data()), NULL);
+			posix_spawn_file_actions_destroy(&actions);
+			if (status) throw Error::FailedAction(toString("could not run '", path,"!"), CTL_CPP_PRETTY_SOURCE);
+			return pid;
+		}
+		#endif
 	}
 
 	/// @brief Returns the given path with the appropriate executable file extension for the current operating system.
@@ -45,7 +108,6 @@ namespace OS {
 	/// @param directory Directory to run in. By default, it is the same directory as the executable.
 	/// @param args Arguments to pass to executable. By default, it is empty.
 	/// @return Exit code of the executable.
-	/// @note Running the program in a separate directory is currently only supported on Windows.
 	inline int launch(String const& path, String const& directory = "", StringList args = StringList()) {
 		if (!FS::exists(path))
 			throw Error::InvalidValue("Program [" + path + "] does not exist!", CTL_CPP_PRETTY_SOURCE);
@@ -81,16 +143,8 @@ namespace OS {
 		CloseHandle(pInfo.hThread);
 		return (int)res;
 		#else
-		List<cstring> prgArgs;
-		auto const fname = FS::fileName(path);
-		prgArgs.pushBack(fname.cstr());
-		for (String& arg: args)
-			prgArgs.pushBack(arg.cstr());
-		prgArgs.pushBack(NULL);
-		pid_t pid;
 		int result;
-		posix_spawnp(&pid, path.cstr(), NULL, NULL, Cast::mutate<ref<ref<char>>>(prgArgs.data()), NULL);
-		waitpid(pid, &result, WUNTRACED | WCONTINUED);
+		waitpid(spawn(path, directory, args), &result, WUNTRACED | WCONTINUED);
 		return result;
 		#endif
 	}
@@ -99,7 +153,6 @@ namespace OS {
 	/// @param path Path to executable.
 	/// @param directory Directory to run in. By default, it is the same directory as the executable.
 	/// @param args Arguments to pass to executable. By default, it is empty.
-	/// @note Running the program in a separate directory is currently only supported on Windows.
 	inline void launchAsync(String const& path, String const& directory = "", StringList args = StringList()) {
 		if (!FS::exists(path))
 			throw Error::InvalidValue("File [" + path + "] does not exist!", CTL_CPP_PRETTY_SOURCE);
@@ -131,14 +184,7 @@ namespace OS {
 		CloseHandle(pInfo.hProcess);
 		CloseHandle(pInfo.hThread);
 		#else
-		List<const char*> prgArgs;
-		auto const fname = FS::fileName(path);
-		prgArgs.pushBack(fname.cstr());
-		for (String& arg: args)
-			prgArgs.pushBack(arg.cstr());
-		prgArgs.pushBack(NULL);
-		pid_t pid;
-		posix_spawnp(&pid, path.cstr(), NULL, NULL, Cast::mutate<ref<ref<char>>>(prgArgs.data()), NULL);
+		spawn(path, directory, args);
 		#endif
 	}
 }
@@ -1,5 +1,15 @@
 #include "binary.hpp"
 #include "../../../../file/flow.hpp"
+#include "../../../../file/get.hpp"
+
+#if (CTL_TARGET_OS == CTL_OS_WINDOWS)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 using namespace Makai;
 using namespace Makai::Anima::V2;
@@ -7,7 +17,67 @@ using namespace Makai::Anima::V2::Core::BinaryFormat;
 
 namespace BF = Makai::Anima::V2::Core::BinaryFormat;
 
+BF::MappedFile::MappedFile(String const& path) {
+	#if (CTL_TARGET_OS == CTL_OS_WINDOWS)
+	auto const file = CreateFileA(path.cstr(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file != INVALID_HANDLE_VALUE) {
+		LARGE_INTEGER fileSize;
+		if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+			// The view keeps the mapping alive by itself
+			if (auto const mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr)) {
+				data = static_cast<ref<byte const>>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+				CloseHandle(mapping);
+			}
+			if (data) size = fileSize.QuadPart;
+		}
+		CloseHandle(file);
+	}
+	#else
+	auto const file = open(path.cstr(), O_RDONLY);
+	if (file != -1) {
+		struct stat info;
+		if (!fstat(file, &info) && info.st_size > 0) {
+			auto const mapping = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+			if (mapping != MAP_FAILED) {
+				data = static_cast<ref<byte const>>(mapping);
+				size = info.st_size;
+			}
+		}
+		close(file);
+	}
+	#endif
+	mapped = data;
+	// Files inside archives (or that cannot be mapped for any other reason) get read normally
+	if (!mapped) {
+		fallback	= File::getBinary(path);
+		data		= fallback.data();
+		size		= fallback.size();
+	}
+}
+
+BF::MappedFile::~MappedFile() {
+	if (!mapped) return;
+	#if (CTL_TARGET_OS == CTL_OS_WINDOWS)
+	UnmapViewOfFile(data);
+	#else
+	munmap(const_cast<pointer>(static_cast<void const*>(data)), size);
+	#endif
+}
+
+ConstByteSpan<> BF::MappedFile::bytes() const {
+	return {data, size};
+}
+
+Result<Core::Module, BF::Error> BF::fromFile(String const& path) {
+	MappedFile const file(path);
+	return fromBytes(file.bytes());
+}
+
 Result<Core::Module, BF::Error> BF::fromBytes(Bytes<> const& source) {
+	return fromBytes(ConstByteSpan<>(source.data(), source.size()));
+}
+
+Result<Core::Module, BF::Error> BF::fromBytes(ConstByteSpan<> const& source) {
 	ByteReader reader(source);
 	Core::Module out;
 	auto const base = FileHeader::build(reader);
@@ -71,7 +141,9 @@ Result<Core::Module, BF::Error> BF::fromBytes(Bytes<> const& source) {
 					else return Error{"Failed to get type fields!"};
 					target.byteSize = type.byteSize;
 					target.alignment = type.alignment;
-					target.meta = Makai::FLOW::parse(type.meta.fromBytes<String>(reader));
+					// Only gets parsed once something asks for it
+					if (auto const meta = type.meta.fromBytes<String>(reader))
+						target.meta = Core::Module::Metadata::fromSource(meta.value());
 				}
 			} else return Error{"Failed to get type data!"};
 			if (auto const header = unpack(symbols.methods, reader)) {
@@ -93,7 +165,8 @@ Result<Core::Module, BF::Error> BF::fromBytes(Bytes<> const& source) {
 					else return Error{"Failed to get method arguments!"};
 					target.entrypoint = method.entry;
 					target.size = method.size;
-					target.meta = Makai::FLOW::parse(method.meta.fromBytes<String>(reader));
+					if (auto const meta = method.meta.fromBytes<String>(reader))
+						target.meta = Core::Module::Metadata::fromSource(meta.value());
 				}
 			} else return Error{"Failed to get method data!"};
 		} else return Error{"Failed to get module symbol data!"};
@@ -244,7 +317,7 @@ Result<Bytes<>, BF::Error> BF::toBytes(Core::Module const& module, bool const st
 							mt.flags	= type.flags;
 							if (!strip)
 								mt.name	= {builder.append(type.name)};
-							if (type.meta.isObject())
+							if (type.meta.exists())
 								mt.meta	= {builder.append(type.meta.toFLOWString())};
 						}
 					}
@@ -273,7 +346,7 @@ Result<Bytes<>, BF::Error> BF::toBytes(Core::Module const& module, bool const st
 								mm.flags	= method.flags;
 								if (!strip)
 									mm.name	= {builder.append(method.name)};
-								if (method.meta.isObject())
+								if (method.meta.exists())
 									mm.meta	= {builder.append(method.meta.toFLOWString())};
 							}
 						}
@@ -4,7 +4,19 @@
 #include "module.hpp"
 
 namespace Makai::Anima::V2::Core::BinaryFormat {
-	using IReadable = IInput<Bytes<>>;
+	struct IReadable: IInput<Bytes<>> {
+		virtual ~IReadable() {}
+
+		/// @brief Returns the next bytes, without copying them.
+		/// @param count Byte count.
+		/// @return View to the bytes. Only valid for as long as the underlying data is.
+		virtual ConstByteSpan<> view(usize const count) = 0;
+
+		Bytes<> read(usize const count) override {
+			auto const bytes = view(count);
+			return Bytes<>(bytes.data(), bytes.size());
+		}
+	};
 
 	struct IWritable: IOutput<ConstByteSpan<>> {
 		virtual ~IWritable() {}
@@ -27,25 +39,27 @@ namespace Makai::Anima::V2::Core::BinaryFormat {
 	};
 
 	struct ByteReader: IReadable {
-		Bytes<>	input;
-		usize	pointer = 0;
+		ConstByteSpan<>	input;
+		usize			pointer = 0;
 
-		Bytes<> read(usize const count) override {
+		ConstByteSpan<> view(usize const count) override {
 			MAKAILIB_DEBUGLN_FULL("Size: ", input.size());
 			MAKAILIB_DEBUGLN_FULL("Reading ", count, " bytes at index ", pointer, "...");
 			if (pointer > input.size())
 				return {};
+			auto const start = pointer;
 			pointer += count;
 			if (pointer > input.size())
-				return input.sliced(pointer - count, -1);
-			return input.sliced(pointer - count, pointer - 1);
+				return {input.data() + start, input.size() - start};
+			return {input.data() + start, count};
 		}
 
 		void go(usize const pos) override {
 			pointer = pos < (input.size() - 1) ? pos : input.size() - 1;
 		}
 
-		ByteReader(Bytes<> const& input): input(input) {}
+		ByteReader(ConstByteSpan<> const& input): input(input) {}
+		ByteReader(Bytes<> const& input): input(input.data(), input.size()) {}
 	};
 
 	struct ByteWriter: IWritable {
@@ -81,7 +95,7 @@ namespace Makai::Anima::V2::Core::BinaryFormat {
 		uint64 size		= 0;
 
 		static Nullable<Entry> build(IReadable& source) {
-			auto block = source.read(sizeof(Entry));
+			auto const block = source.view(sizeof(Entry));
 			if (block.size() < sizeof(Entry)) return null;
 			return {*(Entry*)block.data()};
 		}
@@ -94,7 +108,7 @@ namespace Makai::Anima::V2::Core::BinaryFormat {
 			auto const sz = size < sizeof(T) ? size : sizeof(T);
 			MAKAILIB_DEBUGLN_FULL("[Header<", String(nameof<T>()), "> : ", sz, "]");
 			T out;
-			auto const block = source.read(size);
+			auto const block = source.view(size);
 			MAKAILIB_DEBUGLN_FULL("Size [", size, " : ", block.size(), "]");
 			if (block.size() < sz) return null;
 			MAKAILIB_DEBUGLN_FULL("Converting...");
@@ -103,7 +117,7 @@ namespace Makai::Anima::V2::Core::BinaryFormat {
 		}
 	};
 
-	template <class T, auto CONVERT = [] (Bytes<> const&) -> Nullable<T> {return null;}>
+	template <class T, auto CONVERT = [] (ConstByteSpan<> const&) -> Nullable<T> {return null;}>
 	struct [[CTL_PACKED_STRUCT]] Table: Entry {
 		using EntryType = T;
 		constexpr static auto const convert = CONVERT;
@@ -111,19 +125,19 @@ namespace Makai::Anima::V2::Core::BinaryFormat {
 		template <class TFunc = decltype(convert)>
 		Nullable<T> readFromSource(IReadable& source, usize const index, TFunc const convert = CONVERT) const
 		requires (
-			Type::Functional<TFunc, Nullable<T>(Bytes<> const&)>
-		or	Type::Functional<TFunc, T(Bytes<> const&)>
+			Type::Functional<TFunc, Nullable<T>(ConstByteSpan<> const&)>
+		or	Type::Functional<TFunc, T(ConstByteSpan<> const&)>
 		) {
 			MAKAILIB_DEBUGLN_FULL("[", String(nameof<T>()), " @ ", index, "]");
 			if (index >= size) return null;
 			source.go(start + index * sizeof(Entry));
 			MAKAILIB_DEBUGLN_FULL("Reading entry...");
-			auto entryBlock = source.read(sizeof(Entry));
+			auto const entryBlock = source.view(sizeof(Entry));
 			if (entryBlock.size() < sizeof(Entry)) return null;
 			auto const entry = *(Entry*)entryBlock.data();
 			source.go(entry.start);
 			MAKAILIB_DEBUGLN_FULL("Reading data...");
-			auto block = source.read(entry.size);
+			auto const block = source.view(entry.size);
 			MAKAILIB_DEBUGLN_FULL("Size [", entry.size, " : ", block.size(), "]");
 			if (block.size() != entry.size) return null;
 			MAKAILIB_DEBUGLN_FULL("Converting...");
@@ -133,8 +147,8 @@ namespace Makai::Anima::V2::Core::BinaryFormat {
 		template <class TFunc = decltype(convert)>
 		Nullable<List<T>> fromBytes(IReadable& source, TFunc const convert = CONVERT) const
 	 	requires (
-			Type::Functional<TFunc, Nullable<T>(Bytes<> const&)>
-		or	Type::Functional<TFunc, T(Bytes<> const&)>
+			Type::Functional<TFunc, Nullable<T>(ConstByteSpan<> const&)>
+		or	Type::Functional<TFunc, T(ConstByteSpan<> const&)>
 		) {
 			List<T> out;
 			auto const sz = (size / sizeof(Entry));
@@ -148,7 +162,7 @@ namespace Makai::Anima::V2::Core::BinaryFormat {
 	};
 
 	template <class T>
-	constexpr T stringFromBytes(Bytes<> const& block) {
+	constexpr T stringFromBytes(ConstByteSpan<> const& block) {
 		MAKAILIB_DEBUGLN_FULL("Converting [", block.size(), "] bytes...");
 		return T(
 			String(
@@ -159,17 +173,16 @@ namespace Makai::Anima::V2::Core::BinaryFormat {
 	}
 
 	template <class T>
-	constexpr List<T> listFromBytes(Bytes<> const& block) {
+	constexpr List<T> listFromBytes(ConstByteSpan<> const& block) {
 		MAKAILIB_DEBUGLN_FULL("Converting [", block.size(), "] bytes (", block.size() / sizeof(T), " elements)...");
-		List<T> out;
-		out.reserve(block.size() / sizeof(T), T());
-		MX::excopy<T>(out.data(), (ref<T const>)block.data(), out.size());
+		// Copied straight from the source, in one go
+		List<T> out((ref<T const>)block.data(), block.size() / sizeof(T));
 		MAKAILIB_DEBUGLN_FULL("Converted!");
 		return wrap<Nullable>(out);
 	}
 
 	template <class T>
-	constexpr Nullable<T> valueFromBytes(Bytes<> const& block) {
+	constexpr Nullable<T> valueFromBytes(ConstByteSpan<> const& block) {
 		MAKAILIB_DEBUGLN_FULL("Converting [", block.size(), "] bytes...");
 		T out;
 		if (block.size() < sizeof(T)) return null;
@@ -178,7 +191,7 @@ namespace Makai::Anima::V2::Core::BinaryFormat {
 	}
 
 	template <class T>
-	constexpr T headerFromBytes(Bytes<> const& block) {
+	constexpr T headerFromBytes(ConstByteSpan<> const& block) {
 		T out;
 		MX::memmove(&out, block.data(), block.size() < sizeof(T) ? block.size() : sizeof(T));
 		return out;
@@ -190,7 +203,7 @@ namespace Makai::Anima::V2::Core::BinaryFormat {
 			MAKAILIB_DEBUGLN_FULL("[Text<", String(nameof<T>()), "> : ", size, "]");
 			if (!size) return {T()};
 			source.go(start);
-			auto block = source.read(size);
+			auto const block = source.view(size);
 			MAKAILIB_DEBUGLN_FULL("Size [", size, " : ", block.size(), "]");
 			if (block.size() != size) return null;
 			MAKAILIB_DEBUGLN_FULL("Converting...");
@@ -204,7 +217,7 @@ namespace Makai::Anima::V2::Core::BinaryFormat {
 			MAKAILIB_DEBUGLN_FULL("[Data<", String(nameof<T>()), "> : ", size, "]");
 			if (!size) return {List<T>()};
 			source.go(start);
-			auto block = source.read(size);
+			auto const block = source.view(size);
 			MAKAILIB_DEBUGLN_FULL("Size [", size, " : ", block.size(), "]");
 			if (block.size() != size) return null;
 			MAKAILIB_DEBUGLN_FULL("Converting...");
@@ -437,7 +450,36 @@ namespace Makai::Anima::V2::Core::BinaryFormat {
 		}
 	};
 
+	/// @brief Read-only view of a file's contents, mapped into memory when the OS allows it.
+	/// @details If the file cannot be mapped, it gets read into memory instead.
+	struct MappedFile {
+		/// @brief Maps a file.
+		/// @param path Path to file.
+		/// @throw File::FileLoadError if file cannot be mapped nor read.
+		MappedFile(String const& path);
+
+		~MappedFile();
+
+		MappedFile(MappedFile const&)				= delete;
+		MappedFile& operator=(MappedFile const&)	= delete;
+
+		/// @brief Returns the file's contents.
+		/// @return View to contents. Only valid for as long as the mapping is.
+		ConstByteSpan<> bytes() const;
+
+	private:
+		ref<byte const>	data	= nullptr;
+		usize			size	= 0;
+		bool			mapped	= false;
+		Bytes<>			fallback;
+	};
+
+	Result<Core::Module, Error>	fromBytes(ConstByteSpan<> const& source);
 	Result<Core::Module, Error>	fromBytes(Bytes<> const& source);
+	/// @brief Loads a module from a binary file, without reading the whole file into memory first.
+	/// @param path Path to file.
+	/// @return Module, or error.
+	Result<Core::Module, Error>	fromFile(String const& path);
 	Result<Bytes<>, Error>		toBytes(Core::Module const& source, bool const strip = false);
 }
 
@@ -76,6 +76,14 @@ void Context::unloadLibraries() {
 	loadedLibraries.clear();
 }
 
+List<ref<ALibrary>> Context::libraries() const {
+	List<ref<ALibrary>> result;
+	for (auto const& lib: loadedLibraries)
+		if (lib->impl->lib)
+			result.pushBack(lib->impl->lib.raw());
+	return result;
+}
+
 Context::MethodAdder::~MethodAdder()		{}
 Context::MethodRemover::~MethodRemover()	{}
 Context::TypeAdder::~TypeAdder()			{}
@@ -109,6 +117,7 @@ bool Context::addNativeCall(usize const hash, usize const argc, ExternalInvocati
 	method->invoker	= invoker;
 	loadedMethods.pushBack(method);
 	externalMethods[hash] = method;
+	++callRevision;
 	if (!hasNativeCall(hash))
 		throw Makai::Error::FailedAction(
 			"Failed to add external function ["+ toString(hash) + "]!",
@@ -141,6 +150,98 @@ Context::MethodResult Context::callNative(usize const hash, List<Object::Storage
 	return externalMethods[hash]->invoker->invoke(*this, *externalMethods[hash], args).value();
 }
 
+ref<Context::NativeCall> Context::nativeCallOf(usize const hash) {
+	if (!hasNativeCall(hash)) return nullptr;
+	auto& method = *externalMethods[hash];
+	if (method.retType && types.byNameHash(method.retType->hash).empty())
+		return nullptr;
+	return &method;
+}
+
+static uint64 basicHashOf(BasicType const type) {
+	switch (type) {
+		using enum BasicType;
+		case AV2_BT_BOOL:	return Anima::V2::Core::Meta::arthashof<bool>();
+		case AV2_BT_INT8:	return Anima::V2::Core::Meta::arthashof<int8>();
+		case AV2_BT_UINT8:	return Anima::V2::Core::Meta::arthashof<uint8>();
+		case AV2_BT_INT16:	return Anima::V2::Core::Meta::arthashof<int16>();
+		case AV2_BT_UINT16:	return Anima::V2::Core::Meta::arthashof<uint16>();
+		case AV2_BT_INT32:	return Anima::V2::Core::Meta::arthashof<int32>();
+		case AV2_BT_UINT32:	return Anima::V2::Core::Meta::arthashof<uint32>();
+		case AV2_BT_INT64:	return Anima::V2::Core::Meta::arthashof<int64>();
+		case AV2_BT_UINT64:	return Anima::V2::Core::Meta::arthashof<uint64>();
+		case AV2_BT_REAL32:	return Anima::V2::Core::Meta::arthashof<float32>();
+		case AV2_BT_REAL64:	return Anima::V2::Core::Meta::arthashof<float64>();
+		case AV2_BT_VECTOR:	return Anima::V2::Core::Meta::arthashof<Vector4>();
+		default:			return 0;
+	}
+}
+
+ref<AtomicCell<Definition> const> Context::basicDefinition(BasicType const type) const {
+	if (!Value::canHold(type)) return nullptr;
+	auto& def = basicDefinitions[enumcast(type)];
+	if (!def) {
+		auto const query = types.byNameHash(basicHashOf(type));
+		if (query.empty() or !query.front())
+			return nullptr;
+		def = query.front();
+	}
+	return &def;
+}
+
+void Context::resetBasicDefinitions() {
+	// Re-resolved in place, as unboxed values point into these cells for their type
+	for (usize i = 0; i < enumcast(BasicType::AV2_BT_CALLID) + 1; ++i) {
+		auto& def = basicDefinitions[i];
+		auto const type = static_cast<BasicType>(i);
+		if (!Value::canHold(type)) {
+			def = nullptr;
+			continue;
+		}
+		auto const query = types.byNameHash(basicHashOf(type));
+		if (query.empty() or !query.front())
+			def = nullptr;
+		else def = query.front();
+	}
+	++revision;
+}
+
+Value Context::unboxed(Object const& object) const {
+	if (!(object.isBasic() && object.exists()))
+		return nullptr;
+	auto const type = object.getType();
+	if (!(type && type->basic))
+		return nullptr;
+	auto const basic = *type->basic;
+	auto const def = basicDefinition(basic);
+	if (!def || *def != type || object.getOriginalType() != type)
+		return nullptr;
+	return Value(object.data(), *def, basic);
+}
+
+Context::Interned Context::intern(String const& str) {
+	if (interned.contains(str))
+		return interned[str];
+	Pool::Scope const scope(*pool);
+	UTF8String const us = str;
+	Interned contents = contents.create();
+	contents->resize(us.size() * sizeof(UTF8Char));
+	if (us.size())
+		MX::memcpy(contents->data(), us.data(), us.size() * sizeof(UTF8Char));
+	return interned[str] = contents;
+}
+
+Object::Storage Context::newInterned(Interned const& contents) const {
+	auto const query = types.byNameHash(Meta::arthashof<String>());
+	if (query.empty() or !query.front())
+		throw Makai::Error::NotFound(
+			"Could not find ART analog for the given type!",
+			CTL_CPP_PRETTY_SOURCE
+		);
+	Pool::Scope const scope(*pool);
+	return Object::create(contents, query.front(), query.front());
+}
+
 bool Context::Library::Impl::open(Makai::String const& path, Context& context) {
 	if (!Makai::OS::FS::exists(path)) return false;
 	MAKAILIB_DEBUGLN_FULL("Opening library...");
@@ -4,6 +4,7 @@
 #include "type.hpp"
 #include "method.hpp"
 #include "object.hpp"
+#include "value.hpp"
 #include "meta.hpp"
 #include "database.hpp"
 
@@ -31,7 +32,25 @@ namespace Makai::Anima::V2::Core {
 
 		using MethodResult = Result<Object::Storage, Error>;
 
-		using ICallable = IConstInvokable<MethodResult(Context&, NativeCall&, Arguments const&)>;
+		/// @brief Arguments read in place from the top of a value stack, with the first argument at the top.
+		struct StackArguments {
+			/// @brief Topmost value.
+			ref<Value const> top;
+
+			/// @brief Returns an argument.
+			/// @param index Argument index.
+			/// @return Argument.
+			Value const& operator[](usize const index) const {return *(top - index);}
+		};
+
+		struct ICallable: IConstInvokable<MethodResult(Context&, NativeCall&, Arguments const&)> {
+			/// @brief Invokes the function with its arguments read in place, without validating the call.
+			/// @param context Context to invoke in.
+			/// @param method Method being invoked.
+			/// @param args Arguments. Must hold as many values as the method takes.
+			/// @return Result, or an empty value if the function returns nothing.
+			virtual Value call(Context& context, NativeCall& method, StackArguments const& args) const = 0;
+		};
 
 		using ExternalInvocation = owner<ICallable>;
 
@@ -144,6 +163,43 @@ namespace Makai::Anima::V2::Core {
 				return Object::Storage();
 			}
 
+			template <class T>
+			static AsNormal<T> argumentAt(StackArguments const& args, usize const index) {
+				if constexpr (Unboxable<AsNormal<T>>)
+					return args[index].template toValue<AsNormal<T>>();
+				else return Meta::ARTInfo<AsNormal<T>>::construct(*args[index]);
+			}
+
+			template <Type::Functional<TReturn(TArgs...)> TFunc, usize... N>
+			static TReturn callInPlace(TFunc& f, Context& context, StackArguments const& args, IndexTuple<N...>)
+			requires (!CONTEXTUAL) {
+				return f(argumentAt<TArgs>(args, N)...);
+			}
+
+			template <class TFirst, class... TRest, Type::Functional<TReturn(TArgs...)> TFunc, usize... N>
+			static TReturn callInPlaceWithContext(TFunc& f, Context& context, StackArguments const& args, IndexTuple<N...>) {
+				return f(context, argumentAt<TRest>(args, N)...);
+			}
+
+			template <Type::Functional<TReturn(TArgs...)> TFunc, usize... N>
+			static TReturn callInPlace(TFunc& f, Context& context, StackArguments const& args, IndexTuple<N...> indices)
+			requires (CONTEXTUAL) {
+				return callInPlaceWithContext<TArgs...>(f, context, args, indices);
+			}
+
+			template <Type::Functional<TReturn(TArgs...)> TFunc>
+			[[gnu::noinline]]
+			static Value handleCall(Context& context, StackArguments const& args, TFunc& f) {
+				CTL_DO_NOT_INLINE;
+				constexpr auto INDICES = IntegerPack<sizeof...(TArgs) - CONTEXTUAL>();
+				if constexpr (Type::OneOf<AsNormal<TReturn>, Void, void>) {
+					callInPlace(f, context, args, INDICES);
+					return Value();
+				} else if constexpr (Unboxable<AsNormal<TReturn>>)
+					return context.newUnboxed<AsNormal<TReturn>>(callInPlace(f, context, args, INDICES));
+				else return Meta::ARTInfo<TReturn>::convert(context.types, callInPlace(f, context, args, INDICES));
+			}
+
 			template <Type::Functional<TReturn(TArgs...)> TFunc>
 			struct Invoker: ICallable {
 				TFunc& f;
@@ -156,6 +212,10 @@ namespace Makai::Anima::V2::Core {
 				MethodResult invoke(Context& context, NativeCall& method, Arguments const& args) const override {
 					return handleInvocation(context, method, args, f);
 				}
+
+				Value call(Context& context, NativeCall& method, StackArguments const& args) const override {
+					return handleCall(context, args, f);
+				}
 			};
 
 			template <Type::Functional<TReturn(TArgs...)> TFunc>
@@ -270,6 +330,7 @@ namespace Makai::Anima::V2::Core {
 			auto em = externalMethods[hash];
 			externalMethods.erase(hash);
 			loadedMethods.eraseLike(em);
+			++callRevision;
 		}
 
 		bool hasNativeCall(usize const& hash) const {
@@ -286,6 +347,16 @@ namespace Makai::Anima::V2::Core {
 
 		MethodResult callNative(usize const hash, List<Object::Storage> const& args);
 
+		/// @brief Returns a native call, validated for being called with its arguments read in place.
+		/// @param hash Native call hash.
+		/// @return Pointer to native call, or `nullptr` if it does not exist or cannot be called.
+		/// @note Stays valid until `nativeCallRevision` changes.
+		ref<NativeCall> nativeCallOf(usize const hash);
+
+		/// @brief Returns how many times native calls got added or removed.
+		/// @return Native call revision.
+		uint64 nativeCallRevision() const {return callRevision;}
+
 		template <class T>
 		Object::Storage newValue(T const& value) const {
 			auto const query = types.byNameHash(Meta::arthashof<T>());
@@ -295,9 +366,55 @@ namespace Makai::Anima::V2::Core {
 					CTL_CPP_PRETTY_SOURCE
 				);
 			MAKAILIB_DEBUGLN_FULL("Selected Type: ", query.front()->hash);
+			Pool::Scope const scope(*pool);
 			return Object::create(value, query.front());
 		}
 
+		/// @brief Creates a new value, held unboxed if possible.
+		/// @tparam T Value type.
+		/// @param value Value to create.
+		/// @return New value.
+		template <class T>
+		Value newUnboxed(T const& value) const {
+			if constexpr (Unboxable<T>)
+				if (auto const def = basicDefinition(unboxedTypeOf<T>()))
+					return Value(value, *def);
+			return newValue(value);
+		}
+
+		/// @brief Returns an unboxed copy of an object, if it holds a value that can be held unboxed.
+		/// @param object Object to copy.
+		/// @return Unboxed copy, or an empty value if it cannot be held unboxed.
+		Value unboxed(Object const& object) const;
+
+		/// @brief Returns the definition unboxed values of a given basic type are created with.
+		/// @param type Basic type to get definition for.
+		/// @return Pointer to definition, or `nullptr` if the type cannot be held unboxed or does not exist.
+		ref<AtomicCell<Definition> const> basicDefinition(BasicType const type) const;
+
+		/// @brief Re-resolves the cached basic definitions in place. Must be called whenever `types` gets modified.
+		/// @note Cells are never cleared out from under unboxed values that point into them.
+		/// @note Also invalidates anything else cached from type definitions (see `typeRevision`).
+		void resetBasicDefinitions();
+
+		/// @brief Returns how many times `types` got modified, as reported through `resetBasicDefinitions`.
+		/// @return Type database revision.
+		uint64 typeRevision() const {return revision;}
+
+		/// @brief Interned string contents. Shared by every string created from them, which makes them comparable by address.
+		using Interned = AtomicCell<Object::Memory>;
+
+		/// @brief Returns the interned contents of a string, interning it if it is not already.
+		/// @param str String to intern.
+		/// @return Interned contents.
+		Interned intern(String const& str);
+
+		/// @brief Creates a string holding interned contents, without copying them.
+		/// @param contents Interned contents.
+		/// @return New string.
+		/// @note Appending to the string copies its contents first.
+		Object::Storage newInterned(Interned const& contents) const;
+
 		template <class T>
 		Object::Storage newEmpty() const {
 			auto const query = types.byNameHash(Meta::arthashof<T>());
@@ -307,6 +424,7 @@ namespace Makai::Anima::V2::Core {
 					CTL_CPP_PRETTY_SOURCE
 				);
 			MAKAILIB_DEBUGLN_FULL("Selected Type: ", query.front()->hash);
+			Pool::Scope const scope(*pool);
 			return Object::create(query.front());
 		}
 
@@ -326,6 +444,7 @@ namespace Makai::Anima::V2::Core {
 		bool addNativeType() {
 			if (hasNativeType<T>()) return false;
 			types.addElement(Meta::implement<T>(types));
+			resetBasicDefinitions();
 			return true;
 		}
 
@@ -340,17 +459,26 @@ namespace Makai::Anima::V2::Core {
 			auto const type = types.queryByNameHash(Meta::arthashof<T>()).front();
 			if (type->flags.isProxy)
 				types.values[type->id] = nullptr;
+			resetBasicDefinitions();
 		}
 
 		void loadLibraries();
 		void unloadLibraries();
 
+		/// @brief Returns the libraries currently open.
+		/// @return Open libraries.
+		List<ref<ALibrary>> libraries() const;
+
 		~Context();
 
 		Database<Definition>				types;
 		Database<Method>					methods;
 		Map<usize, Instance<NativeCall>>	externalMethods;
 		Dictionary<Instance<Library>>		dynlibs;
+		/// @brief Pool objects created by the context get allocated from.
+		Pool::Handle						pool;
+		/// @brief Interned strings (see `intern`).
+		Dictionary<Interned>				interned;
 
 		static Instance<OutputStringWriter> writer;
 
@@ -358,6 +486,11 @@ namespace Makai::Anima::V2::Core {
 		List<Instance<NativeCall>>	loadedMethods;
 		List<Instance<Library>>		loadedLibraries;
 		List<Reference<ALibrary>>	toBeLoaded;
+
+		mutable AtomicCell<Definition>	basicDefinitions[enumcast(BasicType::AV2_BT_CALLID) + 1];
+
+		uint64	revision		= 0;
+		uint64	callRevision	= 0;
 	};
 }
 
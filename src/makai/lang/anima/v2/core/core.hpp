@@ -5,9 +5,12 @@
 #include "instruction.hpp"
 #include "meta.hpp"
 #include "entry.hpp"
+#include "pool.hpp"
 #include "method.hpp"
 #include "type.hpp"
 #include "object.hpp"
+#include "value.hpp"
+#include "view.hpp"
 #include "context.hpp"
 #include "database.hpp"
 #include "module.hpp"
@@ -3,6 +3,10 @@
 
 #include "context.hpp"
 
+namespace Makai::Anima::V2::Runtime {
+	struct Precompiled;
+}
+
 namespace Makai::Anima::V2::Core {
 	struct ALibrary {
 		virtual ~ALibrary();
@@ -15,6 +19,10 @@ namespace Makai::Anima::V2::Core {
 		virtual Data::Version	version() const	{return Data::Version{0};		}
 		virtual usize			hash() const	{return Makai::hash(name());	}
 
+		/// @brief Returns the code the library holds, compiled ahead of time from a module, if it holds any.
+		/// @return Precompiled code, or `nullptr` if none.
+		virtual ref<Runtime::Precompiled const> precompiled() const {return nullptr;}
+
 		pointer operator new(usize sz) noexcept;
 		pointer operator new[](usize sz) noexcept;
 
@@ -91,6 +91,24 @@ namespace Makai::Anima::V2::Core {
 				}
 			};
 		}
+		/// @brief Returns how many operand words the engine reads for the location.
+		/// @return Operand count, or `null` if it depends on who emitted the bytecode.
+		Nullable<usize> operands() const {
+			switch (desc.source) {
+				case Source::AV2_VLS_BOOL:	return usize(0);
+				// The assembler does not emit an ID for null locations, while the engine expects one
+				case Source::AV2_VLS_NULL:	return null;
+				case Source::AV2_VLS_INT:
+				case Source::AV2_VLS_REAL:
+				case Source::AV2_VLS_STRING:
+				case Source::AV2_VLS_STACK:
+				case Source::AV2_VLS_STACK_OFFSET:
+				case Source::AV2_VLS_GLOBAL:
+				case Source::AV2_VLS_EXTERNAL:
+				case Source::AV2_VLS_LOCAL:	return usize(1);
+			}
+			return null;
+		}
 	};
 
 	static_assert(sizeof(ValueLocation) == sizeof(uint8));
@@ -150,6 +168,8 @@ namespace Makai::Anima::V2::Core {
 			uint8	optional:	1;
 			uint8	noResult:	1;
 			uint8	async:		1;
+			/// @brief Call is in tail position. Its callee reuses the caller's frame, and returns straight to wherever the caller would have.
+			uint8	tail:		1;
 		};
 
 		/// @brief Jump leap.
@@ -472,6 +492,73 @@ namespace Makai::Anima::V2::Core {
 		requires (sizeof(T) == 8) {
 			return Cast::bit<T>(*this);
 		}
+
+		/// @brief Returns how many words the instruction takes, operands included, mirroring what the engine reads.
+		/// @return Instruction size, or `null` if it cannot be known from the instruction alone.
+		Nullable<usize> size() const {
+			switch (name) {
+				case Name::AV2_IN_NO_OP:
+				case Name::AV2_IN_HALT:
+				case Name::AV2_IN_MODE:
+				case Name::AV2_IN_STACK_POP:
+				case Name::AV2_IN_STACK_SWAP:
+				case Name::AV2_IN_STACK_CLEAR:
+				case Name::AV2_IN_STACK_FLUSH:
+				case Name::AV2_IN_STACK_GROW:
+				case Name::AV2_IN_RETURN:
+				case Name::AV2_IN_RANDOM:
+				case Name::AV2_IN_SCOPE_ENTER:
+				case Name::AV2_IN_SCOPE_EXIT:
+				case Name::AV2_IN_SCOPE_DECLARE:
+				case Name::AV2_IN_SCOPE_KEEP:
+				case Name::AV2_IN_SIZEOF:
+				case Name::AV2_IN_TYPEOF:
+				case Name::AV2_IN_CLEAR:
+				case Name::AV2_IN_INITIALIZE:
+				case Name::AV2_IN_BREAKPOINT:	return usize(1);
+				case Name::AV2_IN_STACK_BLIT:
+				case Name::AV2_IN_SCOPE_BIND:	return usize(2);
+				case Name::AV2_IN_SCOPE_BRING:	return usize(3);
+				case Name::AV2_IN_COPY: {
+					auto const transfer	= getTypeAs<Transfer>();
+					auto const from		= transfer.from.operands();
+					auto const to		= transfer.to.operands();
+					if (!(from && to)) return null;
+					return 1 + *from + *to;
+				}
+				case Name::AV2_IN_STACK_PUSH: {
+					auto const operands = getTypeAs<StackPush>().location.operands();
+					if (!operands) return null;
+					return 1 + *operands;
+				}
+				case Name::AV2_IN_COMPARE: {
+					auto const comp = getTypeAs<Comparison>();
+					// The assembler does not emit the string ID for text immediates
+					if (comp.immediate && comp.sameType && isText(Cast::as<BasicType>(comp.assume))) return null;
+					return usize(1 + comp.immediate);
+				}
+				case Name::AV2_IN_OP: {
+					auto const op = getTypeAs<Operation>();
+					if (op.immediate && op.sameType && isText(Cast::as<BasicType>(op.assume))) return null;
+					return usize(1 + op.immediate);
+				}
+				case Name::AV2_IN_CALL:			return usize(1 + !getTypeAs<Invocation>().dynamic);
+				case Name::AV2_IN_JUMP:			return usize(1 + !getTypeAs<Leap>().dyn);
+				case Name::AV2_IN_CAST:			return usize(1 + !getTypeAs<Casting>().dynamic);
+				case Name::AV2_IN_FIELD_GET:
+				case Name::AV2_IN_FIELD_SET:	return usize(1 + !getTypeAs<Field>().dynamic);
+				case Name::AV2_IN_SELECT:		return usize(1 + getTypeAs<Selection>().count);
+				case Name::AV2_IN_YIELD: {
+					auto const wait = getTypeAs<Waiting>();
+					return usize(1 + !(wait.dynamic || wait.once));
+				}
+				case Name::AV2_IN_CREATE: {
+					auto const create = getTypeAs<Create>();
+					return usize(1 + !create.dyn + (create.forArray && !create.dynSize));
+				}
+			}
+			return null;
+		}
 	};
 
 	using Bytecode = List<Core::Instruction>;
@@ -5,6 +5,7 @@
 #include "method.hpp"
 #include "object.hpp"
 #include "database.hpp"
+#include "view.hpp"
 
 namespace Makai::Anima::V2::Core::Meta {
 	namespace Impl {
@@ -227,6 +228,23 @@ namespace Makai::Anima::V2::Core::Meta {
 			}
 		};
 
+		template<> struct ARTTI<HostView> {
+			constexpr static auto const ART_HASH = HostView::ART_HASH;
+
+			static HostView construct(Object const& value) {
+				return HostView::construct(value);
+			}
+
+			/// @note Only the view gets copied into the object, not the elements it points to.
+			static Object::Storage convert(Database<Definition>& db, HostView const& value) {
+				AtomicCell<Object::Memory> content = content.create();
+				content->resize(sizeof(HostView));
+				MX::memcpy(content->data(), &value, sizeof(HostView));
+				auto const type = db.byNameHash(ART_HASH).front();
+				return Object::create(content, type, type);
+			}
+		};
+
 		template<> struct ARTTI<Data::Value> {
 			constexpr static auto const ART_HASH = ConstHasher::hash("any");
 
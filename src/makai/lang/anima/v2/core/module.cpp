@@ -1,5 +1,6 @@
 #include "module.hpp"
 #include "../../../../tool/archive/archive.hpp"
+#include "../../../../file/flow.hpp"
 
 using namespace Makai;
 using namespace Makai::Anima::V2::Core;
@@ -119,6 +120,11 @@ Makai::Data::Value Module::serialize(bool forceSymbolsToBeKept) const {
 	return out;
 }
 
+uint64 Module::fingerprint() const {
+	auto const hash = ConstHasher::hash(code.data(), code.size());
+	return hash ^ (ConstHasher::hash(jumpTable.data(), jumpTable.size()) * 31);
+}
+
 Module::ANI Module::ANI::deserialize(Makai::Data::Value const& v) {
 	ANI ani;
 	if (v.contains("in")) {
@@ -208,6 +214,40 @@ Module::Detail Module::Detail::deserialize(Makai::Data::Value const& v) {
 	return result;
 }
 
+Module::Metadata Module::Metadata::fromSource(String const& source) {
+	Metadata result;
+	result.source = source;
+	return result;
+}
+
+Makai::Data::Value& Module::Metadata::get() {
+	static_cast<Metadata const&>(*this).get();
+	return value;
+}
+
+/// Guards lazily parsed metadata, as a loaded program can be shared across threads.
+static Mutex metadataSync;
+
+Makai::Data::Value const& Module::Metadata::get() const {
+	ScopeLock<Mutex> const lock(metadataSync);
+	if (source.size()) {
+		value = FLOW::parse(source);
+		source.clear();
+	}
+	return value;
+}
+
+Makai::String Module::Metadata::toFLOWString() const {
+	ScopeLock<Mutex> const lock(metadataSync);
+	if (source.size()) return source;
+	return value.toFLOWString();
+}
+
+bool Module::Metadata::exists() const {
+	ScopeLock<Mutex> const lock(metadataSync);
+	return source.size() || !value.isUndefined();
+}
+
 Makai::Data::Value Module::Detail::serialize() const {
 	auto result = Data::Value::object();
 	result["types"]		= result.array();
@@ -230,7 +270,7 @@ Makai::Data::Value Module::Method::serialize() const {
 	result["flags"] = bitcast<uint64>(flags);
 	result["entry"] = entrypoint;
 	result["size"] = size;
-	result["meta"] = meta;
+	result["meta"] = meta.get();
 	return result;
 }
 
@@ -270,8 +310,8 @@ Makai::Data::Value Module::Declaration::serialize() const {
 		result["align"] = alignment;
 	if (fields.size())
 		result["fields"] = fields.toList<Data::Value>().filter(valueExists);
-	if (!meta.isUndefined())
-		result["meta"] = meta;
+	if (meta.exists())
+		result["meta"] = meta.get();
 	return result;
 }
 
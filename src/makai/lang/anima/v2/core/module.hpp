@@ -23,6 +23,38 @@ namespace Makai::Anima::V2::Core {
 
 		using Refs = List<Symbol>;
 
+		/// @brief Symbol metadata. Can be kept as its FLOW source, and only get parsed when first accessed.
+		/// @note Safe to access from multiple threads, as the parse is done under a lock.
+		struct Metadata {
+			Metadata() {}
+
+			Metadata(Data::Value const& value): value(value) {}
+
+			/// @brief Creates the metadata from its FLOW source, without parsing it.
+			/// @param source FLOW source.
+			/// @return Metadata.
+			static Metadata fromSource(String const& source);
+
+			/// @brief Returns the metadata, parsing it if it has not been yet.
+			/// @return Metadata.
+			Data::Value& get();
+			/// @brief Returns the metadata, parsing it if it has not been yet.
+			/// @return Metadata.
+			Data::Value const& get() const;
+
+			/// @brief Returns the metadata as FLOW. Does not parse it, if it has not been yet.
+			/// @return Metadata as FLOW.
+			String toFLOWString() const;
+
+			/// @brief Returns whether there is any metadata. Does not parse it, if it has not been yet.
+			/// @return Whether there is metadata.
+			bool exists() const;
+
+		private:
+			mutable Data::Value	value;
+			mutable String		source;
+		};
+
 		struct Method {
 			uint64			id;
 			UTF8String		name;
@@ -32,7 +64,7 @@ namespace Makai::Anima::V2::Core {
 			List<uint64>	argTypes;
 			uint64			entrypoint;
 			uint64			size;
-			Data::Value		meta;
+			Metadata		meta;
 
 			Data::Value serialize() const;
 			static Method deserialize(Data::Value const& v);
@@ -49,7 +81,7 @@ namespace Makai::Anima::V2::Core {
 			uint64						alignment	= 0;
 			List<uint64>				fields;
 			MethodTable					vtable;
-			Data::Value					meta;
+			Metadata					meta;
 
 			Data::Value serialize() const;
 			static Declaration deserialize(Data::Value const& v);
@@ -92,6 +124,11 @@ namespace Makai::Anima::V2::Core {
 
 		static Module deserialize(Data::Value const& v);
 
+		/// @brief Returns a hash of the module's code and jump table.
+		/// @return Fingerprint.
+		/// @note Used to tell whether code compiled ahead of time got compiled from this module.
+		uint64 fingerprint() const;
+
 		Type			type		= Type::AV2_CMT_CLI_EXE;
 		String			name;
 		uint64			flags		= 0;
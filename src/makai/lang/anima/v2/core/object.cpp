@@ -4,10 +4,90 @@
 using namespace Makai;
 using namespace Makai::Anima::V2::Core;
 
+/// Calls `f`, templated on the C++ type packed elements of a given basic type are stored as.
+template <class F>
+static bool withElementType(BasicType const type, F const& f) {
+	switch (type) {
+		using enum BasicType;
+		case AV2_BT_BOOL:		return f.template operator()<bool>();
+		case AV2_BT_INT8:		return f.template operator()<int8>();
+		case AV2_BT_UINT8:		return f.template operator()<uint8>();
+		case AV2_BT_INT16:		return f.template operator()<int16>();
+		case AV2_BT_UINT16:		return f.template operator()<uint16>();
+		case AV2_BT_INT32:		return f.template operator()<int32>();
+		case AV2_BT_UINT32:		return f.template operator()<uint32>();
+		case AV2_BT_INT64:		return f.template operator()<int64>();
+		case AV2_BT_UINT64:		return f.template operator()<uint64>();
+		case AV2_BT_REAL32:		return f.template operator()<float32>();
+		case AV2_BT_REAL64:		return f.template operator()<float64>();
+		case AV2_BT_REAL128:	return f.template operator()<float128>();
+		case AV2_BT_VECTOR:		return f.template operator()<Vector4>();
+		default: return false;
+	}
+}
+
+/// Whether packed elements of the type can be converted to and from other basic types.
+static bool isConvertible(Definition const& element) {
+	return element.basic && (isVectorable(*element.basic) || isBoolean(*element.basic));
+}
+
+/// Whether packed elements of the type can be operated on.
+static bool isArithmetic(Definition const& element) {
+	return element.basic && isVectorable(*element.basic);
+}
+
+/// Writes a value into a packed element, converting it to the element's type if it is a different basic type.
+static bool storeElement(pointer const at, Definition const& element, Object const& value) {
+	if (isConvertible(element))
+		return withElementType(*element.basic, [&] <class T> () {
+			if (!value.canBecome<T>()) return false;
+			*ref<T>(at) = value.toValue<T>();
+			return true;
+		});
+	if (!value.exists() || value.byteSize() != element.byteSize)
+		return false;
+	MX::memcpy(at, value.data(), element.byteSize);
+	return true;
+}
+
+/// Applies an arithmetic operator to a run of elements, with `rhs(i)` as the right-hand operand of each.
+template <class T, class F>
+static bool mapElements(ref<T> const data, usize const count, Operator const op, F const& rhs) {
+	switch (op) {
+		using enum Operator;
+		case AV2_BOP_ADD: for (usize i = 0; i < count; ++i) data[i] = data[i] + rhs(i); return true;
+		case AV2_BOP_SUB: for (usize i = 0; i < count; ++i) data[i] = data[i] - rhs(i); return true;
+		case AV2_BOP_MUL: for (usize i = 0; i < count; ++i) data[i] = data[i] * rhs(i); return true;
+		case AV2_BOP_DIV:
+			if constexpr (Makai::Type::Integer<T>)
+				for (usize i = 0; i < count; ++i) if (!rhs(i)) return false;
+			for (usize i = 0; i < count; ++i) data[i] = data[i] / rhs(i);
+			return true;
+		case AV2_BOP_REM:
+			if constexpr (Makai::Type::Integer<T>) {
+				for (usize i = 0; i < count; ++i) if (!rhs(i)) return false;
+				for (usize i = 0; i < count; ++i) data[i] = data[i] % rhs(i);
+				return true;
+			} else if constexpr (Makai::Type::Real<T>) {
+				for (usize i = 0; i < count; ++i) data[i] = Makai::Math::mod(data[i], rhs(i));
+				return true;
+			} else return false;
+		default: return false;
+	}
+}
+
 Object::~Object() {
 	unset();
 }
 
+pointer Object::operator new(usize const size) {
+	return Pool::acquire(size, true);
+}
+
+void Object::operator delete(pointer const mem) {
+	Pool::release(mem);
+}
+
 Object::Storage Object::as(AtomicCell<Definition> const& newType) const {
 	if (type && type->canBecome(newType))
 		return Object::create(*this, newType);
@@ -70,6 +150,11 @@ Object::SetError Object::setAtIndex(uint64 const index, Object::Storage const& v
 			if (!t->base->flags.isCopyable)
 				return SetError::AV2_COSE_FIELD_IS_NOT_COPYABLE;
 		} else return SetError::AV2_COSE_TYPE_DOES_NOT_CONTAIN_FIELDS;
+		if (t->flags.isArray) {
+			if (!(value && storeElement(addressAt(index), *origin->base, *value)))
+				return SetError::AV2_COSE_FIELD_IS_NOT_COPYABLE;
+			return SetError::AV2_COSE_OK;
+		}
 		MX::memcpy(addressAt(index), value->content->data(), value->getType()->byteSize);
 		return SetError::AV2_COSE_OK;
 	}
@@ -82,8 +167,108 @@ Object::SetError Object::setAtIndex(uint64 const index, Object::Storage const& v
 	return SetError::AV2_COSE_FIELD_DOES_NOT_EXIST;
 }
 
+Object::FieldAccess Object::accessField(uint64 const index) const {
+	auto const t = getType();
+	if (!(t && origin)) return {};
+	auto const tf = t->flags;
+	auto const of = origin->flags;
+	// Accessors check the current type, while layout comes from the original one
+	if (tf.isValueType != of.isValueType || tf.isArray != of.isArray || tf.isStructure != of.isStructure)
+		return {};
+	if (!(tf.isArray || tf.isStructure))
+		return {};
+	if (tf.isStructure && index >= t->fields.size())
+		return {};
+	FieldAccess access{.type = t, .origin = origin, .index = index};
+	if (!tf.isValueType) {
+		access.kind		= FieldAccess::Kind::AV2_COFA_REFERENCE;
+		access.limit	= tf.isStructure ? t->fields.size() : Limit::MAX<usize>;
+		return access;
+	}
+	if (!of.isCopyable) return {};
+	if (tf.isStructure) {
+		if (index >= origin->fields.size() || !t->fields[index]->flags.isCopyable)
+			return {};
+		auto const field	= origin->fields[index];
+		access.kind			= FieldAccess::Kind::AV2_COFA_STRUCTURE_VALUE;
+		access.offset		= offsetOf(index);
+		access.size			= field->byteSize;
+		access.fieldType	= field;
+		access.fieldOrigin	= field;
+		return access;
+	}
+	if (!(t->base && origin->base && t->base->flags.isCopyable && origin->base->flags.isCopyable))
+		return {};
+	if (!origin->base->byteSize) return {};
+	access.kind			= FieldAccess::Kind::AV2_COFA_ARRAY_VALUE;
+	access.stride		= origin->byteSize;
+	access.size			= origin->base->byteSize;
+	access.fieldType	= t->base;
+	access.fieldOrigin	= origin->base;
+	return access;
+}
+
+Object::Storage Object::getAtIndex(FieldAccess const& access, uint64 const index) const {
+	usize offset = access.offset;
+	switch (access.kind) {
+		using enum FieldAccess::Kind;
+		case AV2_COFA_REFERENCE:
+			if (index < access.limit && index < fields.size())
+				return fields[index];
+			return null;
+		case AV2_COFA_ARRAY_VALUE:
+			if (!content || index >= content->size() / access.size)
+				return null;
+			offset = index * access.stride;
+		[[fallthrough]];
+		case AV2_COFA_STRUCTURE_VALUE: {
+			if (!content || content->size() < offset + access.size)
+				return null;
+			auto const mem = AtomicCell<Memory>::create();
+			mem->resize(access.size);
+			MX::memcpy(mem->data(), content->data() + offset, access.size);
+			return create(mem, access.fieldType, access.fieldOrigin);
+		}
+	}
+	return null;
+}
+
+bool Object::setAtIndex(FieldAccess const& access, uint64 const index, Object::Storage const& value) {
+	usize offset = access.offset;
+	switch (access.kind) {
+		using enum FieldAccess::Kind;
+		case AV2_COFA_REFERENCE:
+			if (!(index < access.limit && index < fields.size()))
+				return false;
+			fields[index] = value;
+			return true;
+		case AV2_COFA_ARRAY_VALUE:
+			if (!content || index >= content->size() / access.size)
+				return false;
+			return value && storeElement(content->data() + index * access.stride, *access.fieldOrigin, *value);
+		case AV2_COFA_STRUCTURE_VALUE: {
+			if (!content || content->size() < offset + access.size)
+				return false;
+			if (!(value && value->exists() && value->byteSize() == access.size))
+				return false;
+			MX::memcpy(content->data() + offset, value->data(), access.size);
+			return true;
+		}
+	}
+	return false;
+}
+
 bool Object::push(Object::Storage const& value) {
 	if (!isArray()) return false;
+	if (isPacked()) {
+		if (!(value && content)) return false;
+		auto const size = content->size();
+		content->expand(size + origin->byteSize);
+		if (storeElement(content->data() + size, *origin->base, *value))
+			return true;
+		content->expand(size);
+		return false;
+	}
 	fields.pushBack(value);
 	return true;
 }
@@ -91,9 +276,103 @@ bool Object::push(Object::Storage const& value) {
 Makai::Nullable<Object::Storage> Object::pop() {
 	if (!isArray()) return null;
 	if (!count()) return null;
+	if (isPacked()) {
+		auto const last = cloneFrom(count() - 1);
+		content->expand(content->size() - origin->byteSize);
+		return last;
+	}
 	return fields.popBack();
 }
 
+bool Object::fill(Object::Storage const& value) {
+	if (!(isPacked() && value && content)) return false;
+	auto const n = count();
+	if (!n) return true;
+	auto const stride	= origin->byteSize;
+	auto const data		= content->data();
+	// Only the first element gets converted, the rest are copies of it
+	if (!storeElement(data, *origin->base, *value))
+		return false;
+	for (usize i = 1; i < n; ++i)
+		MX::memcpy(data + i * stride, data, stride);
+	return true;
+}
+
+bool Object::copyFrom(Object const& other) {
+	if (!(isPacked() && other.isPacked() && content)) return false;
+	auto const& element	= *origin->base;
+	auto const& source	= *other.origin->base;
+	if (element.byteSize != source.byteSize || element.basic != source.basic)
+		return false;
+	if (!element.basic && origin->base != other.origin->base)
+		return false;
+	auto const size = other.content ? other.content->size() : 0;
+	if (content->size() != size)
+		content->resize(size);
+	if (size) MX::memmove(content->data(), other.content->data(), size);
+	return true;
+}
+
+bool Object::map(Operator const op, Object::Storage const& operand) {
+	if (!(isPacked() && operand && content)) return false;
+	auto const& element = *origin->base;
+	if (!isArithmetic(element)) return false;
+	auto const n = count();
+	return withElementType(*element.basic, [&] <class T> () {
+		if constexpr (Makai::Type::Equal<T, bool>) return false;
+		else {
+			auto const data = ref<T>(content->data());
+			if (operand->isArray()) {
+				if (!(operand->isPacked() && operand->origin->base->basic == element.basic))
+					return false;
+				auto const m = Makai::Math::min(n, operand->count());
+				if (!m) return true;
+				auto const other = ref<T const>(operand->content->data());
+				return mapElements<T>(data, m, op, [&] (usize const i) {return other[i];});
+			}
+			if (!operand->canBecome<T>()) return false;
+			auto const rhs = operand->toValue<T>();
+			return mapElements<T>(data, n, op, [&] (usize const) {return rhs;});
+		}
+	});
+}
+
+Object::Storage Object::sum() const {
+	if (!isPacked()) return null;
+	auto const& element = *origin->base;
+	if (!isArithmetic(element)) return null;
+	Storage result = nullptr;
+	withElementType(*element.basic, [&] <class T> () {
+		T total = T();
+		if (auto const n = count()) {
+			auto const data = ref<T const>(content->data());
+			for (usize i = 0; i < n; ++i)
+				total = total + data[i];
+		}
+		auto const mem = AtomicCell<Memory>::create();
+		mem->resize(sizeof(T));
+		MX::memcpy(mem->data(), &total, sizeof(T));
+		result = create(mem, getType()->base, origin->base);
+		return true;
+	});
+	return result;
+}
+
+bool Object::append(Object const& other) {
+	if (!(isString() && other.isString())) return false;
+	// Shared contents (e.g. interned strings) must stay as they are
+	if (!(content && content.unique())) return false;
+	auto const _ = content.sync();
+	auto const size = content->size();
+	auto const extra = other.content ? other.content->size() : 0;
+	if (!extra) return true;
+	content->expand(size + extra);
+	// Appending a string to itself reads from the just-grown buffer
+	auto const from = (other.content == content) ? content->data() : other.content->data();
+	MX::memmove(content->data() + size, from, extra);
+	return true;
+}
+
 Object::Storage Object::clone() const {
 	if (origin->flags.isCopyable)
 		return create(*this);
@@ -136,6 +415,12 @@ Object::Object(Object const& other, nulltype): Object(other.getType(), other.get
 }
 
 void Object::reserveFields(usize const count) {
+	if (isPacked()) {
+		if (!content) content = content.create();
+		content->resize(count * origin->byteSize);
+		if (content->size()) MX::memset(content->data(), 0, content->size());
+		return;
+	}
 	fields.reserve(count, null);
 	if (fields.size() < count) [[unlikely]]
 		throw Error::FailedAction("Failed to reserve fields!", CTL_CPP_PRETTY_SOURCE);
@@ -166,7 +451,7 @@ usize Object::count() const {
 	if (!origin) return -1;
 	if (!isValueType())
 		return fields.size();
-	if (!(content & content->size())) return 0;
+	if (!(content && content->size())) return 0;
 	else if (isArray())
 		return content->size() / origin->base->byteSize;
 	else if (isStructure())
@@ -175,15 +460,19 @@ usize Object::count() const {
 }
 
 pointer Object::addressAt(usize index) const {
+	return content->data() + offsetOf(index);
+}
+
+usize Object::offsetOf(usize index) const {
 	if (isArray())
-		return (content->data() + index * origin->byteSize);
+		return index * origin->byteSize;
 	else if (isStructure()) {
 		auto const fcount = origin->fields.size();
-		ref<byte> addr = content->data();
+		usize offset = 0;
 		while (index > 0)
-			addr += origin->fields[fcount - (--index)]->byteSize;
-		return addr;
-	} else return content->data();
+			offset += origin->fields[fcount - (--index)]->byteSize;
+		return offset;
+	} else return 0;
 }
 
 AtomicCell<Definition> Object::getType() const {
@@ -15,10 +15,13 @@ namespace Makai::Anima::V2::Core {
 
 	struct Object {
 		using Storage = ObjectStorage;
-		using Memory = MemorySlice<byte>;
+		using Memory = PooledMemory;
 
 		~Object();
 
+		pointer operator new(usize const size);
+		void operator delete(pointer const mem);
+
 		pointer			data()				{return content->data();	}
 		ref<void const>	data() const		{return content->data();	}
 		usize			byteSize() const	{return origin->byteSize;	}
@@ -299,6 +302,11 @@ namespace Makai::Anima::V2::Core {
 			return (origin->flags.isArray);
 		}
 
+		/// @brief Returns whether the object is an array storing its elements' raw values, one after the other, in a single buffer.
+		bool isPacked() const {
+			return isArray() && isValueType();
+		}
+
 		bool isStructure() const {
 			if (!origin) return false;
 			return (origin->flags.isStructure);
@@ -329,6 +337,8 @@ namespace Makai::Anima::V2::Core {
 
 		Ordered::OrderType compareWith(Storage const& other) const {
 			if (!other) return Ordered::Order::GREATER;
+			// Interned strings are compared by their contents' address
+			if (isString() && sharesContentsWith(*other)) return Ordered::Order::EQUAL;
 			if (!count())
 				return (!other->count()) ? Ordered::Order::EQUAL : Ordered::Order::LESS;
 			if (!type->compare)
@@ -357,9 +367,103 @@ namespace Makai::Anima::V2::Core {
 
 		SetError setAtIndex(uint64 const index, Storage const& value);
 
+		/// @brief Field access, resolved ahead of time.
+		/// @details
+		///		Applies to every object with the same type and original type, for as long as neither type gets modified.
+		///		Only accesses that cannot fail for those types get resolved, so reading and writing through one skips every type check.
+		struct FieldAccess {
+			/// @brief How the field is stored.
+			enum class Kind: uint8 {
+				/// @brief Field is an object reference.
+				AV2_COFA_REFERENCE,
+				/// @brief Field is stored inline in a value structure.
+				AV2_COFA_STRUCTURE_VALUE,
+				/// @brief Field is an element stored inline in a value array.
+				AV2_COFA_ARRAY_VALUE,
+			};
+
+			Kind					kind	= Kind::AV2_COFA_REFERENCE;
+			/// @brief Type of the objects the access applies to.
+			AtomicCell<Definition>	type;
+			/// @brief Original type of the objects the access applies to.
+			AtomicCell<Definition>	origin;
+			/// @brief Field index. Only structure values are bound to a single field.
+			uint64					index	= 0;
+			/// @brief Field count, for references.
+			usize					limit	= 0;
+			/// @brief Field byte offset, for structure values.
+			usize					offset	= 0;
+			/// @brief Element stride, for array values.
+			usize					stride	= 0;
+			/// @brief Field byte size, for values.
+			usize					size	= 0;
+			/// @brief Type of the objects read from the field, for values.
+			AtomicCell<Definition>	fieldType;
+			/// @brief Original type of the objects read from the field, for values.
+			AtomicCell<Definition>	fieldOrigin;
+		};
+
+		/// @brief Resolves access to a field.
+		/// @param index Field index.
+		/// @return Resolved access, or an access without a type if accessing the field can fail.
+		FieldAccess accessField(uint64 const index) const;
+
+		/// @brief Returns whether a resolved field access applies to the object.
+		/// @param access Resolved access.
+		/// @param index Field index.
+		/// @return Whether access applies.
+		bool accepts(FieldAccess const& access, uint64 const index) const {
+			return (type ? type : origin) == access.type && origin == access.origin && (
+				access.kind != FieldAccess::Kind::AV2_COFA_STRUCTURE_VALUE
+			||	access.index == index
+			);
+		}
+
+		/// @brief Gets a field through a resolved access. Access must apply to the object.
+		/// @param access Resolved access.
+		/// @param index Field index.
+		/// @return Field, or `null` if it is out of the object's bounds.
+		Storage getAtIndex(FieldAccess const& access, uint64 const index) const;
+
+		/// @brief Sets a field through a resolved access. Access must apply to the object.
+		/// @param access Resolved access.
+		/// @param index Field index.
+		/// @param value Value to set.
+		/// @return Whether field was set, or `false` if it is out of the object's bounds.
+		bool setAtIndex(FieldAccess const& access, uint64 const index, Storage const& value);
+
 		Nullable<Storage> pop();
 		bool push(Storage const& value);
 
+		/// @brief Sets every element of a packed array to a value.
+		/// @param value Value to set.
+		/// @return Whether elements were set.
+		bool fill(Storage const& value);
+
+		/// @brief Copies every element of another packed array into a packed array, resizing it to match.
+		/// @param other Array to copy from. Must have the same element size.
+		/// @return Whether elements were copied.
+		bool copyFrom(Object const& other);
+
+		/// @brief Applies an arithmetic operator to every element of a packed array of numbers or vectors, in place.
+		/// @param op Operator to apply.
+		/// @param operand Right-hand operand. Either a single value, or a packed array whose elements get paired with the array's.
+		/// @return Whether operator was applied.
+		/// @note If the operand is an array, only as many elements as both arrays have get operated on.
+		bool map(Operator const op, Storage const& operand);
+
+		/// @brief Sums every element of a packed array of numbers or vectors.
+		/// @return Sum, or `null` if the array's elements cannot be summed.
+		Storage sum() const;
+
+		/// @brief Appends another string to a string, in place.
+		/// @param other String to append.
+		/// @return Whether it was appended, or `false` if the string's contents are shared with other objects.
+		bool append(Object const& other);
+
+		/// @brief Returns whether the object holds the very same contents as another (e.g. when both were made from the same interned string).
+		bool sharesContentsWith(Object const& other) const {return content && content == other.content;}
+
 		Storage clone()			const;
 		Storage shallowClone()	const;
 
@@ -518,6 +622,7 @@ namespace Makai::Anima::V2::Core {
 		): type(type), origin(origin) {}
 
 		pointer addressAt(usize index) const;
+		usize offsetOf(usize index) const;
 
 		template <class T>
 		T fromBasicNumber() const {
@@ -0,0 +1,182 @@
+#include "pool.hpp"
+
+using namespace Makai;
+using namespace Makai::Anima::V2::Core;
+
+struct alignas(16) Pool::Header {
+	ref<Pool>	owner;
+	uint32		sizeClass;
+	bool		object;
+
+	ref<Header>& next()	{return *ref<ref<Header>>(data());	}
+	pointer data()		{return this + 1;					}
+};
+
+
+
+struct alignas(16) Pool::Slab {
+	ref<Slab>	next;
+	usize		size;
+};
+
+static thread_local ref<Pool> current = nullptr;
+
+constexpr static usize sizeOfClass(usize const sizeClass) {
+	return Pool::MIN_BLOCK_SIZE << sizeClass;
+}
+
+constexpr static usize classOf(usize const size) {
+	usize sizeClass = 0;
+	while (sizeClass < Pool::CLASS_COUNT && sizeOfClass(sizeClass) < size)
+		++sizeClass;
+	return sizeClass;
+}
+
+Pool::Handle::Handle(): pool(new Pool()) {}
+
+Pool::Handle::~Handle() {
+	pool->retire();
+}
+
+Pool::Scope::Scope(Pool& pool): previous(current) {
+	current = &pool;
+}
+
+Pool::Scope::~Scope() {
+	current = previous;
+}
+
+ref<Pool> Pool::active() {
+	return current;
+}
+
+pointer Pool::acquire(usize const size, bool const object) {
+	if (current) return current->allocate(size, object);
+	auto const header = static_cast<ref<Header>>(MX::malloc(sizeof(Header) + size));
+	header->owner		= nullptr;
+	header->sizeClass	= CLASS_COUNT;
+	header->object		= object;
+	return header->data();
+}
+
+void Pool::release(pointer const block) {
+	if (!block) return;
+	auto const header = static_cast<ref<Header>>(block) - 1;
+	if (header->owner)
+		header->owner->reclaim(header);
+	else MX::free(header);
+}
+
+Pool::Pool() {}
+
+Pool::~Pool() {
+	freeSlabs();
+}
+
+pointer Pool::allocate(usize const size, bool const object) {
+	auto const sizeClass = classOf(size);
+	ref<Header> header = nullptr;
+	if (sizeClass == CLASS_COUNT)
+		header = static_cast<ref<Header>>(MX::malloc(sizeof(Header) + size));
+	auto const _ = ScopeLock<Mutex>(sync);
+	if (header)
+		++stats.heapBlocks;
+	else {
+		header = freeLists[sizeClass] ? freeLists[sizeClass] : grow(sizeClass);
+		freeLists[sizeClass] = header->next();
+		--stats.freeBlocks;
+	}
+	header->owner		= this;
+	header->sizeClass	= sizeClass;
+	header->object		= object;
+	++stats.liveBlocks;
+	if (object) ++stats.liveObjects;
+	return header->data();
+}
+
+Pool::Statistics Pool::statistics() const {
+	auto const _ = ScopeLock<Mutex>(sync);
+	return stats;
+}
+
+void Pool::trim() {
+	auto const _ = ScopeLock<Mutex>(sync);
+	if (stats.liveBlocks != stats.heapBlocks) return;
+	freeSlabs();
+	for (auto& list: freeLists)
+		list = nullptr;
+	stats.freeBlocks	= 0;
+	stats.slabs			= 0;
+	stats.slabBytes		= 0;
+}
+
+void Pool::reclaim(ref<Header> const header) {
+	bool dead = false;
+	{
+		auto const _ = ScopeLock<Mutex>(sync);
+		--stats.liveBlocks;
+		if (header->object) --stats.liveObjects;
+		if (header->sizeClass == CLASS_COUNT) {
+			--stats.heapBlocks;
+			MX::free(header);
+		} else {
+			header->next() = freeLists[header->sizeClass];
+			freeLists[header->sizeClass] = header;
+			++stats.freeBlocks;
+		}
+		dead = retired && !stats.liveBlocks;
+	}
+	if (dead) delete this;
+}
+
+void Pool::retire() {
+	bool dead = false;
+	{
+		auto const _ = ScopeLock<Mutex>(sync);
+		retired = true;
+		dead = !stats.liveBlocks;
+	}
+	if (dead) delete this;
+}
+
+void Pool::freeSlabs() {
+	while (slabs) {
+		auto const slab = slabs;
+		slabs = slab->next;
+		MX::free(slab);
+	}
+}
+
+ref<Pool::Header> Pool::grow(usize const sizeClass) {
+	auto const stride	= sizeof(Header) + sizeOfClass(sizeClass);
+	auto const size		= sizeof(Slab) + stride * SLAB_BLOCKS;
+	auto const slab		= static_cast<ref<Slab>>(MX::malloc(size));
+	slab->next	= slabs;
+	slab->size	= size;
+	slabs		= slab;
+	auto const blocks = ref<byte>(slab + 1);
+	for (usize i = SLAB_BLOCKS; i-- > 0;) {
+		auto const header = ref<Header>(blocks + i * stride);
+		header->next() = freeLists[sizeClass];
+		freeLists[sizeClass] = header;
+	}
+	stats.freeBlocks	+= SLAB_BLOCKS;
+	stats.slabBytes		+= size;
+	++stats.slabs;
+	return freeLists[sizeClass];
+}
+
+PooledMemory& PooledMemory::expand(usize const sz) {
+	if (sz <= capacity) {
+		length = sz;
+		return *this;
+	}
+	auto const reserved	= sz + (sz >> 1);
+	auto const grown	= static_cast<ref<byte>>(Pool::acquire(reserved));
+	if (length) MX::memcpy(grown, contents, length);
+	Pool::release(contents);
+	contents	= grown;
+	length		= sz;
+	capacity	= reserved;
+	return *this;
+}
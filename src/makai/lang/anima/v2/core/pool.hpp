@@ -0,0 +1,252 @@
+#ifndef MAKAILIB_ANIMA_V2_CORE_POOL_H
+#define MAKAILIB_ANIMA_V2_CORE_POOL_H
+
+#include "../../../../compat/ctl.hpp"
+
+namespace Makai::Anima::V2::Core {
+	/// @brief Size-classed pool allocator for ART objects and their contents.
+	/// @details
+	///		Blocks are carved out of slabs, and get recycled through a free list per size class.
+	///		Blocks too big for any size class are allocated from the heap, but still get counted.
+	///
+	///		Which pool gets used is decided by the pool currently active in the thread (see `Pool::Scope`).
+	///		Blocks remember which pool they came from, so they can be released from anywhere.
+	struct Pool {
+		/// @brief Pool usage statistics.
+		struct Statistics {
+			/// @brief Objects currently allocated from the pool.
+			usize liveObjects	= 0;
+			/// @brief Blocks currently allocated from the pool, objects included.
+			usize liveBlocks	= 0;
+			/// @brief Blocks currently in the pool's free lists.
+			usize freeBlocks	= 0;
+			/// @brief Blocks currently allocated from the heap, for being too big for the pool.
+			usize heapBlocks	= 0;
+			/// @brief Slabs allocated by the pool.
+			usize slabs			= 0;
+			/// @brief Bytes held by the pool's slabs.
+			usize slabBytes		= 0;
+
+			/// @brief Returns how much of the pool's slabs are in use.
+			/// @return Occupancy, between 0 and 1.
+			constexpr float64 occupancy() const {
+				auto const pooled = liveBlocks - heapBlocks;
+				if (!(pooled + freeBlocks)) return 0;
+				return static_cast<float64>(pooled) / (pooled + freeBlocks);
+			}
+		};
+
+		/// @brief Smallest block size.
+		constexpr static usize MIN_BLOCK_SIZE	= 16;
+		/// @brief Size class count. Each size class holds blocks twice as big as the previous one.
+		constexpr static usize CLASS_COUNT		= 6;
+		/// @brief Biggest block size.
+		constexpr static usize MAX_BLOCK_SIZE	= MIN_BLOCK_SIZE << (CLASS_COUNT - 1);
+		/// @brief Block count per slab.
+		constexpr static usize SLAB_BLOCKS		= 64;
+
+		/// @brief Owning handle to a pool.
+		/// @details
+		///		If blocks are still alive when the handle is destroyed, the pool is freed once the last one is released.
+		///
+		///		Pools are bound to their owner, so copying a handle creates a new pool, and assigning to one keeps its pool.
+		struct Handle {
+			Handle();
+			~Handle();
+
+			Handle(Handle const&): Handle()		{				}
+			Handle& operator=(Handle const&)	{return *this;	}
+
+			Pool& operator*() const			{return *pool;	}
+			ref<Pool> operator->() const	{return pool;	}
+
+		private:
+			ref<Pool> const pool;
+		};
+
+		/// @brief Makes a pool the active one in the current thread, for as long as the scope lasts.
+		struct Scope {
+			Scope(Pool& pool);
+			~Scope();
+
+			Scope(Scope const&)				= delete;
+			Scope& operator=(Scope const&)	= delete;
+
+		private:
+			ref<Pool> const previous;
+		};
+
+		/// @brief Returns the pool active in the current thread.
+		/// @return Active pool, or `nullptr` if none is.
+		static ref<Pool> active();
+
+		/// @brief Allocates a block from the active pool, or from the heap if there is none.
+		/// @param size Block size.
+		/// @param object Whether the block holds an object.
+		/// @return Allocated block.
+		static pointer acquire(usize const size, bool const object = false);
+
+		/// @brief Releases a block allocated through `acquire` or `allocate`.
+		/// @param block Block to release.
+		static void release(pointer const block);
+
+		/// @brief Allocates a block from the pool.
+		/// @param size Block size.
+		/// @param object Whether the block holds an object.
+		/// @return Allocated block.
+		pointer allocate(usize const size, bool const object = false);
+
+		/// @brief Returns the pool's usage statistics.
+		Statistics statistics() const;
+
+		/// @brief Frees every slab, if none of their blocks are in use.
+		void trim();
+
+	private:
+		struct Header;
+		struct Slab;
+
+		Pool();
+		~Pool();
+
+		void reclaim(ref<Header> const header);
+		void retire();
+		void freeSlabs();
+		ref<Header> grow(usize const sizeClass);
+
+		mutable Mutex	sync;
+		ref<Header>		freeLists[CLASS_COUNT]	= {};
+		ref<Slab>		slabs					= nullptr;
+		Statistics		stats;
+		bool			retired					= false;
+	};
+
+	/// @brief Allocator that allocates through the active `Pool`.
+	/// @tparam T Type to handle memory for.
+	template<Type::NonVoid T>
+	struct PoolAllocator {
+		using DataType = T;
+
+		/// @brief Allocates space for elements.
+		/// @param sz Element count to allocate for.
+		/// @return Pointer to allocated memory, or `nullptr` if size is zero.
+		[[nodiscard]]
+		owner<T> allocate(usize const sz) {
+			if (!sz) return nullptr;
+			return static_cast<owner<T>>(Pool::acquire(sz * sizeof(T)));
+		}
+
+		/// @brief Allocates space for a single element.
+		/// @return Pointer to allocated memory.
+		[[nodiscard]]
+		owner<T> allocate() {
+			return allocate(1);
+		}
+
+		/// @brief Deallocates allocated memory.
+		/// @param mem Pointer to allocated memory.
+		void deallocate(owner<T> const mem, usize const = 0) {
+			Pool::release(mem);
+		}
+	};
+
+	/// @brief Memory slice allocated through the active `Pool`.
+	/// @details
+	///		Behaves like a `MemorySlice`, except it can also grow and shrink while keeping its contents.
+	///		Growing reserves spare room, so growing it repeatedly (e.g. appending to a string) takes amortized constant time.
+	struct PooledMemory {
+		PooledMemory() noexcept {}
+
+		/// @brief Constructs the memory slice with space for a number of bytes.
+		/// @param sz Byte count to allocate for.
+		PooledMemory(usize const sz) {invoke(sz);}
+
+		PooledMemory(PooledMemory const&)				= delete;
+		PooledMemory& operator=(PooledMemory const&)	= delete;
+
+		PooledMemory(PooledMemory&& other):
+			contents(other.contents),
+			length(other.length),
+			capacity(other.capacity) {
+			other.contents	= nullptr;
+			other.length	= 0;
+			other.capacity	= 0;
+		}
+
+		PooledMemory& operator=(PooledMemory&& other) {
+			if (&other == this) return *this;
+			free();
+			contents		= other.contents;
+			length			= other.length;
+			capacity		= other.capacity;
+			other.contents	= nullptr;
+			other.length	= 0;
+			other.capacity	= 0;
+			return *this;
+		}
+
+		~PooledMemory() {free();}
+
+		bool			empty() const		{return !length;	}
+		usize			size() const		{return length;		}
+		usize			byteSize() const	{return length;		}
+		ref<byte>		data()				{return contents;	}
+		ref<byte const>	data() const		{return contents;	}
+
+		/// @note Index wraps around if it is bigger than the current size.
+		byte& operator[](usize const index)				{return contents[index % length];	}
+		/// @note Index wraps around if it is bigger than the current size.
+		byte const& operator[](usize const index) const	{return contents[index % length];	}
+
+		/// @brief Allocates (or resizes) the memory slice. Does nothing if size is zero.
+		/// @param sz Byte count.
+		/// @return Reference to self.
+		PooledMemory& invoke(usize const sz) {
+			if (!sz) return *this;
+			return resize(sz);
+		}
+
+		/// @brief Allocates the memory slice, if not already allocated.
+		/// @param sz Byte count.
+		/// @return Reference to self.
+		PooledMemory& create(usize const sz) {
+			if (!sz || contents) return *this;
+			contents	= static_cast<ref<byte>>(Pool::acquire(sz));
+			length		= sz;
+			capacity	= sz;
+			return *this;
+		}
+
+		/// @brief Reallocates the memory slice. Contents are NOT kept.
+		/// @param sz Byte count.
+		/// @return Reference to self.
+		PooledMemory& resize(usize const sz) {
+			if (!sz) return free();
+			if (contents) free();
+			return create(sz);
+		}
+
+		/// @brief Grows (or shrinks) the memory slice, keeping its contents.
+		/// @param sz Byte count.
+		/// @return Reference to self.
+		PooledMemory& expand(usize const sz);
+
+		/// @brief Frees the memory slice.
+		/// @return Reference to self.
+		PooledMemory& free() {
+			if (!contents) return *this;
+			Pool::release(contents);
+			contents	= nullptr;
+			length		= 0;
+			capacity	= 0;
+			return *this;
+		}
+
+	private:
+		ref<byte>	contents	= nullptr;
+		usize		length		= 0;
+		usize		capacity	= 0;
+	};
+}
+
+#endif
@@ -201,3 +201,10 @@ void Definition::makeBasic(Definition& type) {
 	type.copy		= clonerOf(type.basic);
 	type.compare	= comparatorOf(type.basic);
 }
+
+void Definition::makePacked(Definition& type) {
+	if (!type.base) return;
+	type.byteSize	= type.base->byteSize;
+	type.alignment	= type.base->alignment;
+	type.copy		= proxyClone<byte>();
+}
@@ -3,6 +3,7 @@
 
 #include "forward.hpp"
 #include "entry.hpp"
+#include "pool.hpp"
 
 namespace Makai::Anima::V2::Core {
 	/// @brief Operator.
@@ -28,6 +29,7 @@ namespace Makai::Anima::V2::Core {
 		AV2_UOP_SQRT,
 		AV2_UOP_LENGTH,
 		AV2_UOP_POP,
+		AV2_UOP_SUM,
 		AV2_BOP_START = 1 << 6,
 		AV2_BOP_ADD = AV2_BOP_START,
 		AV2_BOP_SUB,
@@ -44,6 +46,8 @@ namespace Makai::Anima::V2::Core {
 		AV2_BOP_ATAN2,
 		AV2_BOP_POW,
 		AV2_BOP_PUSH,
+		AV2_BOP_FILL,
+		AV2_BOP_COPY,
 		AV2_TOP_START = 2 << 6,
 		AV2_QOP_START = 3 << 6,
 	};
@@ -178,7 +182,7 @@ namespace Makai::Anima::V2::Core {
 	static_assert(sizeof(TypeFlags) == sizeof(uint64), "Uh oh :/");
 
 	struct Definition: Entry, Flagged<TypeFlags> {
-		using Source = MemorySlice<byte>;
+		using Source = PooledMemory;
 
 		bool canBecome(AtomicCell<Definition> const& type) const {
 			if (type == base) return true;
@@ -191,6 +195,9 @@ namespace Makai::Anima::V2::Core {
 
 		static void makeBasic(Definition& type);
 
+		/// @brief Lays out a value array type, whose elements get packed one after the other. Element type must be set up beforehand.
+		static void makePacked(Definition& type);
+
 		Nullable<BasicType>				basic;
 		AtomicCell<Definition>			base		= nullptr;
 		uint64							byteSize	= 0;
@@ -0,0 +1,271 @@
+#ifndef MAKAILIB_ANIMA_V2_CORE_VALUE_H
+#define MAKAILIB_ANIMA_V2_CORE_VALUE_H
+
+#include "object.hpp"
+
+namespace Makai::Anima::V2::Core {
+	/// @brief Returns the basic type a type gets held unboxed as.
+	/// @tparam T Type to get basic type for.
+	/// @return Basic type, or `AV2_BT_NOT_A_BASIC_TYPE` if it cannot be held unboxed.
+	template <class T>
+	constexpr BasicType unboxedTypeOf() {
+		if constexpr (Type::Equal<T, bool>)				return BasicType::AV2_BT_BOOL;
+		else if constexpr (Type::Equal<T, int8>)		return BasicType::AV2_BT_INT8;
+		else if constexpr (Type::Equal<T, uint8>)		return BasicType::AV2_BT_UINT8;
+		else if constexpr (Type::Equal<T, int16>)		return BasicType::AV2_BT_INT16;
+		else if constexpr (Type::Equal<T, uint16>)		return BasicType::AV2_BT_UINT16;
+		else if constexpr (Type::Equal<T, int32>)		return BasicType::AV2_BT_INT32;
+		else if constexpr (Type::Equal<T, uint32>)		return BasicType::AV2_BT_UINT32;
+		else if constexpr (Type::Equal<T, int64>)		return BasicType::AV2_BT_INT64;
+		else if constexpr (Type::Equal<T, uint64>)		return BasicType::AV2_BT_UINT64;
+		else if constexpr (Type::Equal<T, float32>)		return BasicType::AV2_BT_REAL32;
+		else if constexpr (Type::Equal<T, float64>)		return BasicType::AV2_BT_REAL64;
+		else if constexpr (Type::Equal<T, Vector4>)		return BasicType::AV2_BT_VECTOR;
+		else return BasicType::AV2_BT_NOT_A_BASIC_TYPE;
+	}
+
+	/// @brief Type that can be held unboxed.
+	template <class T>
+	concept Unboxable = unboxedTypeOf<T>() != BasicType::AV2_BT_NOT_A_BASIC_TYPE;
+
+	/// @brief Runtime value.
+	/// @details
+	///		Null, booleans, integers, reals and vectors are held unboxed, alongside the definition
+	///		an object created for them would have. Everything else is held as an object.
+	///
+	///		Unboxed values only get boxed when something needs the object (field access, native
+	///		calls, references). Boxing happens in place, so copies taken afterwards share the object.
+	struct Value {
+		/// @brief Returns whether values of a given basic type can be held unboxed.
+		/// @param type Basic type to check.
+		/// @return Whether it can be held unboxed.
+		constexpr static bool canHold(BasicType const type) {
+			switch (type) {
+				using enum BasicType;
+				case AV2_BT_BOOL:
+				case AV2_BT_INT8:
+				case AV2_BT_UINT8:
+				case AV2_BT_INT16:
+				case AV2_BT_UINT16:
+				case AV2_BT_INT32:
+				case AV2_BT_UINT32:
+				case AV2_BT_INT64:
+				case AV2_BT_UINT64:
+				case AV2_BT_REAL32:
+				case AV2_BT_REAL64:
+				case AV2_BT_VECTOR:	return true;
+				default:			return false;
+			}
+		}
+
+		/// @brief Empty constructor.
+		Value() {}
+
+		/// @brief Constructs an empty value.
+		Value(decltype(nullptr)) {}
+
+		/// @brief Constructs a boxed value.
+		/// @param object Object to hold.
+		Value(ObjectStorage const& object): boxed(object) {}
+
+		/// @brief Constructs an unboxed value.
+		/// @tparam T Value type.
+		/// @param value Value to hold.
+		/// @param definition Definition the value has. Must outlive the value.
+		template <Unboxable T>
+		Value(T const& value, AtomicCell<Definition> const& definition):
+			definition(&definition),
+			kind(unboxedTypeOf<T>()) {
+			MX::construct(ref<T>(payload), value);
+		}
+
+		/// @brief Constructs an unboxed copy of the contents of a basic object.
+		/// @param data Object contents.
+		/// @param definition Definition the value has. Must outlive the value.
+		/// @param type Basic type of the definition. Must be one that can be held unboxed.
+		Value(ref<void const> const data, AtomicCell<Definition> const& definition, BasicType const type):
+			definition(&definition),
+			kind(type) {
+			MX::memcpy(payload, data, sizeOf(type));
+		}
+
+		/// @brief Returns whether the value is held unboxed.
+		bool unboxed() const			{return definition;							}
+		/// @brief Returns whether the value exists.
+		bool exists() const				{return definition || boxed.exists();		}
+		/// @brief Returns whether the value exists.
+		explicit operator bool() const	{return exists();							}
+
+		/// @brief Returns the basic type of the value, if unboxed.
+		BasicType basic() const			{return kind;								}
+
+		/// @brief Returns a pointer to the value's contents.
+		pointer data()					{return unboxed() ? payload : boxed->data();	}
+		/// @brief Returns a pointer to the value's contents.
+		ref<void const> data() const	{return unboxed() ? payload : boxed->data();	}
+
+		/// @brief Returns the unboxed value as a given type.
+		template <Unboxable T>
+		T& as()				{return *ref<T>(payload);		}
+		/// @brief Returns the unboxed value as a given type.
+		template <Unboxable T>
+		T const& as() const	{return *ref<T const>(payload);	}
+
+		/// @brief Boxes the value in place, if not already boxed.
+		/// @return Reference to the held object.
+		ObjectStorage& box() const {
+			if (unboxed()) {
+				boxed		= makeObject();
+				definition	= nullptr;
+				kind		= BasicType::AV2_BT_NOT_A_BASIC_TYPE;
+			}
+			return boxed;
+		}
+
+		/// @brief Returns the value as an object, boxing it if necessary.
+		operator ObjectStorage() const		{return box();					}
+		/// @brief Returns the value as an object, boxing it if necessary.
+		ref<Object> operator->() const		{return box().operator->();		}
+		/// @brief Returns the value as an object, boxing it if necessary.
+		Object& operator*() const			{return *box();					}
+
+		/// @brief Synchronization barrier. Only locks for boxed values, as unboxed ones are never shared.
+		struct Barrier {
+			Barrier(bool const lock): locked(lock) {
+				if (locked) ::new (storage) ScopeLock<Mutex>(ObjectStorage::sync());
+			}
+
+			~Barrier() {
+				if (locked) ref<ScopeLock<Mutex>>(storage)->~ScopeLock();
+			}
+
+			Barrier(Barrier const&)				= delete;
+			Barrier& operator=(Barrier const&)	= delete;
+
+		private:
+			bool									locked;
+			alignas(ScopeLock<Mutex>) byte			storage[sizeof(ScopeLock<Mutex>)];
+		};
+
+		/// @brief Creates a synchronization barrier.
+		Barrier sync() const				{return Barrier(!unboxed());	}
+
+		/// @brief Atomically performs an operation on the value as an object.
+		template <class TFunction>
+		Value& perform(TFunction const& op) {
+			box().perform(op);
+			return *this;
+		}
+
+		/// @brief Returns the value's type.
+		AtomicCell<Definition> getType() const {
+			return unboxed() ? *definition : boxed->getType();
+		}
+
+		/// @brief Returns whether two values have the same type.
+		bool hasSameTypeAs(Value const& other) const {
+			if (unboxed() && other.unboxed())
+				return definition == other.definition;
+			return getType() == other.getType();
+		}
+
+		/// @brief Writes another value into this one.
+		/// @details If boxed, the value gets written into the held object, so every copy sees it.
+		/// @param other Value to write.
+		/// @return Reference to self.
+		Value& store(Value const& other) {
+			if (unboxed() || !boxed)
+				return *this = other;
+			*boxed = *other.box();
+			return *this;
+		}
+
+		bool isBoolean() const		{return unboxed() ? kind == BasicType::AV2_BT_BOOL : boxed->isBoolean();		}
+		bool isSigned() const		{return unboxed() ? Core::isSigned(kind) : boxed->isSigned();					}
+		bool isUnsigned() const		{return unboxed() ? (isBoolean() || Core::isUnsigned(kind)) : boxed->isUnsigned();	}
+		bool isInteger() const		{return isSigned() || isUnsigned();												}
+		bool isReal() const			{return unboxed() ? Core::isReal(kind) : boxed->isReal();						}
+		bool isNumber() const		{return isInteger() || isReal();												}
+		bool isVector() const		{return unboxed() ? kind == BasicType::AV2_BT_VECTOR : boxed->isVector();		}
+		bool isVectorable() const	{return isNumber() || isVector();												}
+
+		/// @brief Returns the value converted to a given type.
+		/// @tparam T Type to convert to.
+		/// @return Converted value.
+		template <class T>
+		T toValue() const {
+			if (!unboxed())
+				return boxed->toValue<T>();
+			if constexpr (Type::Equal<T, bool> || Type::Number<T>) {
+				switch (kind) {
+					using enum BasicType;
+					case AV2_BT_BOOL:	return as<bool>();
+					case AV2_BT_INT8:	return as<int8>();
+					case AV2_BT_UINT8:	return as<uint8>();
+					case AV2_BT_INT16:	return as<int16>();
+					case AV2_BT_UINT16:	return as<uint16>();
+					case AV2_BT_INT32:	return as<int32>();
+					case AV2_BT_UINT32:	return as<uint32>();
+					case AV2_BT_INT64:	return as<int64>();
+					case AV2_BT_UINT64:	return as<uint64>();
+					case AV2_BT_REAL32:	return as<float32>();
+					case AV2_BT_REAL64:	return as<float64>();
+					default: break;
+				}
+			} else if constexpr (Type::OneOf<T, Vector2, Vector3, Vector4>) {
+				if (kind == BasicType::AV2_BT_VECTOR)
+					return as<Vector4>();
+				if (isNumber())
+					return toValue<float>();
+			}
+			return box()->toValue<T>();
+		}
+
+	private:
+		/// @brief Returns the byte size of a type that can be held unboxed.
+		constexpr static usize sizeOf(BasicType const type) {
+			switch (type) {
+				using enum BasicType;
+				case AV2_BT_BOOL:	return sizeof(bool);
+				case AV2_BT_INT8:
+				case AV2_BT_UINT8:	return sizeof(uint8);
+				case AV2_BT_INT16:
+				case AV2_BT_UINT16:	return sizeof(uint16);
+				case AV2_BT_INT32:
+				case AV2_BT_UINT32:	return sizeof(uint32);
+				case AV2_BT_INT64:
+				case AV2_BT_UINT64:	return sizeof(uint64);
+				case AV2_BT_REAL32:	return sizeof(float32);
+				case AV2_BT_REAL64:	return sizeof(float64);
+				case AV2_BT_VECTOR:	return sizeof(Vector4);
+				default:			return 0;
+			}
+		}
+
+		ObjectStorage makeObject() const {
+			switch (kind) {
+				using enum BasicType;
+				case AV2_BT_BOOL:	return Object::create(as<bool>(), *definition);
+				case AV2_BT_INT8:	return Object::create(as<int8>(), *definition);
+				case AV2_BT_UINT8:	return Object::create(as<uint8>(), *definition);
+				case AV2_BT_INT16:	return Object::create(as<int16>(), *definition);
+				case AV2_BT_UINT16:	return Object::create(as<uint16>(), *definition);
+				case AV2_BT_INT32:	return Object::create(as<int32>(), *definition);
+				case AV2_BT_UINT32:	return Object::create(as<uint32>(), *definition);
+				case AV2_BT_INT64:	return Object::create(as<int64>(), *definition);
+				case AV2_BT_UINT64:	return Object::create(as<uint64>(), *definition);
+				case AV2_BT_REAL32:	return Object::create(as<float32>(), *definition);
+				case AV2_BT_REAL64:	return Object::create(as<float64>(), *definition);
+				case AV2_BT_VECTOR:	return Object::create(as<Vector4>(), *definition);
+				default:			return nullptr;
+			}
+		}
+
+		mutable ObjectStorage						boxed;
+		mutable ref<AtomicCell<Definition> const>	definition	= nullptr;
+		mutable BasicType							kind		= BasicType::AV2_BT_NOT_A_BASIC_TYPE;
+		alignas(Vector4) byte						payload[sizeof(Vector4)];
+	};
+}
+
+#endif
@@ -0,0 +1,106 @@
+#include "view.hpp"
+#include <atomic>
+
+using namespace Makai;
+using namespace Makai::Anima::V2::Core;
+
+/// Maximum amount of lifetimes alive at once.
+constexpr static usize MAX_LIFETIMES = 4096;
+
+/// Current generation of each lifetime slot. Views are valid for as long as their slot is still at the generation they got borrowed at.
+/// @note Atomic, as views get validated from any thread, without taking `lifetimeSync`.
+static std::atomic<uint32>	generations[MAX_LIFETIMES]	= {};
+static List<uint32>			freeSlots;
+static uint32				usedSlots					= 0;
+static Mutex				lifetimeSync;
+
+static uint32 acquireSlot() {
+	uint32 slot = MAX_LIFETIMES;
+	lifetimeSync.capture();
+	if (freeSlots.size())
+		slot = freeSlots.popBack();
+	else if (usedSlots < MAX_LIFETIMES)
+		slot = usedSlots++;
+	lifetimeSync.release();
+	if (slot == MAX_LIFETIMES)
+		throw Error::FailedAction("Too many view lifetimes alive at once!", CTL_CPP_PRETTY_SOURCE);
+	// Slots start past the default view's generation, so it is never valid for a live lifetime
+	generations[slot].fetch_add(1, std::memory_order_release);
+	return slot;
+}
+
+static void releaseSlot(uint32 const slot) {
+	generations[slot].fetch_add(1, std::memory_order_release);
+	lifetimeSync.capture();
+	freeSlots.pushBack(slot);
+	lifetimeSync.release();
+}
+
+static void viewCloneImpl(Definition::Source& a, Definition::Source const& b) {
+	if (b.size())
+		MX::memmove(a.resize(b.size()).data(), b.data(), b.size());
+	else a.free();
+}
+
+bool HostView::valid() const {
+	return data && generations[slot].load(std::memory_order_acquire) == generation;
+}
+
+usize HostView::stride() const {
+	switch (element) {
+		using enum BasicType;
+		case AV2_BT_BOOL:	return sizeof(bool);
+		case AV2_BT_INT8:
+		case AV2_BT_UINT8:	return sizeof(uint8);
+		case AV2_BT_INT16:
+		case AV2_BT_UINT16:	return sizeof(uint16);
+		case AV2_BT_INT32:
+		case AV2_BT_UINT32:	return sizeof(uint32);
+		case AV2_BT_INT64:
+		case AV2_BT_UINT64:	return sizeof(uint64);
+		case AV2_BT_REAL32:	return sizeof(float32);
+		case AV2_BT_REAL64:	return sizeof(float64);
+		case AV2_BT_VECTOR:	return sizeof(Vector4);
+		case AV2_BT_MATRIX:	return sizeof(Matrix4x4);
+		default:			return 0;
+	}
+}
+
+pointer HostView::at(usize const index) const {
+	if (index >= count || !valid()) return nullptr;
+	return static_cast<ref<byte>>(data) + index * stride();
+}
+
+HostView HostView::construct(Object const& object) {
+	if (!object.exists()) return HostView();
+	auto const type = object.getType();
+	if (!(type && type->hash == ART_HASH)) return HostView();
+	HostView view;
+	MX::memcpy(&view, object.data(), sizeof(HostView));
+	return view;
+}
+
+void HostView::makeDefinition(Definition& type) {
+	type.name				= ART_NAME;
+	type.hash				= ART_HASH;
+	type.byteSize			= sizeof(HostView);
+	type.alignment			= alignof(HostView);
+	type.flags.isValueType	= true;
+	type.flags.isCopyable	= true;
+	type.flags.isFinal		= true;
+	type.copy				= Definition::Cloner(viewCloneImpl);
+}
+
+HostView::Lifetime::Lifetime(): slot(acquireSlot()) {}
+
+HostView::Lifetime::~Lifetime() {
+	releaseSlot(slot);
+}
+
+void HostView::Lifetime::end() {
+	generations[slot].fetch_add(1, std::memory_order_release);
+}
+
+uint32 HostView::Lifetime::generation() const {
+	return generations[slot].load(std::memory_order_acquire);
+}
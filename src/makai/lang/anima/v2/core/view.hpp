@@ -0,0 +1,137 @@
+#ifndef MAKAILIB_ANIMA_V2_CORE_VIEW_H
+#define MAKAILIB_ANIMA_V2_CORE_VIEW_H
+
+#include "value.hpp"
+
+namespace Makai::Anima::V2::Core {
+	/// @brief Returns the element type views over a given type hold.
+	/// @tparam T Type to get element type for.
+	/// @return Element type, or `AV2_BT_NOT_A_BASIC_TYPE` if views cannot hold it.
+	template <class T>
+	constexpr BasicType viewTypeOf() {
+		if constexpr (Type::Equal<T, Matrix4x4>)	return BasicType::AV2_BT_MATRIX;
+		else return unboxedTypeOf<T>();
+	}
+
+	/// @brief Type views can hold.
+	template <class T>
+	concept Viewable = viewTypeOf<T>() != BasicType::AV2_BT_NOT_A_BASIC_TYPE;
+
+	/// @brief View over memory owned by the host.
+	/// @details
+	///		Lets native calls pass host data (vectors, matrices, buffers) to and from scripts without copying it.
+	///		Only the view itself gets held in an object. Elements get read from, and written to, the host's memory directly.
+	///
+	///		Views are borrowed from a `HostView::Lifetime`, and only stay usable for as long as it lasts.
+	///		Past that, they hold no elements, rather than pointing into memory the host might have freed.
+	struct HostView {
+		constexpr static auto const ART_NAME	= "view";
+		constexpr static auto const ART_HASH	= ConstHasher::hash("view");
+
+		/// @brief Lifetime views get borrowed for.
+		struct Lifetime;
+
+		/// @brief Empty constructor.
+		HostView() {}
+
+		/// @brief Returns whether the view's lifetime has not ended yet.
+		bool valid() const;
+
+		/// @brief Returns the element count, or zero if the view's lifetime has ended.
+		usize size() const					{return valid() ? count : 0;	}
+		/// @brief Returns the element type.
+		BasicType elementType() const		{return element;				}
+		/// @brief Returns the byte size of a single element.
+		usize stride() const;
+
+		/// @brief Returns the address of an element.
+		/// @param index Element index.
+		/// @return Address, or `nullptr` if it is out of bounds, or the view's lifetime has ended.
+		pointer at(usize const index) const;
+
+		/// @brief Returns the elements, as a given type.
+		/// @tparam T Element type.
+		/// @return Elements, or an empty span if the view does not hold elements of that type, or its lifetime has ended.
+		template <Viewable T>
+		Span<T> as() const {
+			if (element != viewTypeOf<T>() || !valid()) return Span<T>();
+			return Span<T>(static_cast<ref<T>>(data), count);
+		}
+
+		/// @brief Returns the view an object holds.
+		/// @param object Object to get view from.
+		/// @return View, or an empty one if the object does not hold a view.
+		static HostView construct(Object const& object);
+
+		/// @brief Lays out a definition for the view type.
+		/// @param type Definition to lay out.
+		static void makeDefinition(Definition& type);
+
+	private:
+		HostView(pointer const data, usize const count, BasicType const element, uint32 const slot, uint32 const generation):
+			data(data),
+			count(count),
+			element(element),
+			slot(slot),
+			generation(generation) {}
+
+		pointer		data		= nullptr;
+		usize		count		= 0;
+		BasicType	element		= BasicType::AV2_BT_NOT_A_BASIC_TYPE;
+		uint32		slot		= 0;
+		uint32		generation	= 0;
+	};
+
+	/// @details
+	///		Ending a lifetime invalidates every view borrowed from it so far. It can then be borrowed from again (e.g. once per frame).
+	///		Lifetimes end on their own when destroyed.
+	///
+	///		Views are meant to be used from the same thread their lifetime ends in.
+	///		Validating a view from another thread is safe, but nothing keeps the lifetime from ending right after the check,
+	///		so the host must not end it while other threads still read through its views.
+	struct HostView::Lifetime {
+		Lifetime();
+		~Lifetime();
+
+		Lifetime(Lifetime const&)				= delete;
+		Lifetime& operator=(Lifetime const&)	= delete;
+
+		/// @brief Borrows a view over host memory.
+		/// @tparam T Element type.
+		/// @param data Elements.
+		/// @param count Element count.
+		/// @return View.
+		template <Viewable T>
+		HostView borrow(ref<T> const data, usize const count) const {
+			return HostView(data, count, viewTypeOf<T>(), slot, generation());
+		}
+
+		/// @brief Borrows a view over a single host value.
+		/// @tparam T Value type.
+		/// @param value Value.
+		/// @return View.
+		template <Viewable T>
+		HostView borrow(T& value) const {
+			return borrow(&value, 1);
+		}
+
+		/// @brief Borrows a view over host elements.
+		/// @tparam T Element type.
+		/// @param elements Elements.
+		/// @return View.
+		template <Viewable T>
+		HostView borrow(Span<T> const& elements) const {
+			return borrow(elements.data(), elements.size());
+		}
+
+		/// @brief Invalidates every view borrowed so far.
+		void end();
+
+	private:
+		uint32 generation() const;
+
+		uint32 const slot;
+	};
+}
+
+#endif
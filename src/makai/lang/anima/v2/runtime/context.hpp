@@ -6,7 +6,7 @@
 
 namespace Makai::Anima::V2::Runtime {
 	struct Context {
-		using Storage = Core::Object::Storage;
+		using Storage = Core::Value;
 
 		struct Pointers {
 			usize	offset		= 0;
@@ -14,26 +14,18 @@ namespace Makai::Anima::V2::Runtime {
 			usize	instruction	= -1;
 		};
 
+		/// @brief Scope. Its locals live in the frame stack, from its base up to where the next scope's begin.
 		struct Scope {
-			List<Storage>		localStack;
+			/// @brief Where the scope's locals start in the frame stack.
+			usize				base			= 0;
 			Core::ContextMode	mode			= Core::ContextMode::AV2_CM_STRICT;
 			Core::ContextMode	prevMode		= Core::ContextMode::AV2_CM_STRICT;
 			usize				pointerFrame	= -1;
-
-			Scope& push(Storage const& value) {
-				localStack.pushBack(value);
-				return *this;
-			}
-
-			Storage pop() {
-				return localStack.popBack();
-			}
-
-			Storage& top() {
-				return localStack.back();
-			}
 		};
 
+		/// @brief View over a scope's locals. Invalidated whenever locals get added.
+		using Locals = Span<Storage>;
+
 		using VariableBank = Map<uint64, Data::Value>;
 
 		Context& push(Storage const& value) {
@@ -41,7 +33,7 @@ namespace Makai::Anima::V2::Runtime {
 			return *this;
 		}
 
-		template <Type::Different<Storage> T>
+		template <Type::NoneOf<Storage, Core::Object::Storage> T>
 		Context& push(T const& value) {
 			globalValueStack.pushBack(newValue(value));
 			return *this;
@@ -61,20 +53,76 @@ namespace Makai::Anima::V2::Runtime {
 		}
 
 		Storage& localTop() {
-			return scope().top();
+			return frameStack[frameTop - 1];
 		}
 
 		Scope& scope() {
-			return *scopeStack.back();
+			return scopeStack.back();
+		}
+
+		/// @brief Returns the current scope's locals.
+		Locals locals() {
+			return Locals(frameStack.data() + scope().base, frameTop - scope().base);
+		}
+
+		/// @brief Returns the locals of the scope at a given depth.
+		Locals localsOf(usize const index) {
+			auto const start	= scopeStack[index].base;
+			auto const stop		= (index + 1 < scopeStack.size()) ? scopeStack[index + 1].base : frameTop;
+			return Locals(frameStack.data() + start, stop - start);
+		}
+
+		/// @brief Enters a new scope, with no locals.
+		Scope& enterScope() {
+			return enterScope(Scope());
+		}
+
+		/// @brief Enters a new scope, with no locals.
+		Scope& enterScope(Scope scope) {
+			scope.base = frameTop;
+			scopeStack.pushBack(scope);
+			return scopeStack.back();
+		}
+
+		/// @brief Exits the current scope, releasing its locals.
+		Context& exitScope() {
+			resizeLocals(0);
+			scopeStack.popBack();
+			return *this;
 		}
 
-		List<Storage>& locals() {
-			return scope().localStack;
+		/// @brief Adds a local to the current scope.
+		/// @note `value` must not be a reference to another local, as adding one can move them around.
+		Context& addLocal(Storage const& value) {
+			if (frameTop < frameStack.size())
+				frameStack[frameTop] = value;
+			else frameStack.pushBack(value);
+			++frameTop;
+			return *this;
+		}
+
+		/// @brief Adds empty locals to the current scope.
+		Context& addLocals(usize const count) {
+			auto const size = frameTop + count;
+			while (frameStack.size() < size)
+				frameStack.pushBack(nullptr);
+			frameTop = size;
+			return *this;
+		}
+
+		/// @brief Sets the current scope's local count, releasing any locals past it.
+		Context& resizeLocals(usize const count) {
+			auto const size = scope().base + count;
+			if (size > frameTop) return addLocals(size - frameTop);
+			// Slots past the top are kept around empty, for the next scopes to reuse
+			while (frameTop > size)
+				frameStack[--frameTop] = nullptr;
+			return *this;
 		}
 
 		template <class T>
 		Storage newValue(T const& value) {
-			return art.newValue(value);
+			return art.newUnboxed(value);
 		}
 
 		template <class T>
@@ -85,8 +133,15 @@ namespace Makai::Anima::V2::Runtime {
 		Pointers				pointers;
 		List<Storage>			globalValueStack;
 		List<Pointers>			pointerStack;
-		List<AtomicCell<Scope>>	scopeStack;
-		Map<usize, Storage>		globals;
+		List<Scope>				scopeStack;
+		/// @brief Locals of every scope, back to back.
+		List<Storage>			frameStack;
+		/// @brief Where the current scope's locals end in the frame stack.
+		usize					frameTop	= 0;
+		/// @brief Globals, indexed by ID.
+		List<Storage>			globals;
+		/// @brief Globals whose ID falls outside of `globals`.
+		Map<usize, Storage>		sparseGlobals;
 		Core::Context			art;
 	};
 }
@@ -1,5 +1,6 @@
 #include "engine.hpp"
 #include "context.hpp"
+#include "precompiled.hpp"
 
 using Makai::Anima::V2::Runtime::Engine;
 
@@ -9,7 +10,7 @@ namespace Runtime	= Makai::Anima::V2::Runtime;
 
 using namespace Core;
 
-static void printValueState(Object::Storage const& value) {
+static void printValueState(Runtime::Context::Storage const& value) {
 	MAKAILIB_DEBUG_BLOCK_FULL {
 		MAKAILIB_DEBUG_FULL("> Value? ", value ? "YES" : "NO");
 		if (value) {
@@ -72,8 +73,8 @@ bool Engine::DefaultLibraryLoader::loadLibrary(Context& context, String const& p
 bool Engine::yieldCycle() {
 	bool revertContext = false;
 	if (context.scopeStack.empty())
-		context.scopeStack.pushBack(AtomicCell<Context::Scope>::create());
-	if (context.scopeStack.back()->prevMode != context.scopeStack.back()->mode)
+		context.enterScope();
+	if (context.scope().prevMode != context.scope().mode)
 		revertContext = true;
 	if (!running()) return false;
 	do {
@@ -82,6 +83,7 @@ bool Engine::yieldCycle() {
 	} while (running() && current.name == Instruction::Name::AV2_IN_NO_OP && current.type);
 	if (!running()) return false;
 	MAKAILIB_DEBUGLN_FULL("Instruction: ", Instruction::asString(current.name));
+	if (profiler) profiler->step(current.name);
 	switch (current.name) {
 		using enum Instruction::Name;
 		case AV2_IN_HALT:			v2Halt();			break;
@@ -120,17 +122,238 @@ bool Engine::yieldCycle() {
 		case AV2_IN_NO_OP: break;
 //		default: crash(invalidInstructionError());
 	}
-	if (revertContext) context.scopeStack.back()->mode = context.scopeStack.back()->prevMode;
+	if (revertContext) context.scope().mode = context.scope().prevMode;
 	return running();
 }
 
+void Engine::decode() {
+	auto const size = program->code.size();
+	jit.unbind();
+	profiler.unbind();
+	precompiled = nullptr;
+	decoded.clear();
+	fieldCaches.clear();
+	callCaches.clear();
+	nativeCaches.clear();
+	cacheStats = {};
+	if (!size) return;
+	decoded.resize(size + 1, {});
+	// Fetching past the end of the program terminates it
+	decoded[size] = {&Engine::terminate, {}, size};
+	for (usize i = size; i-- > 0;) {
+		auto& op = decoded[i];
+		op.instruction	= program->code[i];
+		op.handler		= handlerFor(op.instruction.name);
+		// "Free" no-ops get skipped over during fetch
+		if (op.instruction.name == Instruction::Name::AV2_IN_NO_OP && op.instruction.type)
+			op.next = decoded[i+1].next;
+		else op.next = i;
+		bool hasStaticTarget = false;
+		JumpMode mode = JumpMode::AV2_JM_TABLE_INDEX;
+		if (op.instruction.name == Instruction::Name::AV2_IN_JUMP) {
+			auto const leap = op.instruction.getTypeAs<Instruction::Leap>();
+			hasStaticTarget	= !leap.dyn;
+			mode			= leap.mode;
+		} else if (op.instruction.name == Instruction::Name::AV2_IN_CALL) {
+			auto const invocation = op.instruction.getTypeAs<Instruction::Invocation>();
+			hasStaticTarget = !(invocation.dynamic || invocation.external);
+			if (invocation.external) {
+				op.cache = nativeCaches.size();
+				nativeCaches.pushBack({});
+			} else if (invocation.dynamic) {
+				op.cache = callCaches.size();
+				callCaches.pushBack({});
+			}
+		} else if (
+			op.instruction.name == Instruction::Name::AV2_IN_FIELD_GET
+		||	op.instruction.name == Instruction::Name::AV2_IN_FIELD_SET
+		) {
+			op.cache = fieldCaches.size();
+			fieldCaches.pushBack({});
+		}
+		if (!hasStaticTarget || (i + 1) >= size) continue;
+		auto const location = bitcast<uint64>(program->code[i+1]);
+		switch (mode) {
+			case JumpMode::AV2_JM_TABLE_INDEX:
+				if (location < program->jumpTable.size())
+					op.target = program->jumpTable[location];
+			break;
+			case JumpMode::AV2_JM_ABSOLUTE:
+				if (location < size)
+					op.target = location;
+			break;
+			case JumpMode::AV2_JM_RELATIVE: {
+				auto const to = (i + 1) + bitcast<int64>(location);
+				if (to < size)
+					op.target = to;
+			} break;
+		}
+	}
+	// Compiled code skips the dispatch loop, so it would go unaccounted for
+	if (config.profile)
+		profiler = Unique<Profiler>(new Profiler(*program));
+	else if (config.jit && config.threadedDispatch && JIT::SUPPORTED)
+		jit = Unique<JIT>(new JIT(*this, config.jitThreshold));
+}
+
+usize Engine::resolvedTarget() const {
+	auto const index = context.pointers.instruction - 1;
+	if (index < decoded.size())
+		return decoded.cbegin()[index].target;
+	return NO_TARGET;
+}
+
+ref<Object::FieldAccess const> Engine::fieldAccess(usize const site, Runtime::Context::Storage const& object, uint64 const index) {
+	if (site >= decoded.size() || decoded[site].cache == NO_CACHE || object.unboxed() || !object)
+		return nullptr;
+	auto& cache = fieldCaches[decoded[site].cache];
+	auto const& receiver = *object;
+	// Type definitions changed, so resolved accesses might no longer apply
+	if (cache.revision != context.art.typeRevision()) {
+		cache			= {};
+		cache.revision	= context.art.typeRevision();
+	}
+	for (usize i = 0; i < cache.count; ++i)
+		if (receiver.accepts(cache.entries[i], index)) {
+			++cacheStats.fieldHits;
+			return &cache.entries[i];
+		}
+	++cacheStats.fieldMisses;
+	auto const access = receiver.accessField(index);
+	if (!access.type) return nullptr;
+	auto& entry	= cache.entries[cache.next];
+	entry		= access;
+	cache.next	= (cache.next + 1) % CACHE_WAYS;
+	if (cache.count < CACHE_WAYS) ++cache.count;
+	return &entry;
+}
+
+usize Engine::callTarget(usize const site, uint64 const id) {
+	if (site >= decoded.size() || decoded[site].cache == NO_CACHE)
+		return NO_TARGET;
+	auto& cache = callCaches[decoded[site].cache];
+	for (usize i = 0; i < cache.count; ++i)
+		if (cache.ids[i] == id) {
+			++cacheStats.callHits;
+			return cache.targets[i];
+		}
+	++cacheStats.callMisses;
+	if (id >= program->jumpTable.size())
+		return NO_TARGET;
+	cache.ids[cache.next]		= id;
+	cache.targets[cache.next]	= program->jumpTable[id];
+	auto const target			= cache.targets[cache.next];
+	cache.next = (cache.next + 1) % CACHE_WAYS;
+	if (cache.count < CACHE_WAYS) ++cache.count;
+	return target;
+}
+
+ref<Core::Context::NativeCall> Engine::nativeCall(usize const site, uint64 const hash) {
+	if (site >= decoded.size() || decoded[site].cache == NO_CACHE)
+		return nullptr;
+	auto& cache = nativeCaches[decoded[site].cache];
+	auto& art = context.art;
+	if (
+		cache.call
+	&&	cache.hash	== hash
+	&&	cache.calls	== art.nativeCallRevision()
+	&&	cache.types	== art.typeRevision()
+	) {
+		++cacheStats.nativeHits;
+		return cache.call;
+	}
+	++cacheStats.nativeMisses;
+	cache = {hash, art.nativeCallOf(hash), art.nativeCallRevision(), art.typeRevision()};
+	return cache.call;
+}
+
+void Engine::invokeNative(Core::Context::NativeCall& method, Instruction::Invocation const invocation) {
+	auto& stack		= context.globalValueStack;
+	auto const argc	= method.argc;
+	if (stack.size() < argc)
+		return crash(invalidSourceError("Not enough values in global stack for external call!"));
+	// Arguments get read straight off the stack, so they must only be removed after the call
+	auto const result = method.invoker->call(context.art, method, {argc ? &stack.back() : nullptr});
+	// Same as the generic path, which keeps the topmost argument and removes the ones below it
+	if (argc > 1) {
+		stack[-Cast::as<ssize>(argc)] = stack.back();
+		for (usize i = 1; i < argc; ++i)
+			stack.popBack();
+	}
+	if (invocation.noResult) return;
+	if (!result || (!result.unboxed() && result->isEmptyType()))
+		return crash(invalidFunctionError("Expected return type, but function is void"));
+	stack.pushBack(result);
+}
+
+void Engine::dispatch() {
+	auto const	ops			= decoded.cbegin();
+	auto const	fetchEnd	= decoded.size();
+	auto&		ip			= context.pointers.instruction;
+	while (running()) {
+		if (!fuel && !refuel()) break;
+		if (context.scopeStack.empty())
+			context.enterScope();
+		bool const revertContext = context.scope().prevMode != context.scope().mode;
+		auto const fetch = ip + 1;
+		ip = ops[fetch < fetchEnd ? fetch : (fetchEnd - 1)].next;
+		auto const& op = ops[ip];
+		if (op.native && !revertContext) {
+			if (precompiled) bitcast<Precompiled::Function>(op.native)(*this, ip);
+			else jit->run(op.native);
+			if (!running() || delay) break;
+			continue;
+		}
+		current = op.instruction;
+		--fuel;
+		MAKAILIB_DEBUGLN_FULL("Instruction: ", Instruction::asString(current.name));
+		if (profiler) profiler->step(current.name);
+		if (op.handler)
+			(this->*op.handler)();
+		if (!running()) break;
+		if (revertContext) context.scope().mode = context.scope().prevMode;
+		if (delay) break;
+	}
+}
+
 bool Engine::process() {
+	return process(Budget{});
+}
+
+static usize now() {
+	return Makai::OS::Time::Clock::sinceStart<Makai::OS::Time::Nanos>();
+}
+
+bool Engine::process(Budget const& budget) {
+	Core::Pool::Scope const scope(*context.art.pool);
+	auto const start	= now();
+	auto const granted	= budget.instructions ? budget.instructions : Limit::MAX<usize>;
+	fuel		= 0;
+	allowance	= granted;
+	deadline	= budget.time ? start + budget.time : 0;
+	used		= {};
 	if (delay) --delay;
-	else while (Engine::yieldCycle() && !delay) {}
+	else if (config.threadedDispatch && decoded.size()) dispatch();
+	else while (!delay && (fuel || refuel())) {
+		--fuel;
+		if (!Engine::yieldCycle()) break;
+	}
 	MAKAILIB_DEBUGLN_FULL("Done processing for now!");
+	used.instructions	= granted - allowance - fuel;
+	used.time			= now() - start;
 	return running();
 }
 
+bool Engine::refuel() {
+	if (!allowance || (deadline && now() >= deadline)) {
+		used.preempted = true;
+		return false;
+	}
+	fuel		= deadline ? Math::min(allowance, BUDGET_CHECK_INTERVAL) : allowance;
+	allowance	-= fuel;
+	return true;
+}
+
 void Engine::crash(Engine::Error const& e) {
 	err = e;
 	terminate();
@@ -138,9 +361,9 @@ void Engine::crash(Engine::Error const& e) {
 
 void Engine::v2Yield() {
 	Instruction::Waiting wait = bitcast<Instruction::Waiting>(current.type);
-	if (wait.dynamic)
-		context.pop().perform([&] (auto const& obj) {delay = obj.template toValue<uint64>();});
-	else if (wait.once)
+	if (wait.dynamic) {
+		if (auto const v = context.pop()) delay = v.toValue<uint64>();
+	} else if (wait.once)
 		delay = 1;
 	else {
 		advance(true);
@@ -166,28 +389,28 @@ static int8 doFastCompareEX(T& lhs, T& rhs, Comparator const comp) {
 }
 
 template <class T>
-inline static int8 doFastCompareStringOrBytes(Object::Storage const& lhs, Object::Storage const& rhs, Comparator const comp) {
-	T lx = lhs->toValue<T>();
-	T rx = rhs->toValue<T>();
+inline static int8 doFastCompareStringOrBytes(Runtime::Context::Storage const& lhs, Runtime::Context::Storage const& rhs, Comparator const comp) {
+	T lx = lhs.toValue<T>();
+	T rx = rhs.toValue<T>();
 	return doFastCompareEX(lx, rx, comp);
 }
 
 template <class T>
-inline static int8 doFastCompareCoherent(Object::Storage const& lhs, Object::Storage const& rhs, Comparator const comp) {
-	T& lx = *(T*)(lhs->data());
-	T& rx = *(T*)(rhs->data());
+inline static int8 doFastCompareCoherent(Runtime::Context::Storage const& lhs, Runtime::Context::Storage const& rhs, Comparator const comp) {
+	T& lx = *(T*)(lhs.data());
+	T& rx = *(T*)(rhs.data());
 	return doFastCompareEX(lx, rx, comp);
 }
 
 
 template <class T>
-static int8 doImmediateCompareCoherent(Object::Storage const& lhs, uint64& rhs, Comparator const comp) {
-	T& lx = *(T*)(lhs->data());
+static int8 doImmediateCompareCoherent(Runtime::Context::Storage const& lhs, uint64& rhs, Comparator const comp) {
+	T& lx = *(T*)(lhs.data());
 	T& rx = *(T*)(&rhs);
 	return doFastCompareEX(lx, rx, comp);
 }
 
-static int8 doFastCompare(Object::Storage const& lx, Object::Storage const& rx, BasicType const type, Comparator const comp) {
+static int8 doFastCompare(Runtime::Context::Storage const& lx, Runtime::Context::Storage const& rx, BasicType const type, Comparator const comp) {
 	if (type == BasicType::AV2_BT_STRING) [[unlikely]]	return doFastCompareStringOrBytes<Makai::UTF8String>(lx, rx, comp);
 	if (type == BasicType::AV2_BT_BYTES) [[unlikely]]	return doFastCompareStringOrBytes<Makai::Bytes<>>(lx, rx, comp);
 	switch (type) {
@@ -214,7 +437,7 @@ static int8 doFastCompare(Object::Storage const& lx, Object::Storage const& rx,
 	}
 }
 
-static int8 doImmediateCompare(Object::Storage const& lx, uint64& rx, BasicType const type, Comparator const comp) {
+static int8 doImmediateCompare(Runtime::Context::Storage const& lx, uint64& rx, BasicType const type, Comparator const comp) {
 	switch (type) {
 		default:
 		case Core::BasicType::AV2_BT_VOID:
@@ -312,8 +535,8 @@ Engine::Error Engine::missingArgumentsError() {
 void Engine::advance(bool isRequired) {
 	++context.pointers.instruction;
 	if (!isRequired) MAKAILIB_DEBUGLN_FULL("Fetching instruction [", context.pointers.instruction, "] ...");
-	if (context.pointers.instruction < program.code.size())
-		current = program.code[context.pointers.instruction];
+	if (context.pointers.instruction < program->code.size())
+		current = program->code[context.pointers.instruction];
 	else if (isRequired)
 		return crash(endOfProgramError());
 	else return terminate();
@@ -334,7 +557,51 @@ void Engine::v2Copy() {
 	to = from;
 }
 
+void Engine::externalCall(usize const site, uint64 const hash, Instruction::Invocation const invocation) {
+	if (auto const native = nativeCall(site, hash))
+		return invokeNative(*native, invocation);
+	Core::Context::Arguments args;
+	if (auto argc = context.art.argumentCountOf(hash)) {
+		if (context.globalValueStack.size() < argc)
+			return crash(invalidSourceError("Not enough values in global stack for external call!"));
+		args.reserve(argc);
+		for (usize i = 1; i <= argc; ++i)
+			args.pushBack(context.globalValueStack[-Cast::as<ssize>(i)]);
+		context.globalValueStack.eraseRange(-argc, -1);
+	}
+	context.art
+		.callNative(hash, args)
+		.then(
+			[&] (auto const& v) {
+				if (invocation.noResult) return;
+				if (!v || v->isEmptyType())
+					crash(invalidFunctionError("Expected return type, but function is void"));
+				else context.globalValueStack.pushBack(v);
+			}
+		).onError(
+			[&] (auto const& e) {
+				if (invocation.optional) {
+					if (!invocation.noResult)
+						context.globalValueStack.pushBack(nullptr);
+					return;
+				}
+				Makai::String err = "EXTERNAL FUNCTION: ";
+				switch (e) {
+					using enum Core::Context::Error;
+					case AV2_CCE_MISSING_METHOD:		err += "Function does not exist";								break;
+					case AV2_CCE_MISSING_INVOKER:		err += "Invoker for function is mysteriously gone";				break;
+					case AV2_CCE_MISSING_ARGS:			err += "Not enough args for function";							break;
+					case AV2_CCE_MISSING_ART_TYPE:		err += "Return type does not exist in the current ART context";	break;
+					case AV2_CCE_HOW_DID_YOU_GET_HERE:	err += "Somehow, execution reached an unreachable point";		break;
+				}
+				crash(invalidFunctionError(err));
+			}
+		)
+	;
+}
+
 void Engine::v2Call() {
+	auto const site = context.pointers.instruction;
 	// Get invocation
 	Instruction::Invocation invocation = bitcast<Instruction::Invocation>(current.type);
 	uint64 loc = 0;
@@ -348,58 +615,51 @@ void Engine::v2Call() {
 	}
 	MAKAILIB_DEBUGLN_FULL("Handling call...");
 	if (invocation.external) {
-		decltype(context.globalValueStack) args;
-		if (auto argc = context.art.argumentCountOf(loc)) {
-			args = context.globalValueStack.sliced(-argc, -1).reverse();
-			context.globalValueStack.eraseRange(-argc, -1);
-		}
-		context.art
-			.callNative(loc, args)
-			.then(
-				[&] (auto const& v) {
-					if (invocation.noResult) return;
-					if (!v || v->isEmptyType())
-						crash(invalidFunctionError("Expected return type, but function is void"));
-					else context.globalValueStack.pushBack(v);
-				}
-			).onError(
-				[&] (auto const& e) {
-					if (invocation.optional) {
-						if (!invocation.noResult)
-							context.globalValueStack.pushBack(nullptr);
-						return;
-					}
-					Makai::String err = "EXTERNAL FUNCTION: ";
-					switch (e) {
-						using enum Core::Context::Error;
-						case AV2_CCE_MISSING_METHOD:		err += "Function does not exist";								break;
-						case AV2_CCE_MISSING_INVOKER:		err += "Invoker for function is mysteriously gone";				break;
-						case AV2_CCE_MISSING_ARGS:			err += "Not enough args for function";							break;
-						case AV2_CCE_MISSING_ART_TYPE:		err += "Return type does not exist in the current ART context";	break;
-						case AV2_CCE_HOW_DID_YOU_GET_HERE:	err += "Somehow, execution reached an unreachable point";		break;
-					}
-					crash(invalidFunctionError(err));
-				}
-			)
-		;
-	} else jumpByTableIndex(loc, true /*returnable*/);
+		if (profiler) {
+			auto const start = Profiler::now();
+			externalCall(site, loc, invocation);
+			return profiler->native(loc, start);
+		}
+		return externalCall(site, loc, invocation);
+	}
+	// Tail calls reuse the current frame, so the callee returns straight to wherever this one would have
+	bool const reuse = invocation.tail && context.pointerStack.size();
+	if (reuse) dropFrame();
+	if (auto const to = resolvedTarget(); !invocation.dynamic && to != NO_TARGET) {
+		if (jit) jit->heat(to);
+		jumpTo(to, !reuse /*returnable*/);
+	} else if (auto const to = invocation.dynamic ? callTarget(site, loc) : NO_TARGET; to != NO_TARGET) {
+		if (jit) jit->heat(to);
+		jumpTo(to, !reuse /*returnable*/);
+	} else jumpByTableIndex(loc, !reuse /*returnable*/);
+	if (reuse && profiler) profiler->enter(context.pointers.instruction);
 }
 
 Runtime::Context::Storage Engine::consumeValue(ValueLocation const from) {
 	if (from.desc.source != ValueLocation::Source::AV2_VLS_BOOL) advance(true);
 	auto const store = getValueFromLocation(from, bitcast<uint64>(current));
 	printValueState(store);
-	if (store && !store->getOriginalType())
+	if (store && !store.unboxed() && !store->getOriginalType())
 		crash(makeErrorHere("Missing type information!"));
 	return store;
 }
 
 Runtime::Context::Storage Engine::validate(Runtime::Context::Storage const& value, bool const passByCopy) {
-	if (!value) return Object::Storage();
+	if (!value) return nullptr;
+	if (value.unboxed()) return value;
+	if (passByCopy)
+		if (auto const v = context.art.unboxed(*value))
+			return v;
 	if (auto const type = value->getType())
 		if (passByCopy && !type->flags.isCopyable)
 			return value->shallowClone();
-	return passByCopy ? value->clone() : value;
+	if (passByCopy)
+		return value->clone();
+	return value;
+}
+
+Runtime::Context::Storage Engine::stringConstant(usize const id) const {
+	return context.art.newInterned(strings[id]);
 }
 
 Runtime::Context::Storage Engine::getValueFromLocation(ValueLocation const loc, uint64 const id) {
@@ -417,38 +677,38 @@ Runtime::Context::Storage Engine::getValueFromLocation(ValueLocation const loc,
 			return nullptr;
 		} break;
 		case ValueLocation::Source::AV2_VLS_BOOL: {
-			return context.art.newValue(loc.forBool.flag);
+			return context.newValue(loc.forBool.flag);
 		} break;
 		case ValueLocation::Source::AV2_VLS_INT: {
 			MAKAILIB_DEBUGLN_FULL("Creating integer...");
 			if (loc.forInt.isUnsigned) {
 				MAKAILIB_DEBUGLN_FULL(":: UNSIGNED");
 				switch (loc.forInt.size) {
-					case ValueLocation::ForInteger::Size::AV2_VL_IS_16_BIT: return context.art.newValue(Makai::Cast::as<uint16>(id)); break;
-					case ValueLocation::ForInteger::Size::AV2_VL_IS_32_BIT: return context.art.newValue(Makai::Cast::as<uint32>(id)); break;
-					case ValueLocation::ForInteger::Size::AV2_VL_IS_64_BIT: return context.art.newValue(Makai::Cast::as<uint64>(id)); break;
-					default: return context.art.newValue(Makai::Cast::as<uint8>(id)); break;
+					case ValueLocation::ForInteger::Size::AV2_VL_IS_16_BIT: return context.newValue(Makai::Cast::as<uint16>(id)); break;
+					case ValueLocation::ForInteger::Size::AV2_VL_IS_32_BIT: return context.newValue(Makai::Cast::as<uint32>(id)); break;
+					case ValueLocation::ForInteger::Size::AV2_VL_IS_64_BIT: return context.newValue(Makai::Cast::as<uint64>(id)); break;
+					default: return context.newValue(Makai::Cast::as<uint8>(id)); break;
 				}
 			} else {
 				MAKAILIB_DEBUGLN_FULL(":: SIGNED");
 				switch (loc.forInt.size) {
-					case ValueLocation::ForInteger::Size::AV2_VL_IS_16_BIT: return context.art.newValue(Makai::Cast::bit<int16, uint16>(id)); break;
-					case ValueLocation::ForInteger::Size::AV2_VL_IS_32_BIT: return context.art.newValue(Makai::Cast::bit<int32, uint32>(id)); break;
-					case ValueLocation::ForInteger::Size::AV2_VL_IS_64_BIT: return context.art.newValue(Makai::Cast::bit<int64, uint64>(id)); break;
-					default: return context.art.newValue(Makai::Cast::bit<int8, uint8>(id)); break;
+					case ValueLocation::ForInteger::Size::AV2_VL_IS_16_BIT: return context.newValue(Makai::Cast::bit<int16, uint16>(id)); break;
+					case ValueLocation::ForInteger::Size::AV2_VL_IS_32_BIT: return context.newValue(Makai::Cast::bit<int32, uint32>(id)); break;
+					case ValueLocation::ForInteger::Size::AV2_VL_IS_64_BIT: return context.newValue(Makai::Cast::bit<int64, uint64>(id)); break;
+					default: return context.newValue(Makai::Cast::bit<int8, uint8>(id)); break;
 				}
 			}
 		} break;
 		case ValueLocation::Source::AV2_VLS_REAL: {
 			switch (loc.forReal.size) {
-				case ValueLocation::ForReal::Size::AV2_VL_RS_64_BIT: return context.art.newValue(Makai::Cast::bit<float64>(id)); break;
-				case ValueLocation::ForReal::Size::AV2_VL_RS_128_BIT: return context.art.newValue(Makai::Cast::as<float128>(Makai::Cast::bit<float64>(id))); break;
-				default: return context.art.newValue(Makai::Cast::bit<float32, uint32>(id)); break;
+				case ValueLocation::ForReal::Size::AV2_VL_RS_64_BIT: return context.newValue(Makai::Cast::bit<float64>(id)); break;
+				case ValueLocation::ForReal::Size::AV2_VL_RS_128_BIT: return context.newValue(Makai::Cast::as<float128>(Makai::Cast::bit<float64>(id))); break;
+				default: return context.newValue(Makai::Cast::bit<float32, uint32>(id)); break;
 			}
 		} break;
 		case ValueLocation::Source::AV2_VLS_STRING: {
-			MAKAILIB_DEBUGLN_FULL("Creating string '", program.strings[id], "'");
-			auto const v = context.art.newValue(program.strings[id]);
+			MAKAILIB_DEBUGLN_FULL("Creating string '", program->strings[id], "'");
+			auto const v = stringConstant(id);
 			MAKAILIB_DEBUGLN_FULL("Created '", v->toValue<String>(), "'");
 			return v;
 		} break;
@@ -459,6 +719,7 @@ Runtime::Context::Storage Engine::getValueFromLocation(ValueLocation const loc,
 				return nullptr;
 			}
 			auto& loc = context.globalValueStack[id  % context.globalValueStack.size()];
+			if (!(byCopy || byMove)) loc.box();
 			auto const v = loc;
 			printValueState(v);
 			if (byMove) loc = nullptr;
@@ -471,28 +732,31 @@ Runtime::Context::Storage Engine::getValueFromLocation(ValueLocation const loc,
 				return nullptr;
 			}
 			auto& loc = context.globalValueStack[-Cast::as<ssize>(id % context.globalValueStack.size() + 1)];
+			if (!(byCopy || byMove)) loc.box();
 			auto const v = loc;
 			printValueState(v);
 			if (byMove) loc = nullptr;
 			return validate(v, byCopy);
 		}
-		case ValueLocation::Source::AV2_VLS_GLOBAL:	return global(id);
+		case ValueLocation::Source::AV2_VLS_GLOBAL:	return global(id).box();
 		case ValueLocation::Source::AV2_VLS_LOCAL: {
-			if (context.locals().empty()) {
+			auto locals = context.locals();
+			if (locals.empty()) {
 				if (inStrictMode())
 					crash(invalidLocationError(loc));
 				return nullptr;
 			}
-			auto& loc = context.locals()[id  % context.locals().size()];
+			auto& loc = locals[id  % locals.size()];
+			if (!(byCopy || byMove)) loc.box();
 			auto const v = loc;
-			MAKAILIB_DEBUGLN_FULL("Local: ", id % context.locals().size());
+			MAKAILIB_DEBUGLN_FULL("Local: ", id % locals.size());
 			printValueState(v);
 			if (byMove) loc = nullptr;
 			return validate(v, byCopy);
 		}
 		case ValueLocation::Source::AV2_VLS_EXTERNAL: {
-			if (program.ani)
-				return external(program.ani->out[id], !byCopy);
+			if (program->ani)
+				return external(program->ani->out[id], !byCopy);
 			else if (inStrictMode())
 				crash(invalidLocationError(loc));
 			return nullptr;
@@ -511,13 +775,13 @@ Runtime::Context::Storage Engine::getValueFromLocation(ValueLocation const loc,
 Runtime::Context::Storage& Engine::accessValue(ValueLocation const from) {
 	if (from.desc.source != ValueLocation::Source::AV2_VLS_BOOL) advance(true);
 	auto& loc = accessLocation(from, bitcast<uint64>(current));
-	if (loc && !loc->getOriginalType())
+	if (loc && !loc.unboxed() && !loc->getOriginalType())
 		crash(makeErrorHere("Missing type information!"));
 	return loc;
 }
 
 Runtime::Context::Storage& Engine::accessLocation(ValueLocation const loc, usize const id) {
-	static Context::Storage failsafe;
+	static thread_local Context::Storage failsafe;
 	switch (loc.desc.source) {
 		case ValueLocation::Source::AV2_VLS_STACK: {
 			if (context.globalValueStack.empty()) {
@@ -532,11 +796,14 @@ Runtime::Context::Storage& Engine::accessLocation(ValueLocation const loc, usize
 			return context.globalValueStack[-Cast::as<ssize>(id % context.globalValueStack.size() + 1)];
 		}
 		case ValueLocation::Source::AV2_VLS_LOCAL: {
-			if (context.locals().empty()) {
+			auto locals = context.locals();
+			if (locals.empty()) {
 				crash(invalidLocationError(loc));
+				return failsafe;
 			}
-			return context.locals()[id % context.locals().size()];
+			return locals[id % locals.size()];
 		}
+		case ValueLocation::Source::AV2_VLS_GLOBAL: return global(id);
 		default:
 			crash(invalidLocationError(loc));
 	}
@@ -545,12 +812,16 @@ Runtime::Context::Storage& Engine::accessLocation(ValueLocation const loc, usize
 }
 
 Runtime::Context::Storage& Engine::global(uint64 const id) {
-	return context.globals[id];
+	if (id < context.globals.size()) [[likely]]
+		return context.globals[id];
+	return context.sparseGlobals[id];
 }
 
 void Engine::jumpTo(usize const point, bool returnable) {
-	if (returnable)
+	if (returnable) {
 		context.pointerStack.pushBack(context.pointers);
+		if (profiler) profiler->enter(point);
+	}
 	context.pointers.instruction = point;
 }
 
@@ -559,11 +830,11 @@ void Engine::jumpByTableIndex(usize const tableID, bool returnable) {
 	if (tableID == Makai::Limit::MAX<uint64>)
 		return;
 	MAKAILIB_DEBUGLN_FULL("Jumping to target...");
-	if (tableID < program.jumpTable.size())
-		jumpTo(program.jumpTable[tableID], returnable);
+	if (tableID < program->jumpTable.size())
+		jumpTo(program->jumpTable[tableID], returnable);
 	else return crash(invalidJump());
 	MAKAILIB_DEBUGLN_FULL("Table index: ", tableID);
-	MAKAILIB_DEBUGLN_FULL("We goin to: ", program.jumpTable[tableID]);
+	MAKAILIB_DEBUGLN_FULL("We goin to: ", program->jumpTable[tableID]);
 	MAKAILIB_DEBUGLN_FULL("The Rabbit has Landed!");
 }
 
@@ -572,13 +843,13 @@ void Engine::jumpByMode(Instruction::Leap::Mode const mode, usize const location
 		case JumpMode::AV2_JM_TABLE_INDEX:
 			return jumpByTableIndex(location, returnable);
 		case JumpMode::AV2_JM_ABSOLUTE: {
-			if (location < program.code.size())
+			if (location < program->code.size())
 				return jumpTo(location, returnable);
 			else crash(invalidJump());
 		}
 		case JumpMode::AV2_JM_RELATIVE: {
 			auto const to = context.pointers.instruction + bitcast<int64>(location);
-			if (to < program.code.size())
+			if (to < program->code.size())
 				return jumpTo(to, returnable);
 			else crash(invalidJump());
 		}
@@ -586,23 +857,32 @@ void Engine::jumpByMode(Instruction::Leap::Mode const mode, usize const location
 }
 
 bool Engine::hasExposedCall(String const& signal) {
-	return program.ani && program.ani->in.contains(signal);
+	return program && program->ani && program->ani->in.contains(signal);
 }
 
 void Engine::invokeExposedCall(String const& signal, Core::Context::Arguments const& args) {
 	if (hasExposedCall(signal)) {
 		if (args.size())
-			context.globalValueStack.appendBack(args.reversed());
-		jumpTo(program.jumpTable[program.ani->in[signal]], true);
+			for (auto const& arg: args.reversed())
+				context.push(arg);
+		jumpTo(program->jumpTable[program->ani->in[signal]], true);
 	}
 }
 
+void Engine::dropFrame() {
+	if (profiler) profiler->leave();
+	while (
+		context.scopeStack.size()
+	&&	context.scope().pointerFrame >= context.pointerStack.size()
+	) context.exitScope();
+}
 void Engine::returnBack() {
 	context.pointers = context.pointerStack.popBack();
+	if (profiler) profiler->leave();
 	while (
 		context.scopeStack.size()
-	&&	context.scopeStack.back()->pointerFrame > context.pointerStack.size()
-	) context.scopeStack.popBack();
+	&&	context.scope().pointerFrame > context.pointerStack.size()
+	) context.exitScope();
 }
 
 Runtime::Context::Storage Engine::external(String const& name, bool const byRef) {
@@ -613,90 +893,108 @@ template <Makai::Type::Integer T>
 using Int = Makai::Meta::If<Makai::Type::Unsigned<T>, uint64, int64>;
 
 template <class T>
-static bool bopIt(Object::Storage const& out, Object::Storage const& lhs, Object::Storage const& rhs, Operator const op, Runtime::Context& context) {
+static bool bopIt(Runtime::Context::Storage& out, Runtime::Context::Storage const& lhs, Runtime::Context::Storage const& rhs, Operator const op, Runtime::Context& context) {
 	if constexpr (Makai::Type::Equal<T, bool>) {
 		switch (op) {
 			using enum Operator;
-			case AV2_BOP_ADD:	*out = *context.art.newValue<T>(lhs->toValue<T>() || rhs->toValue<T>());	return true;
-			case AV2_BOP_SUB:	*out = *context.art.newValue<T>(lhs->toValue<T>() != rhs->toValue<T>());	return true;
-			case AV2_BOP_MUL:	*out = *context.art.newValue<T>(lhs->toValue<T>() && rhs->toValue<T>());	return true;
+			case AV2_BOP_ADD:	out.store(context.newValue<T>(lhs.toValue<T>() || rhs.toValue<T>()));	return true;
+			case AV2_BOP_SUB:	out.store(context.newValue<T>(lhs.toValue<T>() != rhs.toValue<T>()));	return true;
+			case AV2_BOP_MUL:	out.store(context.newValue<T>(lhs.toValue<T>() && rhs.toValue<T>()));	return true;
 			default: break;
 		}
 	} else if constexpr (Makai::Type::Number<T>) {
 		switch (op) {
 			using enum Operator;
-			case AV2_BOP_ADD:	*out = *context.art.newValue<T>(lhs->toValue<T>() + rhs->toValue<T>()); return true;
-			case AV2_BOP_SUB:	*out = *context.art.newValue<T>(lhs->toValue<T>() - rhs->toValue<T>()); return true;
-			case AV2_BOP_MUL:	*out = *context.art.newValue<T>(lhs->toValue<T>() * rhs->toValue<T>()); return true;
+			case AV2_BOP_ADD:	out.store(context.newValue<T>(lhs.toValue<T>() + rhs.toValue<T>())); return true;
+			case AV2_BOP_SUB:	out.store(context.newValue<T>(lhs.toValue<T>() - rhs.toValue<T>())); return true;
+			case AV2_BOP_MUL:	out.store(context.newValue<T>(lhs.toValue<T>() * rhs.toValue<T>())); return true;
 			default: break;
 		}
 	}
 	if constexpr (Makai::Type::Different<T, Makai::Matrix4x4>) {
 		switch (op) {
 			using enum Operator;
-			case AV2_BOP_DIV:	*out = *context.art.newValue<T>(lhs->toValue<T>() / rhs->toValue<T>()); return true;
+			case AV2_BOP_DIV:	out.store(context.newValue<T>(lhs.toValue<T>() / rhs.toValue<T>())); return true;
 			default: break;
 		}
 	}
 	if constexpr (Makai::Type::Number<T>) {
 		switch (op) {
 			using enum Operator;
-			case AV2_BOP_REM:	*out = *context.art.newValue<T>((T)Makai::Math::mod<double>(lhs->toValue<T>(), rhs->toValue<T>()));		return true;
-			case AV2_BOP_POW:	*out = *context.art.newValue<T>(Makai::Math::pow<double>(lhs->toValue<T>(), rhs->toValue<T>()));		return true;
-			case AV2_BOP_ATAN2:	*out = *context.art.newValue<T>((T)Makai::Math::atan2<double>(lhs->toValue<T>(), rhs->toValue<T>()));	return true;
-			case AV2_BOP_LOGX:	*out = *context.art.newValue<T>(Makai::Math::logn<double>(lhs->toValue<T>(), rhs->toValue<T>()));		return true;
+			case AV2_BOP_REM:	out.store(context.newValue<T>((T)Makai::Math::mod<double>(lhs.toValue<T>(), rhs.toValue<T>())));		return true;
+			case AV2_BOP_POW:	out.store(context.newValue<T>(Makai::Math::pow<double>(lhs.toValue<T>(), rhs.toValue<T>())));		return true;
+			case AV2_BOP_ATAN2:	out.store(context.newValue<T>((T)Makai::Math::atan2<double>(lhs.toValue<T>(), rhs.toValue<T>())));	return true;
+			case AV2_BOP_LOGX:	out.store(context.newValue<T>(Makai::Math::logn<double>(lhs.toValue<T>(), rhs.toValue<T>())));		return true;
 			default: break;
 		}
 	}
 	if constexpr (Makai::Type::Integer<T>) {
 		switch (op) {
 			using enum Operator;
-			case AV2_BOP_BIT_AND:	*out = *context.art.newValue<T>(lhs->toValue<Int<T>>() & rhs->toValue<Int<T>>());	return true;
-			case AV2_BOP_BIT_OR:	*out = *context.art.newValue<T>(lhs->toValue<Int<T>>() | rhs->toValue<Int<T>>());	return true;
-			case AV2_BOP_BIT_XOR:	*out = *context.art.newValue<T>(lhs->toValue<Int<T>>() ^ rhs->toValue<Int<T>>());	return true;
+			case AV2_BOP_BIT_AND:	out.store(context.newValue<T>(lhs.toValue<Int<T>>() & rhs.toValue<Int<T>>()));	return true;
+			case AV2_BOP_BIT_OR:	out.store(context.newValue<T>(lhs.toValue<Int<T>>() | rhs.toValue<Int<T>>()));	return true;
+			case AV2_BOP_BIT_XOR:	out.store(context.newValue<T>(lhs.toValue<Int<T>>() ^ rhs.toValue<Int<T>>()));	return true;
 			default: break;
 		}
 	}
 	if constexpr (Makai::Type::Equal<T, bool>) {
 		switch (op) {
 			using enum Operator;
-			case AV2_BOP_LOGIC_AND:	*out = *context.art.newValue<T>(lhs->toValue<T>() && rhs->toValue<T>());	return true;
-			case AV2_BOP_LOGIC_OR:	*out = *context.art.newValue<T>(lhs->toValue<T>() || rhs->toValue<T>());	return true;
-			case AV2_BOP_LOGIC_XOR:	*out = *context.art.newValue<T>(lhs->toValue<T>() != rhs->toValue<T>());	return true;
+			case AV2_BOP_LOGIC_AND:	out.store(context.newValue<T>(lhs.toValue<T>() && rhs.toValue<T>()));	return true;
+			case AV2_BOP_LOGIC_OR:	out.store(context.newValue<T>(lhs.toValue<T>() || rhs.toValue<T>()));	return true;
+			case AV2_BOP_LOGIC_XOR:	out.store(context.newValue<T>(lhs.toValue<T>() != rhs.toValue<T>()));	return true;
 			default: break;
 		}
 	}
 	return false;
 }
 
-static bool stringBopIt(Object::Storage const& out, Object::Storage const& lhs, Object::Storage const& rhs, Operator const op, Runtime::Context& context) {
+static bool stringBopIt(Runtime::Context::Storage& out, Runtime::Context::Storage const& lhs, Runtime::Context::Storage const& rhs, Operator const op, Runtime::Context& context) {
 	using S = Makai::UTF8String;
 	switch (op) {
 		using enum Operator;
 		case AV2_BOP_MUL: {
 			S result;
-			S const str = lhs->toValue<S>();
-			auto const times = lhs->toValue<uint64>();
+			S const str = lhs.toValue<S>();
+			auto const times = lhs.toValue<uint64>();
 			for (usize i = 0; i < times; ++i) result += str;
-			*out = *context.art.newValue<S>(result);
+			out.store(context.newValue<S>(result));
+		} return true;
+		case AV2_BOP_ADD: {
+			// The result would get stored into the left-hand object anyway, so append straight into it
+			if (lhs->append(*rhs)) return true;
+			out.store(context.newValue<S>(lhs.toValue<S>() + rhs.toValue<S>()));
 		} return true;
-		case AV2_BOP_ADD:		*out = *context.art.newValue<S>(lhs->toValue<S>() + rhs->toValue<S>()); 								return true;
 		case AV2_BOP_REM: {
-			if (auto const m = Makai::Regex::findFirst(lhs->toValue<S>(), rhs->toValue<S>())) {
-				*out = *context.art.newValue<S>(m.value().match);
-			} else *out = *context.newValue<S>("");
+			if (auto const m = Makai::Regex::findFirst(lhs.toValue<S>(), rhs.toValue<S>())) {
+				out.store(context.newValue<S>(m.value().match));
+			} else out.store(context.newValue<S>(""));
 			return true;
 		}
-		case AV2_BOP_BIT_OR:	*out = *context.art.newValue(Makai::Regex::contains(lhs->toValue<S>(), rhs->toValue<S>()));				return true;
-		case AV2_BOP_BIT_AND:	*out = *context.art.newValue(Makai::Regex::matches(lhs->toValue<S>(), rhs->toValue<S>()));				return true;
-		case AV2_BOP_SUB:		*out = *context.art.newValue<S>(Makai::Regex::replace(lhs->toValue<S>(), rhs->toValue<S>(), ""));		return true;
-		case AV2_BOP_BIT_XOR:	*out = *context.art.newValue<S>(Makai::Regex::replace(lhs->toValue<S>(), rhs->toValue<S>(), ""));		return true;
+		case AV2_BOP_BIT_OR:	out.store(context.newValue(Makai::Regex::contains(lhs.toValue<S>(), rhs.toValue<S>())));				return true;
+		case AV2_BOP_BIT_AND:	out.store(context.newValue(Makai::Regex::matches(lhs.toValue<S>(), rhs.toValue<S>())));				return true;
+		case AV2_BOP_SUB:		out.store(context.newValue<S>(Makai::Regex::replace(lhs.toValue<S>(), rhs.toValue<S>(), "")));		return true;
+		case AV2_BOP_BIT_XOR:	out.store(context.newValue<S>(Makai::Regex::replace(lhs.toValue<S>(), rhs.toValue<S>(), "")));		return true;
 		default: return false;
 	}
 	return false;
 }
 
-static bool arrayBopIt(Object::Storage const& lhs, Object::Storage const& rhs, Operator const op, Runtime::Context& context) {
+static bool arrayBopIt(Runtime::Context::Storage const& lhs, Runtime::Context::Storage const& rhs, Operator const op, Runtime::Context& context) {
+	if (lhs->isPacked()) {
+		switch (op) {
+			using enum Operator;
+			case AV2_BOP_ADD:
+			case AV2_BOP_SUB:
+			case AV2_BOP_MUL:
+			case AV2_BOP_DIV:
+			case AV2_BOP_REM:	return lhs->map(op, rhs);
+			case AV2_BOP_PUSH:	return lhs->push(rhs);
+			case AV2_BOP_FILL:	return lhs->fill(rhs);
+			case AV2_BOP_COPY:	return lhs->copyFrom(*rhs);
+			default: return false;
+		}
+	}
 	if(lhs->isArray() && rhs->getType()->canBecome(lhs->getType()->base)) {
 		switch (op) {
 			using enum Operator;
@@ -716,7 +1014,7 @@ static bool arrayBopIt(Object::Storage const& lhs, Object::Storage const& rhs, O
 	return false;
 }
 
-static bool arrayUopIt(Object::Storage const& val, Operator const op, Runtime::Context& context) {
+static bool arrayUopIt(Runtime::Context::Storage const& val, Operator const op, Runtime::Context& context) {
 	if(val->isArray()) {
 		switch (op) {
 			using enum Operator;
@@ -730,6 +1028,12 @@ static bool arrayUopIt(Object::Storage const& val, Operator const op, Runtime::C
 					return true;
 				} else return false;
 			}
+			case AV2_UOP_SUM: {
+				if (auto const v = val->sum()) {
+					context.push(v);
+					return true;
+				} else return false;
+			}
 			default: return false;
 		}
 	}
@@ -746,26 +1050,26 @@ void Engine::doBinaryOperation(Operator const op) {
 		return;
 	}
 	auto const _r = rhs.sync();
-	auto lhs	= context.top();
+	auto& out	= context.top();
+	auto lhs	= out;
 	if (!lhs) {
 		if (!inStrictMode()) [[unlikely]] {context.pop(); context.pushEmpty();}
 		else [[likely]] crash(invalidOperationError("Left-Side Operand does not exist!"));
 		return;
 	}
 	auto const _l = lhs.sync();
-	auto out	= lhs;
 	MAKAILIB_DEBUGLN_FULL("LHS: ", lhs->getType() ? Makai::toString(lhs->getType()->hash) : "##ERR");
 	MAKAILIB_DEBUGLN_FULL("RHS: ", rhs->getType() ? Makai::toString(rhs->getType()->hash) : "##ERR");
 	if (err) return;
 	bool success = false;
-	if (lhs->isBoolean() && rhs->isBoolean())				success = bopIt<bool>(out, lhs, rhs, op, context);
-	else if (lhs->isUnsigned() && rhs->isUnsigned())		success = bopIt<uint64>(out, lhs, rhs, op, context);
-	else if (lhs->isSigned() && rhs->isSigned())			success = bopIt<int64>(out, lhs, rhs, op, context);
-	else if (lhs->isNumber() && rhs->isNumber())			success = bopIt<double>(out, lhs, rhs, op, context);
-	else if (lhs->isVectorable() && rhs->isVectorable())	success = bopIt<Vector4>(out, lhs, rhs, op, context);
+	if (lhs.isBoolean() && rhs.isBoolean())					success = bopIt<bool>(out, lhs, rhs, op, context);
+	else if (lhs.isUnsigned() && rhs.isUnsigned())			success = bopIt<uint64>(out, lhs, rhs, op, context);
+	else if (lhs.isSigned() && rhs.isSigned())				success = bopIt<int64>(out, lhs, rhs, op, context);
+	else if (lhs.isNumber() && rhs.isNumber())				success = bopIt<double>(out, lhs, rhs, op, context);
+	else if (lhs.isVectorable() && rhs.isVectorable())		success = bopIt<Vector4>(out, lhs, rhs, op, context);
 	else if (lhs->isAlgebraic() && rhs->isAlgebraic())		success = bopIt<Matrix4x4>(out, lhs, rhs, op, context);
 	else if (lhs->isString() && rhs->isString())			success = stringBopIt(out, lhs, rhs, op, context);
-	else if (lhs->isArray() && rhs->isArray())				success = arrayBopIt(lhs, rhs, op, context);
+	else if (lhs->isArray())								success = arrayBopIt(lhs, rhs, op, context);
 	if (!success) {
 		if (inStrictMode())
 			return crash(invalidOperationError("Invalid/Unsupported operator for the given values!"));
@@ -775,53 +1079,53 @@ void Engine::doBinaryOperation(Operator const op) {
 }
 
 template <class T>
-static bool uopIt(Object::Storage const& out, Object::Storage const& lhs, Operator const op, Runtime::Context& context) {
+static bool uopIt(Runtime::Context::Storage& out, Runtime::Context::Storage const& lhs, Operator const op, Runtime::Context& context) {
 	switch (op) {
 		using enum Operator;
-		case AV2_UOP_NEGATE:	*out = *context.art.newValue<T>(-lhs->toValue<T>());						return true;
-		case AV2_UOP_INVERSE:	*out = *context.art.newValue<T>(Makai::Cast::as<T>(1) / lhs->toValue<T>());	return true;
+		case AV2_UOP_NEGATE:	out.store(context.newValue<T>(-lhs.toValue<T>()));						return true;
+		case AV2_UOP_INVERSE:	out.store(context.newValue<T>(Makai::Cast::as<T>(1) / lhs.toValue<T>()));	return true;
 		default: break;
 	}
 	if constexpr (Makai::Type::Ex::Math::Vector::Vector<T>) {
 		switch (op) {
 			using enum Operator;
-			case AV2_UOP_LENGTH:	*out = *context.art.newValue<T>(lhs->toValue<T>().length());			return true;
+			case AV2_UOP_LENGTH:	out.store(context.newValue<T>(lhs.toValue<T>().length()));			return true;
 			default: break;
 		}
 	}
 	if constexpr (Makai::Type::Number<T>) {
 		switch (op) {
 			using enum Operator;
-			case AV2_UOP_INCREMENT:	*out = *context.art.newValue<T>(lhs->toValue<T>()+1);							return true;
-			case AV2_UOP_DECREMENT:	*out = *context.art.newValue<T>(lhs->toValue<T>()-1);							return true;
-			case AV2_UOP_SIN:		*out = *context.art.newValue<T>(Makai::Math::sin(lhs->toValue<double>()));		return true;
-			case AV2_UOP_COS:		*out = *context.art.newValue<T>(Makai::Math::cos(lhs->toValue<double>()));		return true;
-			case AV2_UOP_TAN:		*out = *context.art.newValue<T>(Makai::Math::tan(lhs->toValue<double>()));		return true;
-			case AV2_UOP_ASIN:		*out = *context.art.newValue<T>((T)asin(lhs->toValue<T>()));					return true;
-			case AV2_UOP_ACOS:		*out = *context.art.newValue<T>((T)acos(lhs->toValue<T>()));					return true;
-			case AV2_UOP_ATAN:		*out = *context.art.newValue<T>((T)atan(lhs->toValue<T>()));					return true;
-			case AV2_UOP_SINH:		*out = *context.art.newValue<T>((T)sinh(lhs->toValue<T>()));					return true;
-			case AV2_UOP_COSH:		*out = *context.art.newValue<T>((T)cosh(lhs->toValue<T>()));					return true;
-			case AV2_UOP_TANH:		*out = *context.art.newValue<T>((T)tanh(lhs->toValue<T>()));					return true;
-			case AV2_UOP_LOG2:		*out = *context.art.newValue<T>(Makai::Math::log2(lhs->toValue<double>()));		return true;
-			case AV2_UOP_LOG10:		*out = *context.art.newValue<T>(Makai::Math::log10(lhs->toValue<double>()));	return true;
-			case AV2_UOP_LN:		*out = *context.art.newValue<T>(Makai::Math::log(lhs->toValue<double>()));		return true;
-			case AV2_UOP_SQRT:		*out = *context.art.newValue<T>(Makai::Math::sqrt(lhs->toValue<double>()));		return true;
-			case AV2_UOP_LENGTH:	*out = *context.art.newValue<T>(Makai::Math::abs(lhs->toValue<T>()));			return true;
+			case AV2_UOP_INCREMENT:	out.store(context.newValue<T>(lhs.toValue<T>()+1));							return true;
+			case AV2_UOP_DECREMENT:	out.store(context.newValue<T>(lhs.toValue<T>()-1));							return true;
+			case AV2_UOP_SIN:		out.store(context.newValue<T>(Makai::Math::sin(lhs.toValue<double>())));		return true;
+			case AV2_UOP_COS:		out.store(context.newValue<T>(Makai::Math::cos(lhs.toValue<double>())));		return true;
+			case AV2_UOP_TAN:		out.store(context.newValue<T>(Makai::Math::tan(lhs.toValue<double>())));		return true;
+			case AV2_UOP_ASIN:		out.store(context.newValue<T>((T)asin(lhs.toValue<T>())));					return true;
+			case AV2_UOP_ACOS:		out.store(context.newValue<T>((T)acos(lhs.toValue<T>())));					return true;
+			case AV2_UOP_ATAN:		out.store(context.newValue<T>((T)atan(lhs.toValue<T>())));					return true;
+			case AV2_UOP_SINH:		out.store(context.newValue<T>((T)sinh(lhs.toValue<T>())));					return true;
+			case AV2_UOP_COSH:		out.store(context.newValue<T>((T)cosh(lhs.toValue<T>())));					return true;
+			case AV2_UOP_TANH:		out.store(context.newValue<T>((T)tanh(lhs.toValue<T>())));					return true;
+			case AV2_UOP_LOG2:		out.store(context.newValue<T>(Makai::Math::log2(lhs.toValue<double>())));		return true;
+			case AV2_UOP_LOG10:		out.store(context.newValue<T>(Makai::Math::log10(lhs.toValue<double>())));	return true;
+			case AV2_UOP_LN:		out.store(context.newValue<T>(Makai::Math::log(lhs.toValue<double>())));		return true;
+			case AV2_UOP_SQRT:		out.store(context.newValue<T>(Makai::Math::sqrt(lhs.toValue<double>())));		return true;
+			case AV2_UOP_LENGTH:	out.store(context.newValue<T>(Makai::Math::abs(lhs.toValue<T>())));			return true;
 			default: break;
 		}
 	}
 	if constexpr (Makai::Type::Integer<T>) {
 		switch (op) {
 			using enum Operator;
-			case AV2_UOP_BIT_NOT:	*out = *context.art.newValue<T>(~lhs->toValue<Int<T>>());	return true;
+			case AV2_UOP_BIT_NOT:	out.store(context.newValue<T>(~lhs.toValue<Int<T>>()));	return true;
 			default: break;
 		}
 	}
 	if constexpr (Makai::Type::Equal<T, bool>) {
 		switch (op) {
 			using enum Operator;
-			case AV2_UOP_LOGIC_NOT:	*out = *context.art.newValue<T>(!lhs->toValue<T>());		return true;
+			case AV2_UOP_LOGIC_NOT:	out.store(context.newValue<T>(!lhs.toValue<T>()));		return true;
 			default: break;
 		}
 	}
@@ -831,20 +1135,20 @@ static bool uopIt(Object::Storage const& out, Object::Storage const& lhs, Operat
 void Engine::doUnaryOperation(Operator const op) {
 	if (context.globalValueStack.size() < 1)
 		return crash(invalidSourceError("Missing values to operate on!"));
-	auto lhs	= context.top();
+	auto& out	= context.top();
+	auto lhs	= out;
 	if (!lhs) {
 		if (!inStrictMode()) [[unlikely]] {context.pop(); context.pushEmpty();}
 		else [[likely]] crash(invalidOperationError("Operand does not exist!"));
 		return;
 	}
 	auto const _ = lhs.sync();
-	auto out	= lhs;
 	if (err) return;
 	bool success = false;
-	if (lhs->isBoolean())			success = uopIt<bool>(out, lhs, op, context);
-	else if (lhs->isUnsigned())		success = uopIt<uint64>(out, lhs, op, context);
-	else if (lhs->isSigned())		success = uopIt<int64>(out, lhs, op, context);
-	else if (lhs->isNumber())		success = uopIt<double>(out, lhs, op, context);
+	if (lhs.isBoolean())			success = uopIt<bool>(out, lhs, op, context);
+	else if (lhs.isUnsigned())		success = uopIt<uint64>(out, lhs, op, context);
+	else if (lhs.isSigned())		success = uopIt<int64>(out, lhs, op, context);
+	else if (lhs.isNumber())		success = uopIt<double>(out, lhs, op, context);
 	else if (lhs->isAlgebraic())	success = uopIt<Vector4>(out, lhs, op, context);
 	else if (lhs->isArray())		success = arrayUopIt(lhs, op, context);
 	if (!success) {
@@ -975,14 +1279,14 @@ void Engine::fastBinaryOperation(Operator const op, BasicType const type) {
 		else [[likely]] crash(invalidOperationError("Right-Side Operand does not exist!"));
 		return;
 	}
-	auto lhs	= context.top();
+	auto& lhs	= context.top();
 	auto const _l = lhs.sync();
 	if (!lhs) [[unlikely]] {
 		if (!inStrictMode()) [[unlikely]] {context.pop(); context.pushEmpty();}
 		else [[likely]] crash(invalidOperationError("Left-Side Operand does not exist!"));
 		return;
 	}
-	if (lhs->getType() != rhs->getType()) [[unlikely]] {
+	if (!lhs.hasSameTypeAs(rhs)) [[unlikely]] {
 		if (!inStrictMode()) [[unlikely]] {context.pop(); context.pushEmpty();}
 		else [[likely]] crash(invalidOperationError("Value types do not match!"));
 		return;
@@ -992,20 +1296,20 @@ void Engine::fastBinaryOperation(Operator const op, BasicType const type) {
 	switch (type) {
 		case Core::BasicType::AV2_BT_VOID:
 		case Core::BasicType::AV2_BT_NULL:		break;
-		case Core::BasicType::AV2_BT_BOOL:		fbopu<bool>(lhs->data(), rhs->data(), op);		break;
-		case Core::BasicType::AV2_BT_INT8:		fbopu<int8>(lhs->data(), rhs->data(), op);		break;
-		case Core::BasicType::AV2_BT_UINT8:		fbopu<uint8>(lhs->data(), rhs->data(), op);		break;
-		case Core::BasicType::AV2_BT_INT16:		fbopu<int16>(lhs->data(), rhs->data(), op);		break;
-		case Core::BasicType::AV2_BT_UINT16:	fbopu<uint16>(lhs->data(), rhs->data(), op);	break;
-		case Core::BasicType::AV2_BT_INT32:		fbopu<int32>(lhs->data(), rhs->data(), op);		break;
+		case Core::BasicType::AV2_BT_BOOL:		fbopu<bool>(lhs.data(), rhs.data(), op);		break;
+		case Core::BasicType::AV2_BT_INT8:		fbopu<int8>(lhs.data(), rhs.data(), op);		break;
+		case Core::BasicType::AV2_BT_UINT8:		fbopu<uint8>(lhs.data(), rhs.data(), op);		break;
+		case Core::BasicType::AV2_BT_INT16:		fbopu<int16>(lhs.data(), rhs.data(), op);		break;
+		case Core::BasicType::AV2_BT_UINT16:	fbopu<uint16>(lhs.data(), rhs.data(), op);	break;
+		case Core::BasicType::AV2_BT_INT32:		fbopu<int32>(lhs.data(), rhs.data(), op);		break;
 		case Core::BasicType::AV2_BT_CHAR:
-		case Core::BasicType::AV2_BT_UINT32:	fbopu<uint32>(lhs->data(), rhs->data(), op);	break;
-		case Core::BasicType::AV2_BT_INT64:		fbopu<int64>(lhs->data(), rhs->data(), op);		break;
-		case Core::BasicType::AV2_BT_UINT64:	fbopu<uint64>(lhs->data(), rhs->data(), op);	break;
-		case Core::BasicType::AV2_BT_REAL32:	fbopu<float32>(lhs->data(), rhs->data(), op);	break;
-		case Core::BasicType::AV2_BT_REAL64:	fbopu<float64>(lhs->data(), rhs->data(), op);	break;
-		case Core::BasicType::AV2_BT_REAL128:	fbopu<float128>(lhs->data(), rhs->data(), op);	break;
-		case Core::BasicType::AV2_BT_VECTOR:	fbopu<Vector4>(lhs->data(), rhs->data(), op);	break;
+		case Core::BasicType::AV2_BT_UINT32:	fbopu<uint32>(lhs.data(), rhs.data(), op);	break;
+		case Core::BasicType::AV2_BT_INT64:		fbopu<int64>(lhs.data(), rhs.data(), op);		break;
+		case Core::BasicType::AV2_BT_UINT64:	fbopu<uint64>(lhs.data(), rhs.data(), op);	break;
+		case Core::BasicType::AV2_BT_REAL32:	fbopu<float32>(lhs.data(), rhs.data(), op);	break;
+		case Core::BasicType::AV2_BT_REAL64:	fbopu<float64>(lhs.data(), rhs.data(), op);	break;
+		case Core::BasicType::AV2_BT_REAL128:	fbopu<float128>(lhs.data(), rhs.data(), op);	break;
+		case Core::BasicType::AV2_BT_VECTOR:	fbopu<Vector4>(lhs.data(), rhs.data(), op);	break;
 		default: {
 			if (inStrictMode()) [[likely]]
 				return crash(invalidOperationError("Invalid/Unsupported fast operator for the given values!"));
@@ -1014,7 +1318,7 @@ void Engine::fastBinaryOperation(Operator const op, BasicType const type) {
 }
 
 void Engine::immediateBinaryOperation(Operator const op, BasicType const type, pointer const rhs) {
-	auto lhs	= context.top();
+	auto& lhs	= context.top();
 	auto const _l = lhs.sync();
 	if (!lhs) [[unlikely]] {
 		if (!inStrictMode()) [[unlikely]] {context.pop(); context.pushEmpty();}
@@ -1024,20 +1328,20 @@ void Engine::immediateBinaryOperation(Operator const op, BasicType const type, p
 	switch (type) {
 		case Core::BasicType::AV2_BT_VOID:
 		case Core::BasicType::AV2_BT_NULL:		break;
-		case Core::BasicType::AV2_BT_BOOL:		fbopu<bool>(lhs->data(), rhs, op);		break;
-		case Core::BasicType::AV2_BT_INT8:		fbopu<int8>(lhs->data(), rhs, op);		break;
-		case Core::BasicType::AV2_BT_UINT8:		fbopu<uint8>(lhs->data(), rhs, op);		break;
-		case Core::BasicType::AV2_BT_INT16:		fbopu<int16>(lhs->data(), rhs, op);		break;
-		case Core::BasicType::AV2_BT_UINT16:	fbopu<uint16>(lhs->data(), rhs, op);	break;
-		case Core::BasicType::AV2_BT_INT32:		fbopu<int32>(lhs->data(), rhs, op);		break;
+		case Core::BasicType::AV2_BT_BOOL:		fbopu<bool>(lhs.data(), rhs, op);		break;
+		case Core::BasicType::AV2_BT_INT8:		fbopu<int8>(lhs.data(), rhs, op);		break;
+		case Core::BasicType::AV2_BT_UINT8:		fbopu<uint8>(lhs.data(), rhs, op);		break;
+		case Core::BasicType::AV2_BT_INT16:		fbopu<int16>(lhs.data(), rhs, op);		break;
+		case Core::BasicType::AV2_BT_UINT16:	fbopu<uint16>(lhs.data(), rhs, op);	break;
+		case Core::BasicType::AV2_BT_INT32:		fbopu<int32>(lhs.data(), rhs, op);		break;
 		case Core::BasicType::AV2_BT_CHAR:
-		case Core::BasicType::AV2_BT_UINT32:	fbopu<uint32>(lhs->data(), rhs, op);	break;
-		case Core::BasicType::AV2_BT_INT64:		fbopu<int64>(lhs->data(), rhs, op);		break;
-		case Core::BasicType::AV2_BT_UINT64:	fbopu<uint64>(lhs->data(), rhs, op);	break;
-		case Core::BasicType::AV2_BT_REAL32:	fbopu<float32>(lhs->data(), rhs, op);	break;
-		case Core::BasicType::AV2_BT_REAL64:	fbopu<float64>(lhs->data(), rhs, op);	break;
-		case Core::BasicType::AV2_BT_REAL128:	fbopu<float128>(lhs->data(), rhs, op);	break;
-		case Core::BasicType::AV2_BT_VECTOR:	fbopu<Vector4>(lhs->data(), rhs, op);	break;
+		case Core::BasicType::AV2_BT_UINT32:	fbopu<uint32>(lhs.data(), rhs, op);	break;
+		case Core::BasicType::AV2_BT_INT64:		fbopu<int64>(lhs.data(), rhs, op);		break;
+		case Core::BasicType::AV2_BT_UINT64:	fbopu<uint64>(lhs.data(), rhs, op);	break;
+		case Core::BasicType::AV2_BT_REAL32:	fbopu<float32>(lhs.data(), rhs, op);	break;
+		case Core::BasicType::AV2_BT_REAL64:	fbopu<float64>(lhs.data(), rhs, op);	break;
+		case Core::BasicType::AV2_BT_REAL128:	fbopu<float128>(lhs.data(), rhs, op);	break;
+		case Core::BasicType::AV2_BT_VECTOR:	fbopu<Vector4>(lhs.data(), rhs, op);	break;
 		default: {
 			if (inStrictMode()) [[likely]]
 				return crash(invalidOperationError("Invalid/Unsupported fast operator for the given values!"));
@@ -1048,7 +1352,7 @@ void Engine::immediateBinaryOperation(Operator const op, BasicType const type, p
 void Engine::fastUnaryOperation(Operator const op, BasicType const type) {
 	if (context.globalValueStack.size() < 2)
 		return crash(invalidSourceError("Missing values to operate on!"));
-	auto val	= context.top();
+	auto& val	= context.top();
 	if (!val) {
 		if (!inStrictMode()) [[unlikely]] {context.pop(); context.pushEmpty();}
 		else [[likely]] crash(invalidOperationError("Operand does not exist!"));
@@ -1058,21 +1362,21 @@ void Engine::fastUnaryOperation(Operator const op, BasicType const type) {
 	switch (type) {
 		case Core::BasicType::AV2_BT_VOID:
 		case Core::BasicType::AV2_BT_NULL:		break;
-		case Core::BasicType::AV2_BT_BOOL:		fuopu<bool>(val->data(), op);	break;
-		case Core::BasicType::AV2_BT_INT8:		fuopu<int8>(val->data(), op);	break;
-		case Core::BasicType::AV2_BT_UINT8:		fuopu<uint8>(val->data(), op);	break;
-		case Core::BasicType::AV2_BT_INT16:		fuopu<int16>(val->data(), op);	break;
-		case Core::BasicType::AV2_BT_UINT16:	fuopu<uint16>(val->data(), op);	break;
-		case Core::BasicType::AV2_BT_INT32:		fuopu<int32>(val->data(), op);	break;
+		case Core::BasicType::AV2_BT_BOOL:		fuopu<bool>(val.data(), op);	break;
+		case Core::BasicType::AV2_BT_INT8:		fuopu<int8>(val.data(), op);	break;
+		case Core::BasicType::AV2_BT_UINT8:		fuopu<uint8>(val.data(), op);	break;
+		case Core::BasicType::AV2_BT_INT16:		fuopu<int16>(val.data(), op);	break;
+		case Core::BasicType::AV2_BT_UINT16:	fuopu<uint16>(val.data(), op);	break;
+		case Core::BasicType::AV2_BT_INT32:		fuopu<int32>(val.data(), op);	break;
 		case Core::BasicType::AV2_BT_CHAR:
-		case Core::BasicType::AV2_BT_UINT32:	fuopu<uint32>(val->data(), op);		break;
-		case Core::BasicType::AV2_BT_INT64:		fuopu<int64>(val->data(), op);		break;
-		case Core::BasicType::AV2_BT_UINT64:	fuopu<uint64>(val->data(), op);		break;
-		case Core::BasicType::AV2_BT_REAL32:	fuopu<float32>(val->data(), op);	break;
-		case Core::BasicType::AV2_BT_REAL64:	fuopu<float64>(val->data(), op);	break;
-		case Core::BasicType::AV2_BT_REAL128:	fuopu<float128>(val->data(), op);	break;
-		case Core::BasicType::AV2_BT_VECTOR:	fuopu<Vector4>(val->data(), op);	break;
-		case Core::BasicType::AV2_BT_MATRIX:	fuopu<Matrix4x4>(val->data(), op);	break;
+		case Core::BasicType::AV2_BT_UINT32:	fuopu<uint32>(val.data(), op);		break;
+		case Core::BasicType::AV2_BT_INT64:		fuopu<int64>(val.data(), op);		break;
+		case Core::BasicType::AV2_BT_UINT64:	fuopu<uint64>(val.data(), op);		break;
+		case Core::BasicType::AV2_BT_REAL32:	fuopu<float32>(val.data(), op);	break;
+		case Core::BasicType::AV2_BT_REAL64:	fuopu<float64>(val.data(), op);	break;
+		case Core::BasicType::AV2_BT_REAL128:	fuopu<float128>(val.data(), op);	break;
+		case Core::BasicType::AV2_BT_VECTOR:	fuopu<Vector4>(val.data(), op);	break;
+		case Core::BasicType::AV2_BT_MATRIX:	fuopu<Matrix4x4>(val.data(), op);	break;
 		default: {
 			if (inStrictMode())
 				return crash(invalidOperationError("Invalid/Unsupported fast operator for the given values!"));
@@ -1084,14 +1388,14 @@ void Engine::shortCircuitOperation(Operator const op, usize count) {
 	auto lhs = context.top();
 	auto const _l = lhs.sync();
 	switch (op) {
-		case Operator::AV2_BOP_LOGIC_AND: if (!lhs->toValue<bool>()) {
+		case Operator::AV2_BOP_LOGIC_AND: if (!lhs.toValue<bool>()) {
 			context.globalValueStack.eraseRange(-(count+1), -1);
-			*context.top() = *context.newValue(false);
+			context.top().store(context.newValue(false));
 			return;
 		}
-		case Operator::AV2_BOP_LOGIC_OR: if (lhs->toValue<bool>()) {
+		case Operator::AV2_BOP_LOGIC_OR: if (lhs.toValue<bool>()) {
 			context.globalValueStack.eraseRange(-(count+1), -1);
-			*context.top() = *context.newValue(true);
+			context.top().store(context.newValue(true));
 			return;
 		}
 		default: break;
@@ -1101,14 +1405,14 @@ void Engine::shortCircuitOperation(Operator const op, usize count) {
 		auto lhs = context.top();
 		auto const _r = lhs.sync();
 		switch (op) {
-			case Operator::AV2_BOP_LOGIC_AND: if (!lhs->toValue<bool>()) {
+			case Operator::AV2_BOP_LOGIC_AND: if (!lhs.toValue<bool>()) {
 				context.globalValueStack.eraseRange(-(count+1), -1);
-				*context.top() = *context.newValue(false);
+				context.top().store(context.newValue(false));
 				return;
 			}
-			case Operator::AV2_BOP_LOGIC_OR: if (lhs->toValue<bool>()) {
+			case Operator::AV2_BOP_LOGIC_OR: if (lhs.toValue<bool>()) {
 				context.globalValueStack.eraseRange(-(count+1), -1);
-				*context.top() = *context.newValue(true);
+				context.top().store(context.newValue(true));
 				return;
 			}
 			default: break;
@@ -1121,14 +1425,14 @@ void Engine::fastShortCircuitOperation(Operator const op, BasicType const type,
 	auto lhs = context.top();
 	auto const _l = lhs.sync();
 	switch (op) {
-		case Operator::AV2_BOP_LOGIC_AND: if (!*(bool*)lhs->data()) {
+		case Operator::AV2_BOP_LOGIC_AND: if (!*(bool*)lhs.data()) {
 			context.globalValueStack.eraseRange(-(count+1), -1);
-			*context.top() = *context.newValue(false);
+			context.top().store(context.newValue(false));
 			return;
 		}
-		case Operator::AV2_BOP_LOGIC_OR: if (*(bool*)lhs->data()) {
+		case Operator::AV2_BOP_LOGIC_OR: if (*(bool*)lhs.data()) {
 			context.globalValueStack.eraseRange(-(count+1), -1);
-			*context.top() = *context.newValue(true);
+			context.top().store(context.newValue(true));
 			return;
 		}
 		default: break;
@@ -1138,14 +1442,14 @@ void Engine::fastShortCircuitOperation(Operator const op, BasicType const type,
 		auto lhs = context.top();
 		auto const _r = lhs.sync();
 		switch (op) {
-			case Operator::AV2_BOP_LOGIC_AND: if (!*(bool*)lhs->data()) {
+			case Operator::AV2_BOP_LOGIC_AND: if (!*(bool*)lhs.data()) {
 				context.globalValueStack.eraseRange(-(count+1), -1);
-				*context.top() = *context.newValue(false);
+				context.top().store(context.newValue(false));
 				return;
 			}
-			case Operator::AV2_BOP_LOGIC_OR: if (*(bool*)lhs->data()) {
+			case Operator::AV2_BOP_LOGIC_OR: if (*(bool*)lhs.data()) {
 				context.globalValueStack.eraseRange(-(count+1), -1);
-				*context.top() = *context.newValue(true);
+				context.top().store(context.newValue(true));
 				return;
 			}
 			default: break;
@@ -1165,7 +1469,7 @@ void Engine::v2Op() {
 		)
 	) [[unlikely]] {
 		if (op.immediate)
-			context.push(program.strings[Makai::bitcast<uint64>(current) % program.strings.size()]);
+			context.push(stringConstant(Makai::bitcast<uint64>(current) % program->strings.size()));
 		if (op.op < Operator::AV2_BOP_START)
 			return doUnaryOperation(op.op);
 		else return doBinaryOperation(op.op);
@@ -1209,7 +1513,7 @@ void Engine::v2Op() {
 void Engine::v2Compare() {
 	StackStateScopePrinter s3p{context};
 	Instruction::Comparison comp = bitcast<Instruction::Comparison>(current.type);
-	if (context.globalValueStack.size() < 2)
+	if (context.globalValueStack.size() < (comp.immediate ? 1 : 2))
 		return crash(invalidSourceError("Missing values to compare!"));
 	if (comp.immediate)
 		advance(true);
@@ -1220,27 +1524,27 @@ void Engine::v2Compare() {
 		)
 	) [[unlikely]] {
 		if (comp.immediate)
-			context.push(program.strings[Makai::bitcast<uint64>(current) % program.strings.size()]);
+			context.push(stringConstant(Makai::bitcast<uint64>(current) % program->strings.size()));
 		comp.sameType = false;
 	} else if (comp.immediate) {
-		auto lhs = context.top();
+		auto& lhs = context.top();
 		uint64 val = bitcast<uint64>(current);
-		*lhs = *context.newValue(doImmediateCompare(lhs, val, comp.assume, comp.comp));
+		lhs.store(context.newValue(doImmediateCompare(lhs, val, comp.assume, comp.comp)));
 		return;
 	}
 	auto rhs	= context.pop();
-	auto lhs	= context.top();
+	auto& lhs	= context.top();
 	auto const _l = lhs.sync(), _r = rhs.sync();
 	if (comp.sameType) {
-		*rhs = *context.newValue(doFastCompare(lhs, rhs, comp.assume, comp.comp));
+		lhs.store(context.newValue(doFastCompare(lhs, rhs, comp.assume, comp.comp)));
 		return;
 	}
 	Makai::Ordered::OrderType order = Makai::Ordered::Order::EQUAL;
-	if (lhs->isBoolean() && rhs->isBoolean())				order = lhs->toValue<bool>() <=> rhs->toValue<bool>();
-	else if (lhs->isUnsigned() && rhs->isUnsigned())		order = lhs->toValue<uint64>() <=> rhs->toValue<uint64>();
-	else if (lhs->isInteger() && rhs->isInteger())			order = lhs->toValue<int64>() <=> rhs->toValue<int64>();
-	else if (lhs->isNumber() && rhs->isNumber())			order = lhs->toValue<double>() <=> rhs->toValue<double>();
-	else if (lhs->isVectorable() && rhs->isVectorable())	order = lhs->toValue<Vector4>() <=> rhs->toValue<Vector4>();
+	if (lhs.isBoolean() && rhs.isBoolean())					order = lhs.toValue<bool>() <=> rhs.toValue<bool>();
+	else if (lhs.isUnsigned() && rhs.isUnsigned())			order = lhs.toValue<uint64>() <=> rhs.toValue<uint64>();
+	else if (lhs.isInteger() && rhs.isInteger())			order = lhs.toValue<int64>() <=> rhs.toValue<int64>();
+	else if (lhs.isNumber() && rhs.isNumber())				order = lhs.toValue<double>() <=> rhs.toValue<double>();
+	else if (lhs.isVectorable() && rhs.isVectorable())		order = lhs.toValue<Vector4>() <=> rhs.toValue<Vector4>();
 	else if (
 		lhs->getCurrentType() == rhs->getCurrentType()
 	||	lhs->getCurrentType()->canBecome(rhs->getCurrentType())
@@ -1259,21 +1563,21 @@ void Engine::v2Compare() {
 			return;
 		}
 	}
-	MAKAILIB_DEBUGLN_FULL("Left: ", lhs->toValue<int64>());
-	MAKAILIB_DEBUGLN_FULL("Right: ", rhs->toValue<int64>());
+	MAKAILIB_DEBUGLN_FULL("Left: ", lhs.toValue<int64>());
+	MAKAILIB_DEBUGLN_FULL("Right: ", rhs.toValue<int64>());
 	MAKAILIB_DEBUGLN_FULL("Order = ", Cast::as<int16>(order.order()));
 	switch (comp.comp) {
 		using enum Core::Comparator;
 		case AV2_OP_THREEWAY:
-			*context.top() = *context.art.newValue(Cast::as<int8>(order.order()));
+			context.top().store(context.newValue(Cast::as<int8>(order.order())));
 		break;
 		using enum Makai::StandardOrder;
-		case AV2_OP_EQUALS:			*context.top() = *context.art.newValue(order == EQUAL);		break;
-		case AV2_OP_NOT_EQUALS:		*context.top() = *context.art.newValue(order != EQUAL);		break;
-		case AV2_OP_GREATER_THAN:	*context.top() = *context.art.newValue(order == GREATER);	break;
-		case AV2_OP_GREATER_EQUALS:	*context.top() = *context.art.newValue(order != LESS);		break;
-		case AV2_OP_LESS_THAN:		*context.top() = *context.art.newValue(order == LESS);		break;
-		case AV2_OP_LESS_EQUALS:	*context.top() = *context.art.newValue(order != GREATER);	break;
+		case AV2_OP_EQUALS:			context.top().store(context.newValue(order == EQUAL));		break;
+		case AV2_OP_NOT_EQUALS:		context.top().store(context.newValue(order != EQUAL));		break;
+		case AV2_OP_GREATER_THAN:	context.top().store(context.newValue(order == GREATER));	break;
+		case AV2_OP_GREATER_EQUALS:	context.top().store(context.newValue(order != LESS));		break;
+		case AV2_OP_LESS_THAN:		context.top().store(context.newValue(order == LESS));		break;
+		case AV2_OP_LESS_EQUALS:	context.top().store(context.newValue(order != GREATER));	break;
 	}
 	MAKAILIB_DEBUGLN_FULL("Result: ", context.top()->toValue<int64>());
 }
@@ -1297,6 +1601,7 @@ bool Engine::finished() const {
 
 void Engine::reset() {
 	terminate();
+	detach();
 	unload();
 	context		= {};
 	current		= {};
@@ -1306,28 +1611,47 @@ void Engine::reset() {
 }
 
 void Engine::load(Module const& prog) {
-	reset();
 	if (!(
 		prog.type == decltype(prog.type)::AV2_CMT_EXE
 	or	prog.type == decltype(prog.type)::AV2_CMT_CLI_EXE
+	)) return reset();
+	load(Program::create(prog));
+}
+
+void Engine::load(Program const& prog) {
+	reset();
+	if (!prog) return;
+	auto const& module = *prog;
+	if (!(
+		module.type == decltype(module.type)::AV2_CMT_EXE
+	or	module.type == decltype(module.type)::AV2_CMT_CLI_EXE
 	)) return;
-	program = prog;
+	loaded	= prog;
+	program	= &module;
+	decode();
 }
 
 void Engine::execute() {
 	if (running()) return;
+	Core::Pool::Scope const scope(*context.art.pool);
 	engineState = State::AV2_RES_INITIALIZING;
+	if (profiler) profiler->begin();
 	load();
 }
 
 void Engine::load() {
 	if (engineState != State::AV2_RES_INITIALIZING) return;
-	if (program.code.empty())
+	if (!program || program->code.empty())
 		return crash(makeErrorHere("Module has no code!"));
+	// Global IDs are string table indices, so every global the program names gets a slot up front
+	context.globals = List<Context::Storage>(program->strings.size(), nullptr);
+	strings.clear();
+	for (auto const& str: program->strings)
+		strings.pushBack(context.art.intern(str));
 	Map<uint64, uint64> inheritances;
 	Map<uint64, uint64> boundTypes;
 	Map<uint64, List<uint64>> fields;
-	for (auto const& [type, i]: Range::expand(program.detail.types)) {
+	for (auto const& [type, i]: Range::expand(program->detail.types)) {
 		if (type.flags.isProxy && !(type.flags.isBasic)) {
 			boundTypes[i] = type.hash;
 			context.art.types.values.pushBack(nullptr);
@@ -1346,6 +1670,13 @@ void Engine::load() {
 			Definition::makeBasic(*dt);
 		context.art.types.addElement(dt);
 	}
+	// Views come from the host, so no program declares their type
+	if (context.art.types.byNameHash(Core::HostView::ART_HASH).empty()) {
+		AtomicCell<Core::Definition> view = view.create();
+		Core::HostView::makeDefinition(*view);
+		view->id = context.art.types.values.size();
+		context.art.types.addElement(view);
+	}
 	for (auto const& [self, artEquiv]: boundTypes) {
 		auto const types = context.art.types.byNameHash(artEquiv);
 		if (types.size())
@@ -1363,28 +1694,43 @@ void Engine::load() {
 		)));
 	for (auto const& [self, base]: inheritances)
 		context.art.types.values[self]->base = context.art.types.values[base];
-	if (context.art.types.values.size() < program.detail.types.size())
+	// Element sizes are only known once basic types are
+	for (auto const& type: context.art.types.values)
+		if (type->flags.isArray && type->flags.isValueType)
+			Definition::makePacked(*type);
+	if (context.art.types.values.size() < program->detail.types.size())
 		return crash(makeErrorHere(toString(
 			"Program has missing types [",
 			context.art.types.values.size(),
 			" < ",
-			program.detail.types.size(),
+			program->detail.types.size(),
 			"]!"
 		)));
 	for (auto const& [self, fields]: fields)
 		for (auto const& field: fields)
 			context.art.types.values[self]->fields.pushBack(context.art.types.values[field]);
-	if (program.entry != Limit::MAX<uint64>) jumpByTableIndex(program.entry, false /*not returnable*/);
+	context.art.resetBasicDefinitions();
+	if (program->entry != Limit::MAX<uint64>) jumpByTableIndex(program->entry, false /*not returnable*/);
 	else return crash(makeErrorHere("Missing entrypoint!"));
 	if (config.allowDynamicLibraries) {
 		MAKAILIB_DEBUGLN_FULL("<dynlib-open>");
-		if (program.ani && loader)
-			for (auto& lib: program.ani->shared.libraries)
+		if (program->ani && loader)
+			for (auto& lib: program->ani->shared.libraries)
 				loader->loadLibrary(context, lib + ".andl");
+		if (config.precompiled.size() && loader)
+			loader->loadLibrary(context, config.precompiled);
 		MAKAILIB_DEBUGLN_FULL("</dynlib-open>");
 		MAKAILIB_DEBUGLN_FULL("<dynlib-load>");
 		context.art.loadLibraries();
 		MAKAILIB_DEBUGLN_FULL("</dynlib-load>");
+		if (config.precompiled.size()) {
+			auto const fingerprint = program->fingerprint();
+			for (auto const lib: context.art.libraries())
+				if (auto const code = lib->precompiled(); code && code->fingerprint == fingerprint) {
+					attach(*code);
+					break;
+				}
+		}
 	}
 	MAKAILIB_DEBUGLN_FULL("Finishing loading step...");
 	onLoad();
@@ -1401,6 +1747,27 @@ void Engine::unload() {
 	context.art.unloadLibraries();
 }
 
+void Engine::attach(Precompiled const& code) {
+	// Compiled code skips the dispatch loop, so it would go unaccounted for
+	if (profiler) return;
+	MAKAILIB_DEBUGLN_FULL("Using precompiled code (", code.sections.size(), " sections)");
+	jit.unbind();
+	auto const size = program->code.size();
+	for (auto const& section: code.sections)
+		for (usize i = section.start; i < section.end && i < size; ++i)
+			if (decoded[i].next == i)
+				decoded[i].native = bitcast<pointer>(section.function);
+	precompiled = &code;
+}
+
+void Engine::detach() {
+	// The code lives in a library, which is about to be closed
+	if (!precompiled) return;
+	for (auto& op: decoded)
+		op.native = nullptr;
+	precompiled = nullptr;
+}
+
 void Engine::v2SetContext() {
 	auto const ctx = Cast::bit<Instruction::Context>(current.type);
 	if (!ctx.immediate)
@@ -1445,7 +1812,7 @@ void Engine::v2StackClear() {
 			if (stack.size() && clear.count == 1)
 				context.globalValueStack.popBack();
 			else if (clear.count < stack.size())
-				context.globalValueStack.eraseRange(-offset, -1);
+				context.globalValueStack.eraseRange(-clear.count, stack.size());
 			else context.globalValueStack.clear();
 		} else {
 			if (stack.size() && clear.count == 1)
@@ -1462,6 +1829,16 @@ void Engine::v2StackFlush() {
 	context.globalValueStack.clear();
 }
 
+static Runtime::Context::Locals shared(Runtime::Context::Locals values) {
+	for (auto& value: values)
+		value.box();
+	return values;
+}
+
+static bool holdsValue(Runtime::Context::Storage const& value) {
+	return value.unboxed() || (value.exists() && value->exists());
+}
+
 void Engine::v2Jump() {
 	Instruction::Leap leap = current.getTypeAs<Instruction::Leap>();
 	using enum Instruction::Leap::Type;
@@ -1483,19 +1860,23 @@ void Engine::v2Jump() {
 		auto const cond = context.pop();
 		auto const _c = cond.sync();
 		switch (leap.type) {
-			case AV2_ILT_IF_TRUTHY:			shouldJump	= cond->toValue<bool>();				break;
-			case AV2_ILT_IF_FALSY:			shouldJump	= !cond->toValue<bool>();				break;
-			case AV2_ILT_IF_ZERO:			shouldJump	= cond->toValue<double>() == 0;			break;
-			case AV2_ILT_IF_NOT_ZERO:		shouldJump	= cond->toValue<double>() != 0;			break;
-			case AV2_ILT_IF_NEGATIVE:		shouldJump	= cond->toValue<double>() < 0;			break;
-			case AV2_ILT_IF_POSITIVE:		shouldJump	= cond->toValue<double>() > 0;			break;
-			case AV2_ILT_IF_NULL_OR_VOID:	shouldJump	= !(cond.exists() && cond->exists());	break;
-			case AV2_ILT_IF_EXISTS:			shouldJump	= cond.exists() && cond->exists();		break;
+			case AV2_ILT_IF_TRUTHY:			shouldJump	= cond.toValue<bool>();				break;
+			case AV2_ILT_IF_FALSY:			shouldJump	= !cond.toValue<bool>();				break;
+			case AV2_ILT_IF_ZERO:			shouldJump	= cond.toValue<double>() == 0;			break;
+			case AV2_ILT_IF_NOT_ZERO:		shouldJump	= cond.toValue<double>() != 0;			break;
+			case AV2_ILT_IF_NEGATIVE:		shouldJump	= cond.toValue<double>() < 0;			break;
+			case AV2_ILT_IF_POSITIVE:		shouldJump	= cond.toValue<double>() > 0;			break;
+			case AV2_ILT_IF_NULL_OR_VOID:	shouldJump	= !holdsValue(cond);					break;
+			case AV2_ILT_IF_EXISTS:			shouldJump	= holdsValue(cond);						break;
 			default: break;
 		}
 	}
-	if (shouldJump != leap.invert)
-		jumpByMode(leap.mode, loc, false /*not returnable*/);
+	if (shouldJump == leap.invert) return;
+	if (auto const to = resolvedTarget(); !leap.dyn && to != NO_TARGET) {
+		// Backward jumps close loops
+		if (jit && to < context.pointers.instruction) jit->heat(to);
+		jumpTo(to, false /*not returnable*/);
+	} else jumpByMode(leap.mode, loc, false /*not returnable*/);
 }
 
 Engine::Error Engine::invalidLocationError(ValueLocation const& loc) {
@@ -1522,8 +1903,8 @@ void Engine::v2ScopeBring() {
 	auto const count = Makai::Cast::bit<uint64>(current);
 	if (!(scope < context.scopeStack.size()))
 		return crash(outOfRangeError("Requested scope is out-of-range!"));
-	auto& src = context.scopeStack[-scope]->localStack;
-	auto& dst = context.locals();
+	auto src = shared(context.localsOf(scope ? context.scopeStack.size() - scope : 0));
+	auto dst = context.locals();
 	if (!((bind.src + count) < src.size()))
 		return crash(outOfRangeError("Requested source start + count is bigger than its stack size!"));
 	if (!((bind.dst + count) < dst.size()))
@@ -1538,14 +1919,14 @@ void Engine::v2ScopeBind() {
 	advance(true);
 	auto const count = Makai::Cast::bit<uint64>(current);
 	auto& src = context.globalValueStack;
-	auto& dst = context.locals();
+	auto dst = context.locals();
 	if ((bind.src + count) > src.size())
 		return crash(outOfRangeError("Requested global stack range falls outside its size!"));
 	if ((bind.dst + count) > dst.size())
 		return crash(outOfRangeError("Requested destination range falls outside its size!"));
 	MAKAILIB_DEBUGLN_FULL("Binding values...");
 	for (usize i = 0; i < count; ++i) {
-		auto const si = (src.size() - count - bind.src);
+		auto const si = (src.size() - count - bind.src + i);
 		auto const di = i + bind.dst;
 		auto const v = src[si];
 		MAKAILIB_DEBUG_FULL("> [", si, " -> ", di, "]", ": ");
@@ -1555,39 +1936,104 @@ void Engine::v2ScopeBind() {
 }
 
 void Engine::v2ScopeEnter() {
-	auto const count = current.type;
-	context.scopeStack.pushBack(
-		AtomicCell<Context::Scope>::create(
-			Context::Scope{
-				.mode			= context.scope().mode,
-				.prevMode		= context.scope().mode,
-				.pointerFrame	= context.pointerStack.size()
-			}
-		)
-	);
-	if (count == Cast::as<decltype(count)>(-1))
-		context.locals() = context.scopeStack[-2]->localStack;
-	else if (count) context.locals().resize(count, nullptr);
+	auto const count	= current.type;
+	auto const parent	= context.locals();
+	context.enterScope({
+		.mode			= context.scope().mode,
+		.prevMode		= context.scope().mode,
+		.pointerFrame	= context.pointerStack.size()
+	});
+	if (count == Cast::as<decltype(count)>(-1)) {
+		shared(parent);
+		// Adding locals can move the parent's around, so they get copied by position
+		auto const start = parent.data() - context.frameStack.data();
+		for (usize i = 0; i < parent.size(); ++i) {
+			auto const value = context.frameStack[start + i];
+			context.addLocal(value);
+		}
+	} else if (count) context.addLocals(count);
 }
 
 void Engine::v2ScopeExit() {
 	if (context.scopeStack.size())
-		context.scopeStack.popBack();
+		context.exitScope();
+}
+
+static bool isView(Object const& object) {
+	auto const type = object.getType();
+	return type && type->hash == Core::HostView::ART_HASH;
+}
+
+static Runtime::Context::Storage viewElement(Runtime::Context& context, BasicType const type, ref<void const> const element) {
+	if (type == BasicType::AV2_BT_MATRIX)
+		return context.newValue(*static_cast<ref<Makai::Matrix4x4 const>>(element));
+	if (auto const def = context.art.basicDefinition(type))
+		return Runtime::Context::Storage(element, *def, type);
+	return nullptr;
+}
+
+template <class T>
+static bool storeViewElement(pointer const element, Runtime::Context::Storage const& value) {
+	if constexpr (Makai::Type::Equal<T, Makai::Vector4>) {
+		if (!value.isVectorable()) return false;
+	} else if constexpr (Makai::Type::Equal<T, Makai::Matrix4x4>) {
+		if (!value->isMatrix()) return false;
+	} else if (!(value.isNumber() || value.isBoolean())) return false;
+	*static_cast<ref<T>>(element) = value.toValue<T>();
+	return true;
+}
+
+static bool storeViewElement(BasicType const type, pointer const element, Runtime::Context::Storage const& value) {
+	if (!value) return false;
+	switch (type) {
+		using enum BasicType;
+		case AV2_BT_BOOL:	return storeViewElement<bool>(element, value);
+		case AV2_BT_INT8:	return storeViewElement<int8>(element, value);
+		case AV2_BT_UINT8:	return storeViewElement<uint8>(element, value);
+		case AV2_BT_INT16:	return storeViewElement<int16>(element, value);
+		case AV2_BT_UINT16:	return storeViewElement<uint16>(element, value);
+		case AV2_BT_INT32:	return storeViewElement<int32>(element, value);
+		case AV2_BT_UINT32:	return storeViewElement<uint32>(element, value);
+		case AV2_BT_INT64:	return storeViewElement<int64>(element, value);
+		case AV2_BT_UINT64:	return storeViewElement<uint64>(element, value);
+		case AV2_BT_REAL32:	return storeViewElement<float32>(element, value);
+		case AV2_BT_REAL64:	return storeViewElement<float64>(element, value);
+		case AV2_BT_VECTOR:	return storeViewElement<Makai::Vector4>(element, value);
+		case AV2_BT_MATRIX:	return storeViewElement<Makai::Matrix4x4>(element, value);
+		default:			return false;
+	}
 }
 
 void Engine::v2FieldGet() {
+	auto const site = context.pointers.instruction;
 	Instruction::Field field = current.getTypeAs<Instruction::Field>();
 	uint64 loc = 0;
 	if (field.dynamic) {
 		if (context.globalValueStack.empty())
 			return crash(invalidSourceError("Global stack is empty!"));
-		context.pop().perform([&] (auto const& obj) {loc = obj.template toValue<uint64>();});
+		if (auto const v = context.pop()) loc = v.toValue<uint64>();
 	} else {
 		advance(true);
 		loc = Makai::Cast::bit<uint64>(current);
 	}
 	if (!context.top())
 		return crash(invalidSourceError("Value does not exist!"));
+	if (auto const access = fieldAccess(site, context.top(), loc))
+		if (auto const v = context.top()->getAtIndex(*access, loc)) {
+			context.pop();
+			context.push(v);
+			return;
+		}
+	// Views read straight from the host's memory
+	if (isView(*context.top())) {
+		auto const view		= Core::HostView::construct(*context.top());
+		auto const element	= view.at(loc);
+		if (!element)
+			return crash(outOfRangeError("Index is out of the view's bounds, or its lifetime has ended!"));
+		context.pop();
+		context.push(viewElement(context, view.elementType(), element));
+		return;
+	}
 	if (!context.top()->canHaveFields())
 		return crash(invalidSourceError("Value is not an array or structure!"));
 	auto const src = context.pop();
@@ -1612,13 +2058,14 @@ void Engine::v2FieldGet() {
 }
 
 void Engine::v2FieldSet() {
+	auto const site = context.pointers.instruction;
 	Instruction::Field field = current.getTypeAs<Instruction::Field>();
 	auto const v = context.pop();
 	uint64 loc = 0;
 	if (field.dynamic) {
 		if (context.globalValueStack.empty())
 			return crash(invalidSourceError("Global stack is empty!"));
-		context.pop().perform([&] (auto const& obj) {loc = obj.template toValue<uint64>();});
+		if (auto const v = context.pop()) loc = v.toValue<uint64>();
 	} else {
 		advance(true);
 		loc = Makai::Cast::bit<uint64>(current);
@@ -1629,6 +2076,23 @@ void Engine::v2FieldSet() {
 	MAKAILIB_DEBUGLN_FULL("Field: ", loc);
 	if (!dst)
 		return crash(invalidSourceError("Value does not exist!"));
+	if (auto const access = fieldAccess(site, dst, loc)) {
+		auto const _s = dst.sync();
+		if (dst->setAtIndex(*access, loc, v)) {
+			context.push(v);
+			return;
+		}
+	}
+	if (isView(*dst)) {
+		auto const view		= Core::HostView::construct(*dst);
+		auto const element	= view.at(loc);
+		if (!element)
+			return crash(outOfRangeError("Index is out of the view's bounds, or its lifetime has ended!"));
+		if (!storeViewElement(view.elementType(), element, v))
+			return crash(invalidSourceError("Value does not fit the view's elements!"));
+		context.push(v);
+		return;
+	}
 	if (!dst->canHaveFields())
 		return crash(invalidSourceError("Value is not an array or structure!"));
 	MAKAILIB_DEBUGLN_FULL("Field Count: ", dst->count());
@@ -1650,6 +2114,11 @@ void Engine::v2FieldSet() {
 void Engine::v2Sizeof() {
 	auto const val = context.pop();
 	if (!val) return crash(invalidSourceError("Value does not exist!"));
+	if (isView(*val)) {
+		auto const view = Core::HostView::construct(*val);
+		context.push(current.type ? view.size() * view.stride() : view.size());
+		return;
+	}
 	auto const sz = val->count();
 	if (sz == Makai::Limit::MAX<usize>)
 		return crash(invalidSourceError("Value type does not exist!"));
@@ -1669,11 +2138,11 @@ void Engine::v2Random() {
 	if (rng.setSeed) {
 		auto const val = context.pop();
 		auto const _ = val.sync();
-		prng.setSeed(val->toValue<uint64>());
+		prng.setSeed(val.toValue<uint64>());
 	}
 	if (val) context.push(*val);
 	if (!(rng.setSeed || rng.getSeed)) {
-		Object::Storage lo, hi;
+		Context::Storage lo, hi;
 		if (rng.bounded) {
 			hi = context.pop();
 			lo = context.pop();
@@ -1682,14 +2151,14 @@ void Engine::v2Random() {
 		auto const _2 = hi.sync();
 		if (rng.secure) switch (rng.type) {
 			using enum Instruction::Randomness::Type;
-			case AV2_IRT_INT:	context.push(rng.bounded ? srng.number<int64>(lo->toValue<int64>(), hi->toValue<int64>()) : srng.number<int64>());		break;
-			case AV2_IRT_UINT:	context.push(rng.bounded ? srng.number<uint64>(lo->toValue<uint64>(), hi->toValue<uint64>()) : srng.number<uint64>());	break;
-			case AV2_IRT_REAL:	context.push(rng.bounded ? srng.number<double>(lo->toValue<double>(), hi->toValue<double>()) : srng.number<double>());	break;
+			case AV2_IRT_INT:	context.push(rng.bounded ? srng.number<int64>(lo.toValue<int64>(), hi.toValue<int64>()) : srng.number<int64>());		break;
+			case AV2_IRT_UINT:	context.push(rng.bounded ? srng.number<uint64>(lo.toValue<uint64>(), hi.toValue<uint64>()) : srng.number<uint64>());	break;
+			case AV2_IRT_REAL:	context.push(rng.bounded ? srng.number<double>(lo.toValue<double>(), hi.toValue<double>()) : srng.number<double>());	break;
 		} else switch (rng.type) {
 			using enum Instruction::Randomness::Type;
-			case AV2_IRT_INT:	context.push(rng.bounded ? prng.number<int64>(lo->toValue<int64>(), hi->toValue<int64>()) : prng.number<int64>());		break;
-			case AV2_IRT_UINT:	context.push(rng.bounded ? prng.number<uint64>(lo->toValue<uint64>(), hi->toValue<uint64>()) : prng.number<uint64>());	break;
-			case AV2_IRT_REAL:	context.push(rng.bounded ? prng.number<double>(lo->toValue<double>(), hi->toValue<double>()) : prng.number<double>());	break;
+			case AV2_IRT_INT:	context.push(rng.bounded ? prng.number<int64>(lo.toValue<int64>(), hi.toValue<int64>()) : prng.number<int64>());		break;
+			case AV2_IRT_UINT:	context.push(rng.bounded ? prng.number<uint64>(lo.toValue<uint64>(), hi.toValue<uint64>()) : prng.number<uint64>());	break;
+			case AV2_IRT_REAL:	context.push(rng.bounded ? prng.number<double>(lo.toValue<double>(), hi.toValue<double>()) : prng.number<double>());	break;
 		}
 	}
 }
@@ -1697,15 +2166,16 @@ void Engine::v2Random() {
 void Engine::v2StackBlit() {
 	StackStateScopePrinter s3p{context};
 	Instruction::Blitting blit = Makai::Cast::bit<Instruction::Blitting>(current.type);
-	auto& src = blit.fromGlobal ? context.globalValueStack : context.locals();
-	auto& dst = blit.fromGlobal ? context.locals() : context.globalValueStack;
 	advance(true);
 	auto const count = Makai::Cast::bit<uint64>(current);
-	if (!(blit.offset + count < src.size()))
+	auto const size = blit.fromGlobal ? context.globalValueStack.size() : context.locals().size();
+	if (!(blit.offset + count < size))
 		return crash(outOfRangeError("Requested blit range falls outside source's size!"));
-	if (blit.fromGlobal)
-		dst.appendBack(src.sliced(-(blit.offset+1 + count), -(blit.offset+1)));
-	else dst.appendBack(src.sliced(blit.offset, blit.offset + count - 1));
+	if (blit.fromGlobal) {
+		for (auto const& value: context.globalValueStack.sliced(-(blit.offset+1 + count), -(blit.offset+1)))
+			context.addLocal(value);
+	} else for (auto const& value: Context::Locals(context.locals().data() + blit.offset, count))
+		context.push(value);
 }
 
 void Engine::initializeObject(Object::Storage const& object) {
@@ -1759,7 +2229,7 @@ void Engine::v2Create() {
 		if (create.dynSize) {
 			if (context.globalValueStack.empty())
 				return crash(invalidSourceError("Missing size for dynamic creation size!"));
-			size = context.pop()->toValue<uint64>();
+			size = context.pop().toValue<uint64>();
 		} else {
 			advance(true);
 			size = Makai::Cast::bit<uint64>(current);
@@ -1796,18 +2266,19 @@ void Engine::v2Breakpoint() {
 
 void Engine::v2ScopeKeep() {
 	if (context.scopeStack.size() < 2) return;
-	auto& locals = context.locals();
-	auto& parentLocals = context.scopeStack[-2]->localStack;
-	if (parentLocals.empty())
+	auto const parentCount = shared(context.localsOf(context.scopeStack.size() - 2)).size();
+	if (!parentCount)
 		return;
-	else if (locals.size() > parentLocals.size())
-		for (usize i = 0; i < parentLocals.size(); ++i)
-			locals[i] = parentLocals[i];
-	else [[likely]] locals = parentLocals;
+	if (context.locals().size() <= parentCount) [[likely]]
+		context.resizeLocals(parentCount);
+	auto const parentLocals	= context.localsOf(context.scopeStack.size() - 2);
+	auto locals				= context.locals();
+	for (usize i = 0; i < parentLocals.size(); ++i)
+		locals[i] = parentLocals[i];
 }
 
 void Engine::v2ScopeDeclare() {
-	context.locals().appendBack(Makai::List<Context::Storage>(current.type, nullptr));
+	context.addLocals(current.type);
 }
 
 void Engine::v2Cast() {
@@ -1837,21 +2308,21 @@ void Engine::v2Cast() {
 	};
 	if (auto const t = context.art.types.byID(typeID)) {
 		if (!context.top()) return crash(makeErrorHere("Value does not exist!"));
-		if (context.top()->isBasic() && t->basic) {
+		if ((context.top().unboxed() || context.top()->isBasic()) && t->basic) {
 			switch (*t->basic) {
-				case BasicType::AV2_BT_BOOL:	context.push(context.newValue(context.pop()->toValue<bool>()));			break;
-				case BasicType::AV2_BT_INT8:	context.push(context.newValue(context.pop()->toValue<int8>()));			break;
-				case BasicType::AV2_BT_UINT8:	context.push(context.newValue(context.pop()->toValue<uint8>()));		break;
-				case BasicType::AV2_BT_INT16:	context.push(context.newValue(context.pop()->toValue<int16>()));		break;
-				case BasicType::AV2_BT_UINT16:	context.push(context.newValue(context.pop()->toValue<uint16>()));		break;
-				case BasicType::AV2_BT_INT32:	context.push(context.newValue(context.pop()->toValue<int32>()));		break;
-				case BasicType::AV2_BT_UINT32:	context.push(context.newValue(context.pop()->toValue<uint32>()));		break;
-				case BasicType::AV2_BT_INT64:	context.push(context.newValue(context.pop()->toValue<int64>()));		break;
-				case BasicType::AV2_BT_UINT64:	context.push(context.newValue(context.pop()->toValue<uint64>()));		break;
-				case BasicType::AV2_BT_REAL32:	context.push(context.newValue(context.pop()->toValue<float32>()));		break;
-				case BasicType::AV2_BT_REAL64:	context.push(context.newValue(context.pop()->toValue<float64>()));		break;
+				case BasicType::AV2_BT_BOOL:	context.push(context.newValue(context.pop().toValue<bool>()));			break;
+				case BasicType::AV2_BT_INT8:	context.push(context.newValue(context.pop().toValue<int8>()));			break;
+				case BasicType::AV2_BT_UINT8:	context.push(context.newValue(context.pop().toValue<uint8>()));			break;
+				case BasicType::AV2_BT_INT16:	context.push(context.newValue(context.pop().toValue<int16>()));			break;
+				case BasicType::AV2_BT_UINT16:	context.push(context.newValue(context.pop().toValue<uint16>()));		break;
+				case BasicType::AV2_BT_INT32:	context.push(context.newValue(context.pop().toValue<int32>()));			break;
+				case BasicType::AV2_BT_UINT32:	context.push(context.newValue(context.pop().toValue<uint32>()));		break;
+				case BasicType::AV2_BT_INT64:	context.push(context.newValue(context.pop().toValue<int64>()));			break;
+				case BasicType::AV2_BT_UINT64:	context.push(context.newValue(context.pop().toValue<uint64>()));		break;
+				case BasicType::AV2_BT_REAL32:	context.push(context.newValue(context.pop().toValue<float32>()));		break;
+				case BasicType::AV2_BT_REAL64:	context.push(context.newValue(context.pop().toValue<float64>()));		break;
 				case BasicType::AV2_BT_REAL128:	context.push(context.newValue(context.pop()->toValue<float128>()));		break;
-				case BasicType::AV2_BT_VECTOR:	context.push(context.newValue(context.pop()->toValue<Vector4>()));		break;
+				case BasicType::AV2_BT_VECTOR:	context.push(context.newValue(context.pop().toValue<Vector4>()));		break;
 				case BasicType::AV2_BT_MATRIX:	context.push(context.newValue(context.pop()->toValue<Matrix4x4>()));	break;
 				case BasicType::AV2_BT_TYPEID:	context.push(context.newValue(context.pop()->toValue<Core::TypeID>()));	break;
 				case BasicType::AV2_BT_STRING:	context.push(context.newValue(context.pop()->toValue<UTF8String>()));	break;
@@ -1873,13 +2344,13 @@ void Engine::v2Select() {
 		return crash(outOfRangeError("Global stack is empty!"));
 	if (!context.top())
 		return crash(makeErrorHere("Select value does not exist!"));
-	if (!(context.top()->isUnsigned() or context.top()->isBoolean()))
+	if (!(context.top().isUnsigned() or context.top().isBoolean()))
 		return crash(makeErrorHere("Expected unsigned integer or boolean value for select!"));
-	uint64 const to = context.pop()->toValue<uint64>();
+	uint64 const to = context.pop().toValue<uint64>();
 	if (!select.count) return;
 	usize at = (to < select.count ? to : select.count);
-	if ((context.pointers.instruction + at) >= program.code.size())
+	if ((context.pointers.instruction + at) >= program->code.size())
 		return crash(endOfProgramError());
-	uint64 const loc = Makai::Cast::bit<uint64>(program.code[context.pointers.instruction + at]);
+	uint64 const loc = Makai::Cast::bit<uint64>(program->code[context.pointers.instruction + at]);
 	jumpByMode(select.mode, loc, false /*not returnable*/);
 }
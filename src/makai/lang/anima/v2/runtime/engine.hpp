@@ -2,17 +2,32 @@
 #define MAKAILIB_ANIMA_V2_RUNTIME_ENGINE_H
 
 #include "context.hpp"
+#include "jit.hpp"
+#include "profiler.hpp"
 
 namespace Makai::Anima::V2::Runtime {
+	struct Precompiled;
+
 	struct Engine {
 		struct Config {
-			bool allowDynamicLibraries = false;
+			bool	allowDynamicLibraries	= false;
+			bool	threadedDispatch		= true;
+			bool	jit						= false;
+			usize	jitThreshold			= 1000;
+			bool	profile					= false;
+			/// @brief Library holding code compiled ahead of time from the program, if any (see `Precompiled`).
+			/// @note Requires `allowDynamicLibraries`. Gets ignored if it was not compiled from the exact program being run.
+			String	precompiled;
 
 			static Config createDefault() {
 				return Config();
 			}
 		};
 
+		/// @brief Loaded program.
+		/// @details The engine never modifies it, so one can be shared between many engines, including across threads.
+		using Program = AtomicCell<Core::Module>;
+
 		enum class State {
 			AV2_RES_READY,
 			AV2_RES_INITIALIZING,
@@ -27,6 +42,47 @@ namespace Makai::Anima::V2::Runtime {
 			Core::Instruction	instruction;
 		};
 
+		/// @brief Inline cache hit/miss counters.
+		struct CacheStatistics {
+			/// @brief Field accesses that reused a resolved access.
+			usize fieldHits		= 0;
+			/// @brief Field accesses that had to be resolved.
+			usize fieldMisses	= 0;
+			/// @brief Dynamic calls that reused a resolved target.
+			usize callHits		= 0;
+			/// @brief Dynamic calls that had to be resolved.
+			usize callMisses	= 0;
+			/// @brief External calls that reused a resolved native function.
+			usize nativeHits	= 0;
+			/// @brief External calls that had to be resolved.
+			usize nativeMisses	= 0;
+		};
+
+		/// @brief Limits on how much a single call to `process` can run for.
+		/// @details
+		///		Once either limit is reached, execution stops at the next instruction boundary,
+		///		and picks back up from there on the next call to `process`.
+		struct Budget {
+			/// @brief Maximum instruction count. Zero for no limit.
+			usize instructions	= 0;
+			/// @brief Maximum time, in nanoseconds. Zero for no limit.
+			/// @note Only checked every `BUDGET_CHECK_INTERVAL` instructions, so slow instructions can overshoot it.
+			usize time			= 0;
+		};
+
+		/// @brief How much the last call to `process` ran for.
+		struct Usage {
+			/// @brief Instructions executed.
+			usize	instructions	= 0;
+			/// @brief Time spent, in nanoseconds.
+			usize	time			= 0;
+			/// @brief Whether execution stopped for running out of budget.
+			bool	preempted		= false;
+		};
+
+		/// @brief How many instructions run between checks for a time budget.
+		constexpr static usize BUDGET_CHECK_INTERVAL = 128;
+
 		struct ILibraryLoader {
 			virtual ~ILibraryLoader() {}
 
@@ -42,6 +98,10 @@ namespace Makai::Anima::V2::Runtime {
 		virtual ~Engine() {}
 
 		bool process();
+		/// @brief Runs the program until it yields, or until it runs out of budget.
+		/// @param budget Budget to run under.
+		/// @return Whether the program is still running.
+		bool process(Budget const& budget);
 
 		bool hasExposedCall(String const& name);
 
@@ -95,10 +155,21 @@ namespace Makai::Anima::V2::Runtime {
 		void terminate();
 		void reset();
 		void load(Core::Module const& program);
+		void load(Program const& program);
 		void execute();
 
 		Nullable<Error>	error() const	{return err;}
 
+		CacheStatistics	cacheStatistics() const	{return cacheStats;}
+
+		/// @brief Returns how much the last call to `process` ran for.
+		/// @return Budget usage.
+		Usage usage() const {return used;}
+
+		/// @brief Returns the program's profile, if profiling is enabled.
+		/// @return Profile, or `nullptr` if profiling is disabled.
+		ref<Profiler const>	profile() const	{return profiler.raw();}
+
 		bool running() const;
 		bool finished() const;
 
@@ -108,7 +179,7 @@ namespace Makai::Anima::V2::Runtime {
 		virtual Context::Storage	external	(String const& name, bool const doNotCopy	);
 		Context::Storage&			global		(uint64 const globalID						);
 
-		bool inStrictMode() const {return context.scopeStack.back()->mode == Core::ContextMode::AV2_CM_STRICT;}
+		bool inStrictMode() const {return context.scopeStack.back().mode == Core::ContextMode::AV2_CM_STRICT;}
 
 		void crash(Engine::Error const& error);
 
@@ -126,11 +197,126 @@ namespace Makai::Anima::V2::Runtime {
 		virtual void onLoad() {}
 
 	private:
+		friend struct JIT;
+		friend struct Precompiled;
+
+		using Handler = void (Engine::*)();
+
+		constexpr static usize NO_TARGET	= Limit::MAX<usize>;
+		constexpr static usize NO_CACHE		= Limit::MAX<usize>;
+
+		/// @brief Inline cache entry count, per instruction. Past that, entries get replaced round-robin.
+		constexpr static usize CACHE_WAYS	= 4;
+
+		/// @brief Per-instruction cache of resolved field accesses, keyed by receiver type.
+		struct FieldCache {
+			Core::Object::FieldAccess	entries[CACHE_WAYS];
+			usize						count		= 0;
+			usize						next		= 0;
+			/// @brief Type database revision the entries were resolved at.
+			uint64						revision	= 0;
+		};
+
+		/// @brief Per-instruction cache of resolved dynamic call targets, keyed by call ID.
+		struct CallCache {
+			uint64	ids[CACHE_WAYS]		= {};
+			usize	targets[CACHE_WAYS]	= {};
+			usize	count				= 0;
+			usize	next				= 0;
+		};
+
+		/// @brief Per-instruction cache of the resolved native function, for external calls.
+		struct NativeCache {
+			uint64							hash	= 0;
+			ref<Core::Context::NativeCall>	call	= nullptr;
+			/// @brief Native call revision the function was resolved at.
+			uint64							calls	= 0;
+			/// @brief Type database revision the function was resolved at.
+			uint64							types	= 0;
+		};
+
+		/// @brief Load-time decoded instruction.
+		struct DecodedInstruction {
+			/// @brief Instruction handler. `null` if instruction does nothing.
+			Handler				handler		= nullptr;
+			/// @brief Instruction to execute.
+			Core::Instruction	instruction	= {};
+			/// @brief Index of the instruction to execute, when fetching from this index (skips "free" no-ops).
+			usize				next		= 0;
+			/// @brief Resolved jump/call target, if any.
+			usize				target		= NO_TARGET;
+			/// @brief Native code for the instruction, if it got compiled (by the JIT, or ahead of time).
+			pointer				native		= nullptr;
+			/// @brief Inline cache for the instruction, if it has one.
+			usize				cache		= NO_CACHE;
+		};
+
 		void load();
 		void unload();
 
+		void decode();
+		void dispatch();
+
+		void attach(Precompiled const& code);
+		void detach();
+
+		constexpr static Handler handlerFor(Core::Instruction::Name const name) {
+			switch (name) {
+				using enum Core::Instruction::Name;
+				case AV2_IN_HALT:			return &Engine::v2Halt;
+				case AV2_IN_STACK_BLIT:		return &Engine::v2StackBlit;
+				case AV2_IN_STACK_POP:		return &Engine::v2StackPop;
+				case AV2_IN_STACK_PUSH:		return &Engine::v2StackPush;
+				case AV2_IN_STACK_CLEAR:	return &Engine::v2StackClear;
+				case AV2_IN_STACK_FLUSH:	return &Engine::v2StackFlush;
+				case AV2_IN_STACK_GROW:		return &Engine::v2StackGrow;
+				case AV2_IN_STACK_SWAP:		return &Engine::v2StackSwap;
+				case AV2_IN_SCOPE_ENTER:	return &Engine::v2ScopeEnter;
+				case AV2_IN_SCOPE_EXIT:		return &Engine::v2ScopeExit;
+				case AV2_IN_SCOPE_BRING:	return &Engine::v2ScopeBring;
+				case AV2_IN_SCOPE_BIND:		return &Engine::v2ScopeBind;
+				case AV2_IN_SCOPE_DECLARE:	return &Engine::v2ScopeDeclare;
+				case AV2_IN_SCOPE_KEEP:		return &Engine::v2ScopeKeep;
+				case AV2_IN_SIZEOF:			return &Engine::v2Sizeof;
+				case AV2_IN_TYPEOF:			return &Engine::v2Typeof;
+				case AV2_IN_FIELD_GET:		return &Engine::v2FieldGet;
+				case AV2_IN_FIELD_SET:		return &Engine::v2FieldSet;
+				case AV2_IN_RANDOM:			return &Engine::v2Random;
+				case AV2_IN_COPY:			return &Engine::v2Copy;
+				case AV2_IN_RETURN: 		return &Engine::v2Return;
+				case AV2_IN_CALL:			return &Engine::v2Call;
+				case AV2_IN_CAST:			return &Engine::v2Cast;
+				case AV2_IN_OP:				return &Engine::v2Op;
+				case AV2_IN_COMPARE:		return &Engine::v2Compare;
+				case AV2_IN_MODE:			return &Engine::v2SetContext;
+				case AV2_IN_JUMP:			return &Engine::v2Jump;
+				case AV2_IN_YIELD:			return &Engine::v2Yield;
+				case AV2_IN_CLEAR:			return &Engine::v2Clear;
+				case AV2_IN_SELECT:			return &Engine::v2Select;
+				case AV2_IN_CREATE:			return &Engine::v2Create;
+				case AV2_IN_INITIALIZE:		return &Engine::v2Initialize;
+				case AV2_IN_BREAKPOINT:		return &Engine::v2Breakpoint;
+				case AV2_IN_NO_OP:			return nullptr;
+			}
+			return nullptr;
+		}
+
+		usize resolvedTarget() const;
+
+		/// @brief Creates a string from one of the program's strings, sharing its interned contents.
+		Context::Storage stringConstant(usize const id) const;
+
+		ref<Core::Object::FieldAccess const> fieldAccess(usize const site, Context::Storage const& object, uint64 const index);
+		usize callTarget(usize const site, uint64 const id);
+		ref<Core::Context::NativeCall> nativeCall(usize const site, uint64 const hash);
+
+		void externalCall(usize const site, uint64 const hash, Core::Instruction::Invocation const invocation);
+		void invokeNative(Core::Context::NativeCall& method, Core::Instruction::Invocation const invocation);
+
 		bool yieldCycle();
 
+		bool refuel();
+
 		Engine::Error invalidInstructionError();
 		Engine::Error endOfProgramError();
 		Engine::Error invalidOperationError(String const& description);
@@ -208,15 +394,35 @@ namespace Makai::Anima::V2::Runtime {
 		void jumpByTableIndex(usize const tableID, bool returnable);
 		void jumpTo(usize const point, bool returnable);
 		void jumpByMode(Core::Instruction::Leap::Mode const mode, usize const location, bool returnable);
+		void dropFrame();
 		void returnBack();
 
 		void initializeObject(Core::Object::Storage const& object);
 
 		State				engineState	= State::AV2_RES_READY;
 		usize				delay		= 0;
-		Core::Module		program;
 		Core::Instruction	current;
+		/// @brief Instructions that can run before the budget has to be checked again.
+		usize				fuel		= 0;
+		/// @brief Instructions left in the budget, past the current fuel.
+		usize				allowance	= 0;
+		/// @brief Time the budget runs out at. Zero if it has no time limit.
+		usize				deadline	= 0;
+		Usage				used;
 		Nullable<Error>		err;
+
+		Program						loaded;
+		ref<Core::Module const>		program	= nullptr;
+		List<DecodedInstruction>	decoded;
+		/// @brief Program's strings, interned.
+		List<Core::Context::Interned>	strings;
+		List<FieldCache>			fieldCaches;
+		List<CallCache>				callCaches;
+		List<NativeCache>			nativeCaches;
+		CacheStatistics				cacheStats;
+		Unique<JIT>					jit;
+		Unique<Profiler>			profiler;
+		ref<Precompiled const>		precompiled	= nullptr;
 	};
 }
 
@@ -0,0 +1,162 @@
+#include "group.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using Makai::Anima::V2::Runtime::EngineGroup;
+using Makai::Anima::V2::Runtime::Engine;
+
+using namespace Makai::Anima::V2;
+
+/// Worker thread pool, processing one batch of engines at a time.
+struct EngineGroup::Workers {
+	Workers(usize const count) {
+		for (usize i = 0; i < count; ++i)
+			threads.emplace_back([this] {work();});
+	}
+
+	~Workers() {
+		{
+			std::lock_guard const lock(sync);
+			stopping = true;
+		}
+		wake.notify_all();
+		for (auto& thread: threads)
+			thread.join();
+	}
+
+	/// Processes every engine once, on the workers and the calling thread alike.
+	void run(List<ref<Engine>> const& engines, Engine::Budget const& budget) {
+		auto const count = engines.size();
+		running.resize(count);
+		faults.resize(count);
+		Batch current;
+		{
+			std::lock_guard const lock(sync);
+			current = batch = {++generation, engines.data(), count, budget};
+			pending.store(count);
+			ticket.store(current.generation << INDEX_BITS);
+		}
+		wake.notify_all();
+		drain(current);
+		std::unique_lock lock(sync);
+		done.wait(lock, [&] {return !pending.load();});
+	}
+
+	usize size() const {return threads.size();}
+
+	/// Whether each engine is still running, after the last batch.
+	std::vector<uint8>				running;
+	/// What each engine threw during the last batch, if anything.
+	std::vector<std::exception_ptr>	faults;
+
+private:
+	constexpr static usize INDEX_BITS	= 32;
+	constexpr static usize INDEX_MASK	= (usize(1) << INDEX_BITS) - 1;
+
+	struct Batch {
+		usize					generation	= 0;
+		ref<ref<Engine> const>	engines		= nullptr;
+		usize					count		= 0;
+		Engine::Budget			budget;
+	};
+
+	/// Claims the next engine to process. Tickets carry the batch they belong to, so late workers cannot claim engines from newer batches.
+	bool claim(Batch const& current, usize& index) {
+		auto value = ticket.load();
+		do {
+			if ((value >> INDEX_BITS) != (current.generation & INDEX_MASK)) return false;
+			index = value & INDEX_MASK;
+			if (index >= current.count) return false;
+		} while (!ticket.compare_exchange_weak(value, value + 1));
+		return true;
+	}
+
+	void drain(Batch const& current) {
+		usize index;
+		while (claim(current, index)) {
+			faults[index] = nullptr;
+			try {
+				running[index] = current.engines[index]->process(current.budget);
+			} catch (...) {
+				running[index]	= false;
+				faults[index]	= std::current_exception();
+			}
+			if (pending.fetch_sub(1) == 1) {
+				std::lock_guard const lock(sync);
+				done.notify_all();
+			}
+		}
+	}
+
+	void work() {
+		usize seen = 0;
+		while (true) {
+			Batch current;
+			{
+				std::unique_lock lock(sync);
+				wake.wait(lock, [&] {return stopping || batch.generation != seen;});
+				if (stopping) return;
+				current	= batch;
+				seen	= current.generation;
+			}
+			drain(current);
+		}
+	}
+
+	std::vector<std::thread>	threads;
+	std::mutex					sync;
+	std::condition_variable		wake;
+	std::condition_variable		done;
+	bool						stopping	= false;
+	usize						generation	= 0;
+	Batch						batch;
+	std::atomic<usize>			ticket		= 0;
+	std::atomic<usize>			pending		= 0;
+};
+
+EngineGroup::EngineGroup(usize const threads) {
+	auto const count = threads ? threads : Math::max<usize>(std::thread::hardware_concurrency(), 1) - 1;
+	workers = Unique<Workers>(new Workers(count));
+}
+
+EngineGroup::~EngineGroup() {}
+
+EngineGroup& EngineGroup::add(Engine& engine) {
+	engines.pushBack(&engine);
+	return *this;
+}
+
+EngineGroup& EngineGroup::remove(Engine& engine) {
+	engines.eraseLike(&engine);
+	return *this;
+}
+
+usize EngineGroup::threads() const {
+	return workers->size();
+}
+
+usize EngineGroup::process() {
+	return process([] (Engine&, usize const) {});
+}
+
+usize EngineGroup::process(Merger const& merge) {
+	return process({}, merge);
+}
+
+usize EngineGroup::process(Engine::Budget const& budget, Merger const& merge) {
+	if (engines.empty()) return 0;
+	workers->run(engines, budget);
+	for (auto const& fault: workers->faults)
+		if (fault) std::rethrow_exception(fault);
+	usize running = 0;
+	for (usize i = 0; i < engines.size(); ++i) {
+		merge(*engines[i], i);
+		if (workers->running[i]) ++running;
+	}
+	return running;
+}
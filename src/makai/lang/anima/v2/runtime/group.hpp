@@ -0,0 +1,71 @@
+#ifndef MAKAILIB_ANIMA_V2_RUNTIME_GROUP_H
+#define MAKAILIB_ANIMA_V2_RUNTIME_GROUP_H
+
+#include "engine.hpp"
+
+namespace Makai::Anima::V2::Runtime {
+	/// @brief Group of engines, processed in parallel.
+	/// @details
+	///		Every call to `process` processes each engine once, spread across a pool of worker threads.
+	///		An engine is only ever processed by one thread at a time,
+	///		and anything that has to see the results happens afterwards, on the calling thread, in the order the engines were added,
+	///		so results do not depend on how the work got split.
+	///
+	///		Engines should not share anything mutable between each other, besides their (read-only) `Engine::Program`.
+	///		Native functions they call must be thread-safe.
+	struct EngineGroup {
+		/// @brief Function called for every engine, once the whole group is done processing.
+		/// @param engine Engine processed.
+		/// @param index Engine's position in the group.
+		using Merger = Function<void(Engine& engine, usize const index)>;
+
+		/// @brief Constructs the group.
+		/// @param threads Worker thread count, besides the calling thread. If zero, picks one per available core.
+		EngineGroup(usize const threads = 0);
+
+		EngineGroup(EngineGroup const&)				= delete;
+		EngineGroup& operator=(EngineGroup const&)	= delete;
+
+		~EngineGroup();
+
+		/// @brief Adds an engine to the group. The group does not take ownership of it.
+		/// @param engine Engine to add.
+		/// @return Reference to self.
+		EngineGroup& add(Engine& engine);
+		/// @brief Removes an engine from the group.
+		/// @param engine Engine to remove.
+		/// @return Reference to self.
+		EngineGroup& remove(Engine& engine);
+
+		/// @brief Returns the engine count.
+		/// @return Engine count.
+		usize size() const {return engines.size();}
+		/// @brief Returns the worker thread count, besides the calling thread.
+		/// @return Worker thread count.
+		usize threads() const;
+
+		/// @brief Processes every engine once.
+		/// @return Count of engines still running.
+		/// @throw Whatever exception the first engine to fail threw.
+		usize process();
+		/// @brief Processes every engine once, then merges their results.
+		/// @param merge Function to call for every engine, in the order they were added.
+		/// @return Count of engines still running.
+		/// @throw Whatever exception the first engine to fail threw. If so, nothing gets merged.
+		usize process(Merger const& merge);
+		/// @brief Processes every engine once, each under the given budget, then merges their results.
+		/// @param budget Budget each engine gets.
+		/// @param merge Function to call for every engine, in the order they were added.
+		/// @return Count of engines still running.
+		/// @throw Whatever exception the first engine to fail threw. If so, nothing gets merged.
+		usize process(Engine::Budget const& budget, Merger const& merge);
+
+	private:
+		struct Workers;
+
+		List<ref<Engine>>	engines;
+		Unique<Workers>		workers;
+	};
+}
+
+#endif
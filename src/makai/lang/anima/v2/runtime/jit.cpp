@@ -0,0 +1,259 @@
+#include "jit.hpp"
+#include "engine.hpp"
+
+using Makai::Anima::V2::Runtime::JIT;
+using Makai::Anima::V2::Runtime::Engine;
+
+using namespace Makai::Anima::V2;
+
+using namespace Core;
+
+using Name = Instruction::Name;
+
+#if (CTL_ON_WINDOWS)
+// Microsoft x64 calling convention (arguments in rcx/rdx, 32 bytes of shadow space)
+constexpr static bool WIN64_ABI = true;
+#else
+// System V calling convention (arguments in rdi/rsi)
+constexpr static bool WIN64_ABI = false;
+#endif
+
+constexpr static usize NO_LABEL = Makai::Limit::MAX<usize>;
+
+/// Native code being assembled.
+struct Assembly {
+	Makai::List<uint8> code;
+
+	template <class... T>
+	void bytes(T const... values) {
+		(code.pushBack(Makai::Cast::as<uint8>(values)), ...);
+	}
+
+	void dword(uint32 const value) {
+		for (usize i = 0; i < 4; ++i)
+			code.pushBack(Makai::Cast::as<uint8>(value >> (i * 8)));
+	}
+
+	void qword(uint64 const value) {
+		for (usize i = 0; i < 8; ++i)
+			code.pushBack(Makai::Cast::as<uint8>(value >> (i * 8)));
+	}
+
+	usize here() const {return code.size();}
+
+	/// Points a 32-bit relative displacement at a given offset.
+	void patch(usize const at, usize const to) {
+		auto const rel = Makai::Cast::as<uint32>(Makai::Cast::as<ssize>(to) - Makai::Cast::as<ssize>(at + 4));
+		for (usize i = 0; i < 4; ++i)
+			code[at + i] = Makai::Cast::as<uint8>(rel >> (i * 8));
+	}
+};
+
+/// Pending jump displacement.
+struct Fixup {
+	/// Offset of the displacement.
+	usize at;
+	/// Instruction to jump to, or `NO_LABEL` for the generic continuation.
+	usize to;
+};
+
+/// Calls a function with the engine as its first argument (kept in rbx).
+template <class T>
+static void emitCall(Assembly& code, T const function, Makai::Nullable<uint32> const argument = null) {
+	if constexpr (WIN64_ABI)	code.bytes(0x48, 0x89, 0xD9);	// mov rcx, rbx
+	else						code.bytes(0x48, 0x89, 0xDF);	// mov rdi, rbx
+	if (argument) {
+		if constexpr (WIN64_ABI)	code.bytes(0xBA);			// mov edx, imm32
+		else						code.bytes(0xBE);			// mov esi, imm32
+		code.dword(*argument);
+	}
+	code.bytes(0x48, 0xB8);										// mov rax, imm64
+	code.qword(Makai::Cast::bit<uint64>(function));
+	code.bytes(0xFF, 0xD0);										// call rax
+}
+
+/// Jumps if the returned value is a given instruction index. Returns where the displacement is.
+static usize emitJumpIfReturned(Assembly& code, uint32 const value) {
+	code.bytes(0x48, 0x3D);										// cmp rax, imm32
+	code.dword(value);
+	code.bytes(0x0F, 0x84);										// je rel32
+	code.dword(0);
+	return code.here() - 4;
+}
+
+/// Jumps unconditionally. Returns where the displacement is.
+static usize emitJump(Assembly& code) {
+	code.bytes(0xE9);											// jmp rel32
+	code.dword(0);
+	return code.here() - 4;
+}
+
+/// Whether execution never continues to the next instruction.
+static bool endsFlow(Instruction const& inst) {
+	switch (inst.name) {
+		case Name::AV2_IN_HALT:
+		case Name::AV2_IN_RETURN:	return true;
+		case Name::AV2_IN_JUMP: {
+			auto const leap = inst.getTypeAs<Instruction::Leap>();
+			return leap.type == Instruction::Leap::Type::AV2_ILT_UNCONDITIONAL && !leap.invert;
+		}
+		default: return false;
+	}
+}
+
+/// Whether the instruction changes the scope or context mode, which the engine has to look at before going on.
+static bool exitsAfter(Instruction const& inst) {
+	switch (inst.name) {
+		case Name::AV2_IN_HALT:
+		case Name::AV2_IN_MODE:
+		case Name::AV2_IN_RETURN:
+		case Name::AV2_IN_SCOPE_EXIT:	return true;
+		case Name::AV2_IN_CALL:			return inst.getTypeAs<Instruction::Invocation>().tail;
+		default: return false;
+	}
+}
+
+JIT::JIT(Engine& engine, usize const threshold):
+	engine(engine),
+	threshold(threshold ? threshold : 1),
+	heatOf(engine.program->code.size(), usize(0)) {
+	Assembly code;
+	code.bytes(0x53);											// push rbx
+	if constexpr (WIN64_ABI) {
+		code.bytes(0x48, 0x83, 0xEC, 0x20);						// sub rsp, 32
+		code.bytes(0x48, 0x89, 0xCB);							// mov rbx, rcx
+		code.bytes(0xFF, 0xE2);									// jmp rdx
+	} else {
+		code.bytes(0x48, 0x89, 0xFB);							// mov rbx, rdi
+		code.bytes(0xFF, 0xE6);									// jmp rsi
+	}
+	auto const thunk = memory.allocate(code.here());
+	if (!thunk) return;
+	MX::memcpy(thunk, code.code.data(), code.here());
+	if (!memory.seal(thunk)) return;
+	entry = Makai::Cast::bit<Entry>(thunk);
+}
+
+void JIT::heat(usize const target) {
+	if (!entry || target >= heatOf.size() || heatOf[target] >= threshold) return;
+	if (++heatOf[target] < threshold) return;
+	auto const start = engine.decoded[target + 1].next;
+	if (!engine.decoded[start].native)
+		compile(start);
+}
+
+void JIT::run(pointer const at) {
+	entry(&engine, at);
+	if (!fault) return;
+	auto const e = fault;
+	fault = nullptr;
+	std::rethrow_exception(e);
+}
+
+bool JIT::compile(usize const start) {
+	auto& decoded	= engine.decoded;
+	auto const size	= engine.program->code.size();
+	if (size >= Makai::Cast::as<usize>(Makai::Limit::MAX<int32>))
+		return false;
+	// Gather the region, until control flow leaves it for good
+	Makai::List<usize> blocks;
+	usize at = start, reach = start;
+	while (at < size && blocks.size() < MAX_REGION_SIZE) {
+		auto const& op = decoded[at];
+		if (op.native) break;
+		if (op.next != at) {
+			++at;
+			continue;
+		}
+		auto const length = op.instruction.size();
+		if (!length) break;
+		blocks.pushBack(at);
+		if (op.target != Engine::NO_TARGET && op.target >= at)
+			reach = Makai::Math::max(reach, op.target + 1);
+		at += *length;
+		if (endsFlow(op.instruction) && at > reach) break;
+	}
+	MAKAILIB_DEBUGLN_FULL("JIT: Region [", start, "..", at, "] has ", blocks.size(), " instructions");
+	if (blocks.empty()) return false;
+	auto const end = at;
+	Makai::List<usize> labels(end - start, NO_LABEL);
+	for (auto const block: blocks)
+		labels[block - start] = 0;
+	auto const isLabel = [&] (usize const index) {
+		return index >= start && index < end && labels[index - start] != NO_LABEL;
+	};
+	// Emit every instruction as a call to its handler, followed by wherever execution goes next
+	Assembly code;
+	Makai::List<Fixup> fixups;
+	for (auto const block: blocks) {
+		labels[block - start] = code.here();
+		auto const& op = decoded[block];
+		emitCall(code, &JIT::step, Makai::Cast::as<uint32>(block));
+		if (!exitsAfter(op.instruction)) {
+			auto const last = block + *op.instruction.size() - 1;
+			if (last < size && isLabel(decoded[last + 1].next))
+				fixups.pushBack({emitJumpIfReturned(code, last), decoded[last + 1].next});
+			if (op.target != Engine::NO_TARGET && op.target != last && isLabel(decoded[op.target + 1].next))
+				fixups.pushBack({emitJumpIfReturned(code, op.target), decoded[op.target + 1].next});
+		}
+		fixups.pushBack({emitJump(code), NO_LABEL});
+	}
+	// Generic continuation: ask the engine where to go, and leave if it has to take over
+	auto const generic = code.here();
+	emitCall(code, &JIT::resume);
+	code.bytes(0x48, 0x85, 0xC0);								// test rax, rax
+	code.bytes(0x74, 0x02);										// jz exit
+	code.bytes(0xFF, 0xE0);										// jmp rax
+	if constexpr (WIN64_ABI)
+		code.bytes(0x48, 0x83, 0xC4, 0x20);						// exit: add rsp, 32
+	code.bytes(0x5B);											// pop rbx
+	code.bytes(0xC3);											// ret
+	for (auto const& fixup: fixups)
+		code.patch(fixup.at, fixup.to == NO_LABEL ? generic : labels[fixup.to - start]);
+	auto const native = static_cast<ref<uint8>>(memory.allocate(code.here()));
+	if (!native) return false;
+	MX::memcpy(native, code.code.data(), code.here());
+	// Code is written while the memory is not executable, then made executable once it stops being written to
+	if (!memory.seal(native)) {
+		memory.free(native);
+		return false;
+	}
+	for (auto const block: blocks)
+		decoded[block].native = native + labels[block - start];
+	return true;
+}
+
+usize JIT::step(Engine& engine, usize const at) {
+	auto const& op = engine.decoded.cbegin()[at];
+	engine.context.pointers.instruction	= at;
+	engine.current						= op.instruction;
+	--engine.fuel;
+	if (op.handler) try {
+		(engine.*op.handler)();
+	} catch (...) {
+		// Exceptions cannot unwind through native code, so they get rethrown once it is left
+		engine.jit->fault = std::current_exception();
+		return Engine::NO_TARGET;
+	}
+	if (!engine.running() || engine.delay)
+		return Engine::NO_TARGET;
+	// Out of budget, so the next instruction has to wait for the next time the engine gets processed
+	if (!engine.fuel && !engine.refuel())
+		return Engine::NO_TARGET;
+	return engine.context.pointers.instruction;
+}
+
+pointer JIT::resume(Engine& engine) {
+	if (engine.jit->fault || !engine.running() || engine.delay || engine.used.preempted)
+		return nullptr;
+	auto& context = engine.context;
+	if (context.scopeStack.empty())
+		return nullptr;
+	auto const& scope = context.scopeStack.back();
+	if (scope.prevMode != scope.mode)
+		return nullptr;
+	auto const ops		= engine.decoded.cbegin();
+	auto const fetch	= context.pointers.instruction + 1;
+	auto const fetchEnd	= engine.decoded.size();
+	return ops[ops[fetch < fetchEnd ? fetch : (fetchEnd - 1)].next].native;
+}
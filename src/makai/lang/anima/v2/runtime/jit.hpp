@@ -0,0 +1,66 @@
+#ifndef MAKAILIB_ANIMA_V2_RUNTIME_JIT_H
+#define MAKAILIB_ANIMA_V2_RUNTIME_JIT_H
+
+#include "../../../../compat/ctl.hpp"
+#include "../../../../ctl/ctl/memory/heap.hpp"
+
+#include <exception>
+
+namespace Makai::Anima::V2::Runtime {
+	struct Engine;
+
+	/// @brief Baseline compiler for hot code regions.
+	/// @details
+	///		Compiles hot call targets and loop headers into native code that calls the engine's instruction handlers directly,
+	///		with direct jumps between instructions wherever control flow is known ahead of time.
+	///		This removes the dispatch loop, and its per-instruction scope checks, from hot code.
+	///
+	///		Native code hands control back to the engine whenever it cannot tell where execution continues,
+	///		so anything the compiler does not understand gets interpreted as usual.
+	struct JIT {
+		#if (CTL_ON_X86) && !(CTL_ON_MSVC)
+		/// @brief Whether native code can be generated for the target platform.
+		constexpr static bool SUPPORTED = sizeof(pointer) == sizeof(uint64);
+		#else
+		/// @brief Whether native code can be generated for the target platform.
+		constexpr static bool SUPPORTED = false;
+		#endif
+
+		/// @brief Maximum instruction count in a compiled region.
+		constexpr static usize MAX_REGION_SIZE = 4096;
+
+		/// @brief Constructs the compiler.
+		/// @param engine Engine to compile code for. Must have its program loaded.
+		/// @param threshold How many times a region must be entered before getting compiled.
+		JIT(Engine& engine, usize const threshold);
+
+		JIT(JIT const&)				= delete;
+		JIT& operator=(JIT const&)	= delete;
+
+		/// @brief Records an entry into the region starting after a jump target, and compiles it once it gets hot.
+		/// @param target Jump target.
+		void heat(usize const target);
+
+		/// @brief Runs native code until execution has to go back to the interpreter.
+		/// @param at Native code to start at.
+		/// @throw Whatever exception an instruction handler throws.
+		void run(pointer const at);
+
+	private:
+		using Entry = void(*)(ref<Engine>, pointer);
+
+		bool compile(usize const start);
+
+		static usize	step(Engine& engine, usize const at);
+		static pointer	resume(Engine& engine);
+
+		Engine&				engine;
+		usize const			threshold;
+		List<usize>			heatOf;
+		Heap				memory{{}, {.executable = true}};
+		Entry				entry	= nullptr;
+		std::exception_ptr	fault;
+	};
+}
+
+#endif
@@ -0,0 +1,13 @@
+#include "precompiled.hpp"
+
+using Makai::Anima::V2::Runtime::Precompiled;
+using Makai::Anima::V2::Runtime::Engine;
+
+void Precompiled::interpret(Engine& engine, usize const at) {
+	auto const& op = engine.decoded.cbegin()[at];
+	engine.context.pointers.instruction	= at;
+	engine.current						= op.instruction;
+	--engine.fuel;
+	if (op.handler)
+		(engine.*op.handler)();
+}
@@ -0,0 +1,253 @@
+#ifndef MAKAILIB_ANIMA_V2_RUNTIME_PRECOMPILED_H
+#define MAKAILIB_ANIMA_V2_RUNTIME_PRECOMPILED_H
+
+#include "engine.hpp"
+
+namespace Makai::Anima::V2::Runtime {
+	/// @brief Code compiled ahead of time from a module.
+	/// @details
+	///		Gets generated as C++ by the toolchain (see `Toolchain::Compiler::Transpiler`),
+	///		and built into a dynamic library, for the engine to load through `Engine::Config::precompiled`.
+	///
+	///		Each of its functions covers a section of the module's code. Every instruction in it is a direct call to its handler,
+	///		with native jumps between instructions wherever control flow is known ahead of time.
+	///		Operations and comparisons on a known basic type run in place, and calls to natives skip decoding the call.
+	///		Whenever it is not, control goes back to the engine, which picks it back up from wherever execution continues.
+	///
+	///		Only gets used if it was compiled from the exact program the engine is running.
+	struct Precompiled {
+		/// @brief Compiled function. Runs from a given instruction, until execution has to go back to the engine.
+		using Function = void(*)(Engine& engine, usize const at);
+
+		/// @brief Section of code a compiled function covers.
+		struct Section {
+			/// @brief First instruction in the section.
+			usize		start;
+			/// @brief Where the section ends.
+			usize		end;
+			/// @brief Function covering the section.
+			Function	function;
+		};
+
+		/// @brief Library holding precompiled code.
+		struct Library;
+
+		/// @brief Fingerprint of the module the code was compiled from (see `Core::Module::fingerprint`).
+		uint64			fingerprint;
+		/// @brief Compiled sections.
+		List<Section>	sections;
+
+		/// @brief Runs an instruction. Used by generated code.
+		/// @tparam N Instruction name.
+		/// @param engine Engine to run in.
+		/// @param at Instruction to run.
+		/// @return Where execution continues from, or `Engine::NO_TARGET` if it has to go back to the engine.
+		template <Core::Instruction::Name N>
+		static usize step(Engine& engine, usize const at) {
+			constexpr auto handler = Engine::handlerFor(N);
+			enter(engine, at);
+			if constexpr (handler != nullptr)
+				(engine.*handler)();
+			return leave(engine);
+		}
+
+		/// @brief Runs a binary operation assumed to be on values of a given basic type. Used by generated code.
+		/// @tparam O Operator.
+		/// @tparam T Assumed type.
+		/// @tparam IMMEDIATE Whether the right-side operand is the instruction's immediate.
+		/// @param engine Engine to run in.
+		/// @param at Instruction to run.
+		/// @return Where execution continues from, or `Engine::NO_TARGET` if it has to go back to the engine.
+		/// @note Operates in place if the operands are held unboxed as the assumed type. Otherwise, runs the instruction's handler.
+		template <Core::Operator O, Core::BasicType T, bool IMMEDIATE>
+		static usize operate(Engine& engine, usize const at) {
+			enter(engine, at);
+			if constexpr (canOperate(O, T)) {
+				using Type = NativeType<T>;
+				auto& stack = engine.context.globalValueStack;
+				if (stack.size() >= (IMMEDIATE ? 1 : 2)) {
+					if constexpr (IMMEDIATE) {
+						auto& lhs = stack.back();
+						if (lhs.unboxed() && lhs.basic() == T) {
+							apply<O>(lhs.template as<Type>(), immediate<Type>(engine, at));
+							return leave(engine);
+						}
+					} else {
+						auto const& rhs	= stack.back();
+						auto& lhs		= stack[-2];
+						if (lhs.unboxed() && lhs.basic() == T && lhs.hasSameTypeAs(rhs)) {
+							apply<O>(lhs.template as<Type>(), rhs.template as<Type>());
+							stack.popBack();
+							return leave(engine);
+						}
+					}
+				}
+			}
+			engine.v2Op();
+			return leave(engine);
+		}
+
+		/// @brief Runs a comparison assumed to be between values of a given basic type. Used by generated code.
+		/// @tparam C Comparator.
+		/// @tparam T Assumed type.
+		/// @tparam IMMEDIATE Whether the right-side operand is the instruction's immediate.
+		/// @param engine Engine to run in.
+		/// @param at Instruction to run.
+		/// @return Where execution continues from, or `Engine::NO_TARGET` if it has to go back to the engine.
+		/// @note Compares in place if the operands are held unboxed as the assumed type. Otherwise, runs the instruction's handler.
+		template <Core::Comparator C, Core::BasicType T, bool IMMEDIATE>
+		static usize compare(Engine& engine, usize const at) {
+			enter(engine, at);
+			if constexpr (canCompare(T)) {
+				using Type = NativeType<T>;
+				auto& stack = engine.context.globalValueStack;
+				if (stack.size() >= (IMMEDIATE ? 1 : 2)) {
+					if constexpr (IMMEDIATE) {
+						auto& lhs = stack.back();
+						if (lhs.unboxed() && lhs.basic() == T) {
+							lhs.store(engine.context.newValue(order<C>(lhs.template as<Type>(), immediate<Type>(engine, at))));
+							return leave(engine);
+						}
+					} else {
+						auto const& rhs	= stack.back();
+						auto& lhs		= stack[-2];
+						if (lhs.unboxed() && lhs.basic() == T && lhs.hasSameTypeAs(rhs)) {
+							auto const result = order<C>(lhs.template as<Type>(), rhs.template as<Type>());
+							stack.popBack();
+							lhs.store(engine.context.newValue(result));
+							return leave(engine);
+						}
+					}
+				}
+			}
+			engine.v2Compare();
+			return leave(engine);
+		}
+
+		/// @brief Calls a native function known ahead of time. Used by generated code.
+		/// @tparam HASH Native function hash.
+		/// @tparam TYPE Invocation, as stored in the instruction.
+		/// @param engine Engine to run in.
+		/// @param at Instruction to run.
+		/// @return Where execution continues from, or `Engine::NO_TARGET` if it has to go back to the engine.
+		/// @note Natives only get registered when the engine runs, so the function itself still gets resolved through the call site's cache.
+		template <uint64 HASH, uint32 TYPE>
+		static usize invoke(Engine& engine, usize const at) {
+			enter(engine, at);
+			if (engine.profiler) [[unlikely]]
+				engine.v2Call();
+			else {
+				engine.context.pointers.instruction	= at + 1;
+				engine.current						= engine.decoded.cbegin()[at + 1].instruction;
+				engine.externalCall(at, HASH, bitcast<Core::Instruction::Invocation>(TYPE));
+			}
+			return leave(engine);
+		}
+
+		/// @brief Returns whether `operate` has a fast path for an operation on a given basic type.
+		/// @param op Operator.
+		/// @param type Assumed type.
+		/// @return Whether it has a fast path.
+		constexpr static bool canOperate(Core::Operator const op, Core::BasicType const type) {
+			switch (op) {
+				using enum Core::Operator;
+				// Same as the engine's fast operations, which only add, subtract and multiply
+				case AV2_BOP_ADD:
+				case AV2_BOP_SUB:
+				case AV2_BOP_MUL:	return canCompare(type);
+				default:			return false;
+			}
+		}
+
+		/// @brief Returns whether `compare` has a fast path for comparisons between values of a given basic type.
+		/// @param type Assumed type.
+		/// @return Whether it has a fast path.
+		constexpr static bool canCompare(Core::BasicType const type) {
+			switch (type) {
+				using enum Core::BasicType;
+				case AV2_BT_INT8:
+				case AV2_BT_UINT8:
+				case AV2_BT_INT16:
+				case AV2_BT_UINT16:
+				case AV2_BT_INT32:
+				case AV2_BT_UINT32:
+				case AV2_BT_INT64:
+				case AV2_BT_UINT64:
+				case AV2_BT_REAL32:
+				case AV2_BT_REAL64:	return true;
+				default:			return false;
+			}
+		}
+
+		/// @brief Runs an instruction the generated code has no label for. Used by generated code.
+		/// @param engine Engine to run in.
+		/// @param at Instruction to run.
+		static void interpret(Engine& engine, usize const at);
+
+	private:
+		template <Core::BasicType T>
+		using NativeType = Meta::Select<
+			enumcast(T) - enumcast(Core::BasicType::AV2_BT_INT8),
+			int8, uint8, int16, uint16, int32, uint32, int64, uint64, float32, float64
+		>;
+
+		static void enter(Engine& engine, usize const at) {
+			engine.context.pointers.instruction	= at;
+			engine.current						= engine.decoded.cbegin()[at].instruction;
+			--engine.fuel;
+		}
+
+		static usize leave(Engine& engine) {
+			if (!engine.running() || engine.delay)
+				return Engine::NO_TARGET;
+			// Out of budget, so the next instruction has to wait for the next time the engine gets processed
+			if (!engine.fuel && !engine.refuel())
+				return Engine::NO_TARGET;
+			return engine.context.pointers.instruction;
+		}
+
+		/// @brief Reads the instruction's immediate as a given type, and moves past it (same as the engine does).
+		template <class T>
+		static T immediate(Engine& engine, usize const at) {
+			engine.context.pointers.instruction	= at + 1;
+			engine.current						= engine.decoded.cbegin()[at + 1].instruction;
+			T value;
+			MX::memcpy(&value, &engine.current, sizeof(T));
+			return value;
+		}
+
+		template <Core::Operator O, class T>
+		static void apply(T& lhs, T const& rhs) {
+			if constexpr (O == Core::Operator::AV2_BOP_ADD)			lhs += rhs;
+			else if constexpr (O == Core::Operator::AV2_BOP_SUB)	lhs -= rhs;
+			else if constexpr (O == Core::Operator::AV2_BOP_MUL)	lhs *= rhs;
+		}
+
+		/// @brief Compares two values (same as the engine does).
+		template <Core::Comparator C, class T>
+		static int8 order(T const& lhs, T const& rhs) {
+			using enum Core::Comparator;
+			if constexpr (C == AV2_OP_THREEWAY)				return lhs < rhs ? -1 : (lhs > rhs);
+			else if constexpr (C == AV2_OP_EQUALS)			return lhs == rhs;
+			else if constexpr (C == AV2_OP_NOT_EQUALS)		return lhs != rhs;
+			else if constexpr (C == AV2_OP_GREATER_THAN)	return lhs > rhs;
+			else if constexpr (C == AV2_OP_GREATER_EQUALS)	return lhs >= rhs;
+			else if constexpr (C == AV2_OP_LESS_THAN)		return lhs < rhs;
+			else if constexpr (C == AV2_OP_LESS_EQUALS)		return lhs <= rhs;
+			else return 0;
+		}
+	};
+
+	struct Precompiled::Library: Core::ALibrary {
+		Library(Precompiled const& code): code(code) {}
+
+		void load(Core::Context::Adder const& context) override {}
+
+		ref<Precompiled const> precompiled() const override {return &code;}
+
+	private:
+		Precompiled const code;
+	};
+}
+
+#endif
@@ -0,0 +1,164 @@
+#include "profiler.hpp"
+
+using Makai::Anima::V2::Runtime::Profiler;
+
+using namespace Makai::Anima::V2;
+
+using namespace Core;
+
+Profiler::Profiler(Module const& program) {
+	for (auto const& method: program.detail.methods) {
+		if (!method.name.size()) continue;
+		if (method.flags.isExternal)
+			nativeNames[method.hash] = method.name.toString();
+		else if (method.entrypoint < program.jumpTable.size())
+			names[program.jumpTable[method.entrypoint]] = method.name.toString();
+	}
+	if (program.ani)
+		for (auto const& [name, id]: program.ani->in)
+			if (id < program.jumpTable.size() && !names.contains(program.jumpTable[id]))
+				names[program.jumpTable[id]] = name;
+	functions.pushBack({"<main>"});
+	depths.pushBack(0);
+	nodes.pushBack({ROOT});
+}
+
+usize Profiler::now() {
+	return OS::Time::Clock::sinceStart<OS::Time::Nanos>();
+}
+
+void Profiler::begin() {
+	++functions[ROOT].calls;
+	++depths[ROOT];
+	frames.pushBack({ROOT, now()});
+}
+
+usize Profiler::functionAt(usize const entry) {
+	if (functionByEntry.contains(entry))
+		return functionByEntry[entry];
+	auto const index = functions.size();
+	functions.pushBack({names.contains(entry) ? names[entry] : ("@" + toString(entry)), entry});
+	depths.pushBack(0);
+	functionByEntry[entry] = index;
+	return index;
+}
+
+usize Profiler::child(usize const function) {
+	if (nodes[current].children.contains(function))
+		return nodes[current].children[function];
+	auto const index = nodes.size();
+	nodes.pushBack({function, current});
+	nodes[current].children[function] = index;
+	return index;
+}
+
+void Profiler::enter(usize const entry) {
+	auto const function	= functionAt(entry);
+	current				= child(function);
+	++functions[function].calls;
+	++depths[function];
+	frames.pushBack({current, now()});
+}
+
+void Profiler::leave() {
+	// The top level only ends once the program does
+	if (frames.size() < 2) return;
+	unwind();
+}
+
+void Profiler::unwind() {
+	if (frames.empty()) return;
+	auto const frame	= frames.popBack();
+	auto const elapsed	= now() - frame.start;
+	auto& node			= nodes[frame.node];
+	auto& function		= functions[node.function];
+	node.time			+= elapsed;
+	function.exclusive	+= elapsed - frame.callees;
+	// Recursive calls are already part of the outermost call's time
+	if (!--depths[node.function])
+		function.inclusive += elapsed;
+	if (frames.empty()) return;
+	frames.back().callees	+= elapsed;
+	current					= frames.back().node;
+}
+
+void Profiler::native(uint64 const hash, usize const start) {
+	auto const elapsed = now() - start;
+	if (!nativeByHash.contains(hash)) {
+		nativeByHash[hash] = natives.size();
+		natives.pushBack({nativeNames.contains(hash) ? nativeNames[hash] : ("native@" + toString(hash)), hash});
+	}
+	auto const index	= nativeByHash[hash];
+	auto& function		= natives[index];
+	++function.calls;
+	function.time		+= elapsed;
+	nodes[child(index | NATIVE_BIT)].time += elapsed;
+	if (frames.size())
+		frames.back().callees += elapsed;
+}
+
+Makai::String Profiler::nameOf(Node const& node) const {
+	if (node.function & NATIVE_BIT)
+		return natives[node.function & ~NATIVE_BIT].name;
+	return functions[node.function].name;
+}
+
+Makai::Data::Value Profiler::report() const {
+	Profiler profile = *this;
+	while (profile.frames.size())
+		profile.unwind();
+	List<usize> instructions(profile.functions.size(), usize(0));
+	for (auto const& node: profile.nodes)
+		if (!(node.function & NATIVE_BIT))
+			instructions[node.function] += node.instructions;
+	auto result = Data::Value::object();
+	result["time"]		= profile.nodes[ROOT].time;
+	result["opcodes"]	= result.object();
+	result["functions"]	= result.array();
+	result["natives"]	= result.array();
+	auto& opcodes	= result["opcodes"];
+	auto& functions	= result["functions"];
+	auto& natives	= result["natives"];
+	for (usize i = 0; i < sizeof(profile.opcodes) / sizeof(usize); ++i)
+		if (profile.opcodes[i])
+			opcodes[Instruction::asString(static_cast<Instruction::Name>(i))] = profile.opcodes[i];
+	for (auto const& [function, i]: Range::expand(profile.functions)) {
+		auto entry = Data::Value::object();
+		entry["name"]			= function.name;
+		entry["entry"]			= function.entry;
+		entry["calls"]			= function.calls;
+		entry["instructions"]	= instructions[i];
+		entry["inclusive"]		= function.inclusive;
+		entry["exclusive"]		= function.exclusive;
+		functions[functions.size()] = entry;
+	}
+	for (auto const& function: profile.natives) {
+		auto entry = Data::Value::object();
+		entry["name"]	= function.name;
+		entry["hash"]	= function.hash;
+		entry["calls"]	= function.calls;
+		entry["time"]	= function.time;
+		natives[natives.size()] = entry;
+	}
+	return result;
+}
+
+Makai::String Profiler::stacks() const {
+	Profiler profile = *this;
+	while (profile.frames.size())
+		profile.unwind();
+	String result;
+	for (auto const& node: profile.nodes) {
+		usize self = node.time;
+		for (auto const& [function, child]: node.children)
+			self -= profile.nodes[child].time;
+		if (!self) continue;
+		String path = profile.nameOf(node);
+		for (auto parent = &node; parent != &profile.nodes[ROOT];) {
+			parent	= &profile.nodes[parent->parent];
+			path	= profile.nameOf(*parent) + ";" + path;
+		}
+		result += path + " " + toString(self) + "\n";
+	}
+	return result;
+}
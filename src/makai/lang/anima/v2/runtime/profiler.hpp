@@ -0,0 +1,122 @@
+#ifndef MAKAILIB_ANIMA_V2_RUNTIME_PROFILER_H
+#define MAKAILIB_ANIMA_V2_RUNTIME_PROFILER_H
+
+#include "../../../../compat/ctl.hpp"
+#include "../core/module.hpp"
+
+namespace Makai::Anima::V2::Runtime {
+	/// @brief Instrumenting profiler for running programs.
+	/// @details
+	///		Counts executed instructions per opcode and per call path,
+	///		and times every call frame the engine pushes, as well as every native function call.
+	///
+	///		Times are measured in nanoseconds.
+	struct Profiler {
+		/// @brief Per-function statistics.
+		struct Function {
+			/// @brief Function name.
+			String	name;
+			/// @brief Instruction the function starts at.
+			usize	entry			= 0;
+			/// @brief Times the function got called.
+			usize	calls			= 0;
+			/// @brief Instructions executed directly by the function.
+			usize	instructions	= 0;
+			/// @brief Time spent in the function, including the functions it calls.
+			usize	inclusive		= 0;
+			/// @brief Time spent in the function, excluding the functions it calls.
+			usize	exclusive		= 0;
+		};
+
+		/// @brief Per-native-function statistics.
+		struct NativeFunction {
+			/// @brief Function name.
+			String	name;
+			/// @brief Function hash.
+			uint64	hash	= 0;
+			/// @brief Times the function got called.
+			usize	calls	= 0;
+			/// @brief Time spent in the function.
+			usize	time	= 0;
+		};
+
+		/// @brief Constructs the profiler.
+		/// @param program Program to profile. Used to name functions.
+		Profiler(Core::Module const& program);
+
+		/// @brief Starts timing the program's top level.
+		void begin();
+
+		/// @brief Counts an executed instruction.
+		/// @param name Instruction opcode.
+		void step(Core::Instruction::Name const name) {
+			++opcodes[enumcast(name)];
+			++nodes[current].instructions;
+		}
+
+		/// @brief Records a call frame getting pushed.
+		/// @param entry Instruction the call jumps to.
+		void enter(usize const entry);
+
+		/// @brief Records a call frame getting popped.
+		void leave();
+
+		/// @brief Records a native function call.
+		/// @param hash Native function hash.
+		/// @param start When the call started, as returned by `now`.
+		void native(uint64 const hash, usize const start);
+
+		/// @brief Returns the current time.
+		/// @return Current time.
+		static usize now();
+
+		/// @brief Returns the gathered statistics, with any unfinished frames timed up to now.
+		/// @return Statistics, as opcode, function and native function tables.
+		Data::Value report() const;
+
+		/// @brief Returns the time spent in every call path, in the collapsed stack format flamegraph tools take.
+		/// @return Collapsed stacks, one path per line.
+		String stacks() const;
+
+	private:
+		constexpr static usize ROOT			= 0;
+		constexpr static usize NATIVE_BIT	= usize(1) << (sizeof(usize) * 8 - 1);
+
+		/// @brief Call path, as a node of the call tree.
+		struct Node {
+			/// @brief Function index, or native function index with `NATIVE_BIT` set.
+			usize				function;
+			usize				parent			= ROOT;
+			usize				instructions	= 0;
+			usize				time			= 0;
+			Map<usize, usize>	children;
+		};
+
+		struct Frame {
+			usize	node;
+			usize	start;
+			/// @brief Time spent in callees.
+			usize	callees	= 0;
+		};
+
+		usize functionAt(usize const entry);
+		usize child(usize const function);
+		void unwind();
+
+		String nameOf(Node const& node) const;
+
+		Map<usize, String>			names;
+		Map<uint64, String>			nativeNames;
+		List<Function>				functions;
+		Map<usize, usize>			functionByEntry;
+		List<usize>					depths;
+		List<NativeFunction>		natives;
+		Map<uint64, usize>			nativeByHash;
+		List<Node>					nodes;
+		List<Frame>					frames;
+		usize						current	= ROOT;
+		usize						opcodes[enumcast(Core::Instruction::Name::AV2_IN_BREAKPOINT) + 1] = {};
+	};
+}
+
+#endif
@@ -3,6 +3,10 @@
 
 #include "context.hpp"
 #include "engine.hpp"
+#include "group.hpp"
+#include "jit.hpp"
 #include "module.hpp"
+#include "precompiled.hpp"
+#include "profiler.hpp"
 
 #endif
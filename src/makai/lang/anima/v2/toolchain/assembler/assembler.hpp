@@ -5,5 +5,7 @@
 #include "context.hpp"
 #include "minima.hpp"
 #include "semibreve.hpp"
+#include "optimizer.hpp"
+#include "statistics.hpp"
 
 #endif
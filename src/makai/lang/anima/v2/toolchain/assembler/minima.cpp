@@ -1,4 +1,5 @@
 #include "minima.hpp"
+#include "statistics.hpp"
 #include "../../core/method.hpp"
 
 using namespace Makai::Anima::V2::Core;
@@ -35,6 +36,8 @@ Makai::String Context::fullModulePath() const {
 void Context::addMethod(Makai::String const& name, Instance<Method> const& method) {
 	if (methods.contains(name))
 		error("Method with this name already exists!");
+	if (method->name.empty())
+		method->name = name;
 	auto const fullID = name + "@" + method->name;
 	moduleMethods[fullID] = method;
 	methods[name] = new Reference{.name = fullID};
@@ -136,8 +139,7 @@ usize Context::update(usize const inst, uint32 const type) {
 }
 
 uint64 Context::addGlobal(String const& name) {
-	program.strings.pushBack(name);
-	return program.strings.size()-1;
+	return addStringLiteral(name);
 }
 
 void Context::addJumpTarget(String const& name, Context::JumpMode const mode) {
@@ -604,8 +606,8 @@ static void doJump(Context& context, bool dynamic = false) {
 	}
 }
 
-static void doCall(Context& context, bool dynamic = false) {
-	Instruction::Invocation invoke {.dynamic = dynamic};
+static void doCall(Context& context, bool dynamic = false, bool tail = false) {
+	Instruction::Invocation invoke {.dynamic = dynamic, .tail = tail};
 	if (!dynamic) {
 		context.next();
 		auto id = resolvePath(context);
@@ -698,7 +700,7 @@ static void doReturn(Context& context) {
 }
 
 static void doStackClear(Context& context) {
-	Instruction::StackClear clear;
+	Instruction::StackClear clear{};
 	clear.count = context.getNext(LTS_TT_INTEGER).getUnsigned();
 	if (context.peek().type == LTS_TT_OPEN_BRACKET) {
 		clear.offset =
@@ -870,7 +872,7 @@ static void doContext(Context& context, bool immediate = false) {
 }
 
 static void doOperation(Context& context) {
-	Instruction::Operation bop;
+	Instruction::Operation bop{};
 	bop.count = 1;
 	auto const op = context.getNext(LTS_TT_IDENTIFIER, "unary operation name").getString();
 	Makai::Data::Value value;
@@ -888,6 +890,8 @@ static void doOperation(Context& context) {
 	else if (op == "pow")	bop.op = Operator::AV2_BOP_POW;
 	else if (op == "atan2")	bop.op = Operator::AV2_BOP_ATAN2;
 	else if (op == "apush")	bop.op = Operator::AV2_BOP_PUSH;
+	else if (op == "afill")	bop.op = Operator::AV2_BOP_FILL;
+	else if (op == "acopy")	bop.op = Operator::AV2_BOP_COPY;
 	else if (op == "neg")	bop.op = Operator::AV2_UOP_NEGATE;
 	else if (op == "inc")	bop.op = Operator::AV2_UOP_INCREMENT;
 	else if (op == "dec")	bop.op = Operator::AV2_UOP_DECREMENT;
@@ -908,6 +912,7 @@ static void doOperation(Context& context) {
 	else if (op == "lnot")	bop.op = Operator::AV2_UOP_LOGIC_NOT;
 	else if (op == "bnot")	bop.op = Operator::AV2_UOP_BIT_NOT;
 	else if (op == "apop")	bop.op = Operator::AV2_UOP_POP;
+	else if (op == "asum")	bop.op = Operator::AV2_UOP_SUM;
 	else context.error("Invalid/Unsupported operation!");
 	if (context.peek().type == LTS_TT_LESS_THAN) {
 		bop.sameType = true;
@@ -986,7 +991,7 @@ static void doOperation(Context& context) {
 
 static void doCompare(Context& context) {
 	auto const id = context.getNext(LTS_TT_IDENTIFIER, "comparison").getString();
-	Instruction::Comparison cmp;
+	Instruction::Comparison cmp{};
 	Makai::Data::Value value;
 	if (id == "less" || id == "l")					cmp.comp = Comparator::AV2_OP_LESS_THAN;
 	else if (id == "greater" || id == "g")			cmp.comp = Comparator::AV2_OP_GREATER_THAN;
@@ -1136,7 +1141,7 @@ static void doUnsafeCast(Context& context, bool const dyn = false) {
 }
 
 static void doRandomNumber(Context& context) {
-	Instruction::Randomness rng;
+	Instruction::Randomness rng{};
 	auto id = context.getNext(LTS_TT_IDENTIFIER, "RNG operation").getString();
 	if (id == "setseed")		rng.setSeed					= true;
 	else if (id == "getseed")	rng.getSeed					= true;
@@ -1177,6 +1182,19 @@ static void doDynamic(Context& context) {
 	else context.error("Invalid dynamic operation!");
 }
 
+static void doTail(Context& context) {
+	auto const id = context.getNext(LTS_TT_IDENTIFIER, "tail operation").getString();
+	if (id == "call" || id == "do")
+		doCall(context, false, true);
+	else if (id == "dynamic" || id == "dyn") {
+		auto const op = context.getNext(LTS_TT_IDENTIFIER, "dynamic tail operation").getString();
+		if (op == "call" || op == "do")
+			doCall(context, true, true);
+		else context.error("Invalid dynamic tail operation!");
+	}
+	else context.error("Invalid tail operation!");
+}
+
 static void doSelect(Context& context) {
 	Instruction::Selection select = {.mode = context.globalJumpMode};
 	auto const inst = context.add(Instruction::Name::AV2_IN_SELECT);
@@ -1279,7 +1297,8 @@ static void validateType(Context& context, Context::Declaration& type) {
 	if (!type.basic) {
 		if (type.alignment && !(type.flags.isValueType))
 			context.error("Only value types can have alignment size!");
-		if (!type.alignment && type.flags.isValueType)
+		// Value arrays take their alignment from their elements
+		if (!type.alignment && type.flags.isValueType && !type.flags.isArray)
 			context.error("Value types must have an alignment!");
 	}
 	if (type.flags.isValueType) {
@@ -1290,7 +1309,7 @@ static void validateType(Context& context, Context::Declaration& type) {
 				context.error("Value types cannot contain arrays!");
 		}
 		if (type.flags.isArray) {
-			if (!(context.getTypeByID(*type.base)->flags.isArray))
+			if (context.getTypeByID(*type.base)->flags.isArray)
 				context.error("Value arrays of other arrays are forbidden!");
 			if (!(context.getTypeByID(*type.base)->flags.isValueType))
 				context.error("Value arrays can only contain value types!");
@@ -1379,13 +1398,13 @@ static void declareTypeMeta(Context& context, Context::Declaration& type) {
 	while (true) {
 		if (context.next().has(Type{']'})) break;
 		auto const key = resolvePath(context);
-		if (type.meta.contains(key))
+		if (type.meta.get().contains(key))
 			context.error("Meta attribute has already been declared!");
 		context.next();
 		if (context.has(LTS_TT_BACKTICK_STRING))
-			type.meta[key] = Makai::FLOW::parse(context.get(LTS_TT_BACKTICK_STRING).getString());
+			type.meta.get()[key] = Makai::FLOW::parse(context.get(LTS_TT_BACKTICK_STRING).getString());
 		else if (context.has(LTS_TT_BANG))
-			type.meta[key] = Makai::FLOW::Value::object();
+			type.meta.get()[key] = Makai::FLOW::Value::object();
 		else context.error("Expected attribute value or '.' here!");
 	}
 }
@@ -1672,6 +1691,7 @@ static void declareMethodBody(Context& context) {
 			context.error("Missing method body!");
 		auto const method = context.methodStack.popBack();
 		method->size = context.program.code.size() - method->size;
+		context.program.detail.methods[method->id].size = method->size;
 	} else {
 		auto const name = resolvePath(context);
 		if (!context.methods.contains(name))
@@ -1685,6 +1705,7 @@ static void declareMethodBody(Context& context) {
 		context.registerLandingPoint(method->jump);
 		method->entrypoint = context.jumps[method->jump];
 		method->size = context.program.code.size();
+		context.program.detail.methods[method->id].entrypoint = method->entrypoint;
 		context.expectNext(LTS_TT_COLON);
 	}
 }
@@ -1848,6 +1869,7 @@ static void doExpression(Context& context) {
 	else if (id == "terminate" || id == "stop")	doHalt(context);
 	else if (id == "error")						doHalt(context, true);
 	else if (id == "call" || id == "do")		doCall(context);
+	else if (id == "tail")						doTail(context);
 	else if (id == "compare" || id == "cmp")	doCompare(context);
 	else if (id == "enter" || id == "begin")	doScopeEnter(context);
 	else if (id == "exit" || id == "end")		doScopeExit(context);
@@ -1911,18 +1933,22 @@ Makai::Anima::V2::Core::Module Minima::assemble(
 	UTF8String const& file,
 	bool const strip
 ) {
-	Makai::Lexer::CStyle::TokenStream stream;
-	stream.open(file);
-	Makai::List<Assembler::BaseContext::Axiom> ax;
 	Assembler::Minima::Context ctx;
-	while (stream.next())
-		ax.pushBack({stream.current(), true, fname});
-	if (!stream.ok())
-		throw Makai::Error::InvalidValue(
-			"Parsing failure!",
-			stream.error().value().what
-		);
-	ctx.put(ax);
+	{
+		Statistics::Scope const pass("assemble:lex", fname);
+		Makai::Lexer::CStyle::TokenStream stream;
+		stream.open(file);
+		Makai::List<Assembler::BaseContext::Axiom> ax;
+		while (stream.next())
+			ax.pushBack({stream.current(), true, fname});
+		if (!stream.ok())
+			throw Makai::Error::InvalidValue(
+				"Parsing failure!",
+				stream.error().value().what
+			);
+		ctx.put(ax);
+	}
+	Statistics::Scope const pass("assemble", fname);
 	Assembler::Minima minAsm(ctx);
 	minAsm.invoke();
 	MAKAILIB_DEBUGLN_FULL("Total types: ", ctx.program.sym.types.size());
@@ -0,0 +1,479 @@
+#include "optimizer.hpp"
+
+using namespace Makai::Anima::V2::Core;
+
+using namespace Makai::Anima::V2::Toolchain::Assembler;
+
+using Level		= Optimizer::Level;
+using Name		= Instruction::Name;
+
+using enum ValueLocation::Source;
+
+constexpr static usize MAX_THREADING_DEPTH = 16;
+
+/// Decoded bytecode layout.
+struct Layout {
+	/// Module being optimized.
+	Module&				program;
+	/// Instruction size, for every word that starts an instruction. Zero for operand words.
+	Makai::List<usize>	sizes;
+	/// Whether a jump can resume execution at a given word.
+	Makai::List<bool>	entries;
+	/// Whether every place execution can jump to is known.
+	bool				complete	= true;
+};
+
+/// Literal value pushed to the stack.
+struct Literal {
+	BasicType	type;
+	uint64		value;
+};
+
+static bool isFreeNoOp(Instruction const& inst) {
+	return inst.name == Name::AV2_IN_NO_OP && inst.type;
+}
+
+/// Returns how the instruction's target is encoded, if it always jumps to the same place.
+static Makai::Nullable<JumpMode> staticTargetMode(Instruction const& inst) {
+	if (inst.name == Name::AV2_IN_JUMP) {
+		auto const leap = inst.getTypeAs<Instruction::Leap>();
+		if (!leap.dyn) return leap.mode;
+	} else if (inst.name == Name::AV2_IN_CALL) {
+		auto const invocation = inst.getTypeAs<Instruction::Invocation>();
+		if (!(invocation.dynamic || invocation.external)) return JumpMode::AV2_JM_TABLE_INDEX;
+	}
+	return null;
+}
+
+static bool isUnconditionalJump(Instruction const& inst) {
+	if (inst.name != Name::AV2_IN_JUMP) return false;
+	auto const leap = inst.getTypeAs<Instruction::Leap>();
+	return leap.type == Instruction::Leap::Type::AV2_ILT_UNCONDITIONAL && !leap.invert;
+}
+
+static bool endsFlow(Instruction const& inst) {
+	switch (inst.name) {
+		case Name::AV2_IN_HALT:
+		case Name::AV2_IN_RETURN:	return true;
+		case Name::AV2_IN_JUMP:		return isUnconditionalJump(inst);
+		default:					return false;
+	}
+}
+
+/// Returns where a jump or call resolves to. Execution resumes at the word after it.
+static Makai::Nullable<usize> targetOf(Module const& program, usize const at, JumpMode const mode) {
+	auto const size		= program.code.size();
+	auto const location	= Makai::Cast::bit<uint64>(program.code[at + 1]);
+	switch (mode) {
+		case JumpMode::AV2_JM_TABLE_INDEX:
+			if (location < program.jumpTable.size() && program.jumpTable[location] < size)
+				return program.jumpTable[location];
+		break;
+		case JumpMode::AV2_JM_ABSOLUTE:
+			if (location < size)
+				return location;
+		break;
+		case JumpMode::AV2_JM_RELATIVE: {
+			auto const to = (at + 1) + Makai::Cast::bit<int64>(location);
+			if (to < size)
+				return to;
+		} break;
+	}
+	return null;
+}
+
+static void retarget(Module& program, usize const at, JumpMode const mode, usize const to) {
+	uint64 location = to;
+	switch (mode) {
+		case JumpMode::AV2_JM_TABLE_INDEX: {
+			auto const index = program.jumpTable.find(to);
+			if (index == -1) {
+				location = program.jumpTable.size();
+				program.jumpTable.pushBack(to);
+			} else location = index;
+		} break;
+		case JumpMode::AV2_JM_ABSOLUTE: break;
+		case JumpMode::AV2_JM_RELATIVE:
+			location = Makai::Cast::bit<uint64>(Makai::Cast::as<int64>(to) - Makai::Cast::as<int64>(at + 1));
+		break;
+	}
+	program.code[at + 1] = Makai::Cast::bit<Instruction>(location);
+}
+
+static bool decode(Layout& layout) {
+	auto const& program	= layout.program;
+	auto const size		= program.code.size();
+	auto const markEntry = [&] (usize const to) {
+		if (to < size) layout.entries[to + 1] = true;
+		else layout.complete = false;
+	};
+	layout.sizes	= Makai::List<usize>(size, usize(0));
+	layout.entries	= Makai::List<bool>(size + 1, false);
+	layout.entries[0] = true;
+	for (usize i = 0; i < size;) {
+		auto const& inst	= program.code[i];
+		auto const length	= inst.size();
+		if (!length || (i + *length) > size) {
+			MAKAILIB_DEBUGLN_FULL("Cannot decode instruction at [", i, "]!");
+			return false;
+		}
+		layout.sizes[i] = *length;
+		if (
+			inst.name == Name::AV2_IN_SELECT
+		&&	inst.getTypeAs<Instruction::Selection>().mode != JumpMode::AV2_JM_TABLE_INDEX
+		) layout.complete = false;
+		if (inst.name == Name::AV2_IN_JUMP) {
+			auto const leap = inst.getTypeAs<Instruction::Leap>();
+			if (leap.dyn && leap.mode != JumpMode::AV2_JM_TABLE_INDEX)
+				layout.complete = false;
+		}
+		if (auto const mode = staticTargetMode(inst)) {
+			if (auto const to = targetOf(program, i, *mode))
+				markEntry(*to);
+			else layout.complete = false;
+		}
+		i += *length;
+	}
+	for (auto const to: program.jumpTable)
+		markEntry(to);
+	for (usize i = 0; i < size; ++i)
+		if (layout.entries[i] && !layout.sizes[i]) {
+			MAKAILIB_DEBUGLN_FULL("Jump into the middle of instruction at [", i, "]!");
+			return false;
+		}
+	return true;
+}
+
+/// Turns an instruction (and its operands) into free no-ops.
+static void erase(Layout& layout, usize const at) {
+	auto const length = layout.sizes[at];
+	for (usize i = at; i < at + length; ++i) {
+		layout.program.code[i]	= {Name::AV2_IN_NO_OP, 1};
+		layout.sizes[i]			= 1;
+	}
+}
+
+/// Returns the first instruction that is not a free no-op, starting at a given word.
+static usize skipNoOps(Layout const& layout, usize at) {
+	auto const& code = layout.program.code;
+	while (at < code.size() && isFreeNoOp(code[at])) ++at;
+	return at;
+}
+
+/// Returns the instruction executed right after a given one, if nothing else can jump to it.
+static Makai::Nullable<usize> successor(Layout const& layout, usize const at) {
+	auto const& code = layout.program.code;
+	auto next = at + layout.sizes[at];
+	while (next < code.size() && !layout.entries[next] && isFreeNoOp(code[next])) ++next;
+	if (next < code.size() && !layout.entries[next])
+		return next;
+	return null;
+}
+
+template <class T>
+static T lowBytesAs(uint64 const word) {
+	T value;
+	Makai::MX::memcpy(&value, &word, sizeof(T));
+	return value;
+}
+
+template <class T>
+static uint64 asLowBytes(T const value) {
+	uint64 word = 0;
+	Makai::MX::memcpy(&word, &value, sizeof(T));
+	return word;
+}
+
+static Makai::Nullable<Literal> literalOf(Module const& program, usize const at) {
+	auto const& inst = program.code[at];
+	if (inst.name != Name::AV2_IN_STACK_PUSH) return null;
+	auto const loc = inst.getTypeAs<Instruction::StackPush>().location;
+	switch (loc.desc.source) {
+		case AV2_VLS_BOOL: return Literal{BasicType::AV2_BT_BOOL, loc.forBool.flag};
+		case AV2_VLS_INT: {
+			auto const word		= Makai::Cast::bit<uint64>(program.code[at + 1]);
+			auto const isSigned	= !loc.forInt.isUnsigned;
+			switch (loc.forInt.size) {
+				using enum ValueLocation::ForInteger::Size;
+				case AV2_VL_IS_8_BIT:	return Literal{isSigned ? BasicType::AV2_BT_INT8 : BasicType::AV2_BT_UINT8, word};
+				case AV2_VL_IS_16_BIT:	return Literal{isSigned ? BasicType::AV2_BT_INT16 : BasicType::AV2_BT_UINT16, word};
+				case AV2_VL_IS_32_BIT:	return Literal{isSigned ? BasicType::AV2_BT_INT32 : BasicType::AV2_BT_UINT32, word};
+				case AV2_VL_IS_64_BIT:	return Literal{isSigned ? BasicType::AV2_BT_INT64 : BasicType::AV2_BT_UINT64, word};
+			}
+		} break;
+		case AV2_VLS_REAL: {
+			auto const word = Makai::Cast::bit<uint64>(program.code[at + 1]);
+			switch (loc.forReal.size) {
+				using enum ValueLocation::ForReal::Size;
+				case AV2_VL_RS_64_BIT:	return Literal{BasicType::AV2_BT_REAL64, word};
+				case AV2_VL_RS_128_BIT:	return null;
+				default:				return Literal{BasicType::AV2_BT_REAL32, word};
+			}
+		} break;
+		default: break;
+	}
+	return null;
+}
+
+/// Overwrites the value a literal push instruction pushes.
+static void setLiteral(Module& program, usize const at, uint64 const value) {
+	auto push = program.code[at].getTypeAs<Instruction::StackPush>();
+	if (push.location.desc.source == AV2_VLS_BOOL) {
+		push.location.forBool.flag = value;
+		program.code[at] = {Name::AV2_IN_STACK_PUSH, Makai::Cast::bit<uint32>(push)};
+	} else program.code[at + 1] = Makai::Cast::bit<Instruction>(value);
+}
+
+static usize integerSizeOf(BasicType const type) {
+	switch (type) {
+		case BasicType::AV2_BT_INT8:
+		case BasicType::AV2_BT_UINT8:	return 1;
+		case BasicType::AV2_BT_INT16:
+		case BasicType::AV2_BT_UINT16:	return 2;
+		case BasicType::AV2_BT_INT32:
+		case BasicType::AV2_BT_UINT32:	return 4;
+		case BasicType::AV2_BT_INT64:
+		case BasicType::AV2_BT_UINT64:	return 8;
+		default:						return 0;
+	}
+}
+
+template <class T>
+static Makai::Nullable<uint64> foldReal(Operator const op, uint64 const lhs, uint64 const rhs) {
+	auto const l = lowBytesAs<T>(lhs), r = lowBytesAs<T>(rhs);
+	switch (op) {
+		case Operator::AV2_BOP_ADD:	return asLowBytes<T>(l + r);
+		case Operator::AV2_BOP_SUB:	return asLowBytes<T>(l - r);
+		case Operator::AV2_BOP_MUL:	return asLowBytes<T>(l * r);
+		default:					return null;
+	}
+}
+
+/// Computes a binary operation the same way the engine's fast path does, if it can.
+static Makai::Nullable<uint64> fold(Operator const op, BasicType const type, uint64 const lhs, uint64 const rhs) {
+	if (type == BasicType::AV2_BT_BOOL) {
+		bool const l = lowBytesAs<uint8>(lhs), r = lowBytesAs<uint8>(rhs);
+		switch (op) {
+			case Operator::AV2_BOP_ADD:			return l || r;
+			case Operator::AV2_BOP_LOGIC_XOR:
+			case Operator::AV2_BOP_SUB:			return l != r;
+			case Operator::AV2_BOP_MUL:			return l && r;
+			default:							return null;
+		}
+	}
+	if (type == BasicType::AV2_BT_REAL32) return foldReal<float32>(op, lhs, rhs);
+	if (type == BasicType::AV2_BT_REAL64) return foldReal<float64>(op, lhs, rhs);
+	auto const size = integerSizeOf(type);
+	if (!size) return null;
+	// Two's complement, so wrapping unsigned arithmetic gives the same bits for signed values
+	uint64 result = 0;
+	switch (op) {
+		case Operator::AV2_BOP_ADD:	result = lhs + rhs; break;
+		case Operator::AV2_BOP_SUB:	result = lhs - rhs; break;
+		case Operator::AV2_BOP_MUL:	result = lhs * rhs; break;
+		default:					return null;
+	}
+	if (size < sizeof(uint64))
+		result &= (uint64(1) << (size * 8)) - 1;
+	return result;
+}
+
+static bool isFoldableOperation(Instruction const& inst, BasicType const type, bool const immediate) {
+	if (inst.name != Name::AV2_IN_OP) return false;
+	auto const op = inst.getTypeAs<Instruction::Operation>();
+	return (
+		op.sameType
+	&&	op.immediate == immediate
+	&&	op.assume == type
+	&&	op.op >= Operator::AV2_BOP_START
+	&&	op.op < Operator::AV2_TOP_START
+	);
+}
+
+static bool foldConstantAt(Layout& layout, usize const at) {
+	auto& program = layout.program;
+	auto const first = literalOf(program, at);
+	if (!first) return false;
+	auto const lhs	= *first;
+	auto const next	= successor(layout, at);
+	if (!next) return false;
+	auto const& inst = program.code[*next];
+	if (isFoldableOperation(inst, lhs.type, true)) {
+		auto const op		= inst.getTypeAs<Instruction::Operation>().op;
+		auto const result	= fold(op, lhs.type, lhs.value, Makai::Cast::bit<uint64>(program.code[*next + 1]));
+		if (!result) return false;
+		erase(layout, *next);
+		setLiteral(program, at, *result);
+		return true;
+	}
+	auto const second = literalOf(program, *next);
+	if (!second) return false;
+	auto const rhs	= *second;
+	auto const last	= successor(layout, *next);
+	if (rhs.type != lhs.type || !last || !isFoldableOperation(program.code[*last], lhs.type, false)) return false;
+	auto const op		= program.code[*last].getTypeAs<Instruction::Operation>().op;
+	auto const result	= fold(op, lhs.type, lhs.value, rhs.value);
+	if (!result) return false;
+	erase(layout, *last);
+	erase(layout, *next);
+	setLiteral(program, at, *result);
+	return true;
+}
+
+static void foldConstants(Layout& layout) {
+	for (usize i = 0; i < layout.program.code.size(); i += layout.sizes[i])
+		while (foldConstantAt(layout, i)) {}
+}
+
+static bool isPure(ValueLocation const loc) {
+	switch (loc.desc.source) {
+		case AV2_VLS_BOOL:
+		case AV2_VLS_INT:
+		case AV2_VLS_REAL:
+		case AV2_VLS_STRING:		return true;
+		case AV2_VLS_STACK:
+		case AV2_VLS_STACK_OFFSET:
+		case AV2_VLS_LOCAL:			return loc.forObject.transfer != ValueLocation::ForObject::Transfer::AV2_VL_OT_MOVE;
+		default:					return false;
+	}
+}
+
+static void cancelPushPops(Layout& layout) {
+	auto const& code = layout.program.code;
+	for (usize i = 0; i < code.size(); i += layout.sizes[i]) {
+		if (code[i].name != Name::AV2_IN_STACK_PUSH) continue;
+		if (!isPure(code[i].getTypeAs<Instruction::StackPush>().location)) continue;
+		auto const next = successor(layout, i);
+		if (!next || code[*next].name != Name::AV2_IN_STACK_POP) continue;
+		erase(layout, *next);
+		erase(layout, i);
+	}
+}
+
+static void threadJumps(Layout& layout) {
+	auto& program		= layout.program;
+	auto const& code	= program.code;
+	for (usize i = 0; i < code.size(); i += layout.sizes[i]) {
+		if (code[i].name != Name::AV2_IN_JUMP) continue;
+		auto const mode = staticTargetMode(code[i]);
+		if (!mode) continue;
+		auto const start = targetOf(program, i, *mode);
+		if (!start) continue;
+		auto to = *start;
+		for (usize depth = 0; depth < MAX_THREADING_DEPTH; ++depth) {
+			auto const landing = skipNoOps(layout, to + 1);
+			if (landing >= code.size() || landing == i || !isUnconditionalJump(code[landing])) break;
+			auto const landingMode = staticTargetMode(code[landing]);
+			if (!landingMode) break;
+			auto const next = targetOf(program, landing, *landingMode);
+			if (!next || *next == to) break;
+			to = *next;
+		}
+		// Jumps to what would run next anyway do nothing
+		if (
+			isUnconditionalJump(code[i])
+		&&	skipNoOps(layout, to + 1) == skipNoOps(layout, i + layout.sizes[i])
+		) {
+			erase(layout, i);
+			continue;
+		}
+		if (to != *start)
+			retarget(program, i, *mode, to);
+	}
+}
+
+static void removeDeadCode(Layout& layout) {
+	auto const& code = layout.program.code;
+	for (usize i = 0; i < code.size(); i += layout.sizes[i]) {
+		if (!endsFlow(code[i])) continue;
+		auto next = i + layout.sizes[i];
+		while (next < code.size() && !layout.entries[next]) {
+			auto const length = layout.sizes[next];
+			erase(layout, next);
+			next += length;
+		}
+	}
+}
+
+static void compact(Layout& layout) {
+	auto& program		= layout.program;
+	auto const size		= program.code.size();
+	// The first word is always kept, so jumps to the start of the program still have somewhere to land
+	auto const keep = [&] (usize const at) {
+		return !at || !(layout.sizes[at] && isFreeNoOp(program.code[at]));
+	};
+	// Where each word (and the end of the program) ends up
+	Makai::List<usize> moved(size + 1, usize(0));
+	usize kept = 0;
+	for (usize i = 0; i < size; ++i) {
+		moved[i] = kept;
+		if (keep(i)) ++kept;
+	}
+	moved[size] = kept;
+	if (kept == size) return;
+	auto const relocate = [&] (usize const to) -> usize {
+		return moved[to + 1] - 1;
+	};
+	for (usize i = 0; i < size; i += layout.sizes[i]) {
+		auto const mode = staticTargetMode(program.code[i]);
+		if (!mode || *mode == JumpMode::AV2_JM_TABLE_INDEX) continue;
+		auto const to = targetOf(program, i, *mode);
+		if (!to) continue;
+		auto const target = relocate(*to);
+		program.code[i + 1] = Makai::Cast::bit<Instruction>(
+			*mode == JumpMode::AV2_JM_ABSOLUTE
+		?	Makai::Cast::as<uint64>(target)
+		:	Makai::Cast::bit<uint64>(Makai::Cast::as<int64>(target) - Makai::Cast::as<int64>(moved[i + 1]))
+		);
+	}
+	for (auto& method: program.detail.methods) {
+		if (method.flags.isExternal || !(method.entrypoint < program.jumpTable.size())) continue;
+		auto const start	= program.jumpTable[method.entrypoint];
+		auto const end		= start + method.size;
+		if (!(start < size && end <= size)) continue;
+		method.size = moved[end] - relocate(start);
+	}
+	for (auto& to: program.jumpTable)
+		if (to < size) to = relocate(to);
+	Makai::List<uint64> relocations;
+	for (auto const at: program.relocations)
+		if (at < size && keep(at))
+			relocations.pushBack(moved[at]);
+	program.relocations = relocations;
+	Bytecode code;
+	code.reserve(kept);
+	for (usize i = 0; i < size; ++i)
+		if (keep(i)) code.pushBack(program.code[i]);
+	MAKAILIB_DEBUGLN_FULL("Compacted ", size, " words into ", kept, " words");
+	program.code = code;
+}
+
+Module Optimizer::optimize(Module program, Level const level) {
+	if (level == Level::AV2_TCA_OL_NONE) return program;
+	Layout layout{program};
+	if (!decode(layout)) return program;
+	foldConstants(layout);
+	cancelPushPops(layout);
+	threadJumps(layout);
+	if (level == Level::AV2_TCA_OL_FULL && layout.complete) {
+		removeDeadCode(layout);
+		compact(layout);
+	}
+	return program;
+}
+
+Makai::Nullable<Level> Optimizer::levelFromName(Makai::String const& name) {
+	if (name == "none"	|| name == "0")	return Level::AV2_TCA_OL_NONE;
+	if (name == "basic"	|| name == "1")	return Level::AV2_TCA_OL_BASIC;
+	if (name == "full"	|| name == "2")	return Level::AV2_TCA_OL_FULL;
+	return null;
+}
+
+Makai::String Optimizer::nameOf(Level const level) {
+	switch (level) {
+		case Level::AV2_TCA_OL_NONE:	return "none";
+		case Level::AV2_TCA_OL_BASIC:	return "basic";
+		case Level::AV2_TCA_OL_FULL:	return "full";
+	}
+	return "none";
+}
@@ -0,0 +1,41 @@
+#ifndef MAKAILIB_ANIMA_V2_TOOLCHAIN_ASSEMBLER_OPTIMIZER_H
+#define MAKAILIB_ANIMA_V2_TOOLCHAIN_ASSEMBLER_OPTIMIZER_H
+
+#include "../../core/module.hpp"
+
+namespace Makai::Anima::V2::Toolchain::Assembler {
+	/// @brief Peephole optimizer for assembled modules.
+	/// @details
+	///		Works directly on the module's bytecode, so it can run on the output of any assembler.
+	///		If the bytecode contains anything the optimizer cannot fully make sense of,
+	///		passes that would need to get it right are skipped.
+	struct Optimizer {
+		/// @brief Optimization level.
+		enum class Level: uint8 {
+			/// @brief Does nothing.
+			AV2_TCA_OL_NONE,
+			/// @brief Rewrites instructions in place (push/pop cancellation, constant folding, jump threading).
+			AV2_TCA_OL_BASIC,
+			/// @brief Basic optimizations, plus dead code removal and no-op compaction.
+			AV2_TCA_OL_FULL,
+		};
+
+		/// @brief Optimizes a module.
+		/// @param program Module to optimize.
+		/// @param level Optimization level.
+		/// @return Optimized module.
+		static Core::Module optimize(Core::Module program, Level const level = Level::AV2_TCA_OL_FULL);
+
+		/// @brief Returns the optimization level for a given name.
+		/// @param name Level name (`none`/`0`, `basic`/`1`, `full`/`2`).
+		/// @return Optimization level, or `null` if name is invalid.
+		static Nullable<Level> levelFromName(String const& name);
+
+		/// @brief Returns the name of a given optimization level.
+		/// @param level Optimization level.
+		/// @return Level name.
+		static String nameOf(Level const level);
+	};
+}
+
+#endif
@@ -0,0 +1,105 @@
+#include "statistics.hpp"
+
+#if (CTL_TARGET_OS == CTL_OS_WINDOWS)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+using Makai::Anima::V2::Toolchain::Assembler::Statistics;
+
+static usize now() {
+	return Makai::OS::Time::Clock::sinceStart<Makai::OS::Time::Nanos>();
+}
+
+static usize peakMemory() {
+	#if (CTL_TARGET_OS == CTL_OS_WINDOWS)
+	PROCESS_MEMORY_COUNTERS counters;
+	if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+	return counters.PeakWorkingSetSize;
+	#else
+	rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage)) return 0;
+	#ifdef __APPLE__
+	return usage.ru_maxrss;
+	#else
+	return usage.ru_maxrss * 1024;
+	#endif
+	#endif
+}
+
+static Makai::String millis(usize const nanos) {
+	auto fraction = Makai::toString((nanos / 1000) % 1000);
+	while (fraction.size() < 3)
+		fraction = "0" + fraction;
+	return Makai::toString(nanos / 1000000) + "." + fraction;
+}
+
+Statistics::Scope::Scope(String const& name, String const& file) {
+	if (!active) return;
+	stats	= active;
+	index	= stats->passes.size();
+	stats->passes.pushBack({name, file});
+	stats->open.pushBack({index, 0});
+	peak	= peakMemory();
+	start	= now();
+}
+
+Statistics::Scope::~Scope() {
+	if (!stats) return;
+	auto const elapsed	= now() - start;
+	auto const self		= stats->open.popBack();
+	auto& pass			= stats->passes[index];
+	pass.time			= elapsed - self.nested;
+	pass.peak			= peakMemory();
+	pass.growth			= pass.peak - peak;
+	if (stats->open.size())
+		stats->open.back().nested += elapsed;
+}
+
+Makai::Data::Value Statistics::report() const {
+	auto result = Data::Value::object();
+	result["files"]		= result.object();
+	result["passes"]	= result.object();
+	auto& files		= result["files"];
+	auto& totals	= result["passes"];
+	usize time = 0, peak = 0;
+	for (auto const& pass: passes) {
+		auto& file = files[pass.file];
+		if (!file.contains(pass.name)) {
+			file[pass.name]["time"]		= 0;
+			file[pass.name]["growth"]	= 0;
+		}
+		file[pass.name]["time"]		= file[pass.name]["time"].get<usize>() + pass.time;
+		file[pass.name]["growth"]	= file[pass.name]["growth"].get<usize>() + pass.growth;
+		file["time"]				= file.fetch<usize>("time", 0) + pass.time;
+		auto& total = totals[pass.name];
+		total["runs"]	= total.fetch<usize>("runs", 0) + 1;
+		total["time"]	= total.fetch<usize>("time", 0) + pass.time;
+		total["growth"]	= total.fetch<usize>("growth", 0) + pass.growth;
+		time += pass.time;
+		peak = Math::max(peak, pass.peak);
+	}
+	result["time"]	= time;
+	result["peak"]	= peak;
+	return result;
+}
+
+Makai::String Statistics::summary() const {
+	auto const stats = report();
+	String result;
+	for (auto [name, pass]: stats["passes"].items())
+		result +=
+			name + ": "
+		+	millis(pass["time"].get<usize>()) + " ms, +"
+		+	toString(pass["growth"].get<usize>() / 1024) + " KiB ("
+		+	toString(pass["runs"].get<usize>()) + " runs)\n"
+		;
+	result +=
+		"total: "
+	+	millis(stats["time"].get<usize>()) + " ms, peak "
+	+	toString(stats["peak"].get<usize>() / 1024) + " KiB\n"
+	;
+	return result;
+}
@@ -0,0 +1,66 @@
+#ifndef MAKAILIB_ANIMA_V2_TOOLCHAIN_ASSEMBLER_STATISTICS_H
+#define MAKAILIB_ANIMA_V2_TOOLCHAIN_ASSEMBLER_STATISTICS_H
+
+#include "../../../../../compat/ctl.hpp"
+
+namespace Makai::Anima::V2::Toolchain::Assembler {
+	/// @brief Per-pass compilation statistics.
+	/// @details
+	///		Passes can nest (imports get compiled in the middle of the file importing them),
+	///		so a pass's time excludes any pass that ran inside of it.
+	///		Memory is measured as the process's peak resident size, so a pass's `growth` is how much it raised that peak.
+	struct Statistics {
+		/// @brief A single run of a pass.
+		struct Pass {
+			/// @brief Pass name.
+			String	name;
+			/// @brief File processed.
+			String	file;
+			/// @brief Time taken, in nanoseconds, excluding nested passes.
+			usize	time	= 0;
+			/// @brief Peak resident memory when the pass ended, in bytes.
+			usize	peak	= 0;
+			/// @brief How much the pass raised the peak resident memory by, in bytes.
+			usize	growth	= 0;
+		};
+
+		/// @brief Measures a pass in the active statistics, if any, for as long as it exists.
+		struct Scope {
+			/// @brief Begins measuring a pass.
+			/// @param name Pass name.
+			/// @param file File being processed.
+			Scope(String const& name, String const& file);
+			/// @brief Finishes measuring the pass.
+			~Scope();
+
+		private:
+			ref<Statistics>	stats	= nullptr;
+			usize			index	= 0;
+			usize			start	= 0;
+			usize			peak	= 0;
+		};
+
+		/// @brief Every pass run so far, in the order they started.
+		List<Pass> passes;
+
+		/// @brief Returns a report of every pass, grouped per file and per pass, with totals.
+		/// @return Report.
+		Data::Value report() const;
+		/// @brief Returns a human-readable summary of the report.
+		/// @return Summary.
+		String summary() const;
+
+		/// @brief Statistics currently being gathered. If null, nothing gets measured.
+		static inline thread_local ref<Statistics> active = nullptr;
+
+	private:
+		struct Open {
+			usize index;
+			usize nested;
+		};
+
+		List<Open> open;
+	};
+}
+
+#endif
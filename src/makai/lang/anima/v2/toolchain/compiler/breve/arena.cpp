@@ -0,0 +1,93 @@
+#include "arena.hpp"
+
+using namespace Makai;
+using namespace Makai::Anima::V2::Toolchain::Compiler::Breve;
+
+struct alignas(16) Arena::Chunk {
+	ref<Chunk>	next;
+	usize		size;
+
+	ref<byte> begin()	{return ref<byte>(this + 1);	}
+	ref<byte> end()		{return begin() + size;			}
+};
+
+struct Arena::Cleanup {
+	ref<Cleanup>	next;
+	pointer			obj;
+	void			(*destroy)(pointer);
+};
+
+static thread_local Arena::Owner activeArena = nullptr;
+// Kept separately, so allocating does not have to go through the reference counter
+static thread_local ref<Arena> activeArenaPointer = nullptr;
+
+Arena::Scope::Scope(): previous(activeArena) {
+	if (activeArena) return;
+	activeArena			= Owner::create();
+	activeArenaPointer	= activeArena.raw();
+}
+
+Arena::Scope::~Scope() {
+	activeArena			= previous;
+	activeArenaPointer	= previous.raw();
+}
+
+Arena::Arena() {}
+
+Arena::~Arena() {
+	// Objects get destroyed newest first, as only older objects can be referenced by them while constructing
+	while (cleanups) {
+		auto const cleanup = cleanups;
+		cleanups = cleanup->next;
+		cleanup->destroy(cleanup->obj);
+	}
+	while (chunks) {
+		auto const chunk = chunks;
+		chunks = chunk->next;
+		MX::free(chunk);
+	}
+}
+
+Arena::Owner Arena::active() {
+	return activeArena;
+}
+
+Arena& Arena::current() {
+	// Never freed, as nodes created outside of a scope might be referenced from anywhere
+	static ref<Arena> const global = new Arena();
+	if (activeArenaPointer) return *activeArenaPointer;
+	return *global;
+}
+
+pointer Arena::allocate(usize const size, usize const alignment) {
+	auto start = ref<byte>((usize(cursor) + alignment - 1) & ~(alignment - 1));
+	if (cursor && start + size <= end) {
+		cursor = start + size;
+		return start;
+	}
+	auto const big		= size + alignment > CHUNK_SIZE / 4;
+	auto const capacity	= big ? size + alignment : CHUNK_SIZE;
+	auto const chunk	= static_cast<ref<Chunk>>(MX::malloc(sizeof(Chunk) + capacity));
+	chunk->size	= capacity;
+	held		+= capacity;
+	start = ref<byte>((usize(chunk->begin()) + alignment - 1) & ~(alignment - 1));
+	// Big blocks go behind the current chunk, so its remaining space is not wasted
+	if (big && chunks) {
+		chunk->next		= chunks->next;
+		chunks->next	= chunk;
+		return start;
+	}
+	chunk->next	= chunks;
+	chunks		= chunk;
+	cursor		= start + size;
+	end			= chunk->end();
+	return start;
+}
+
+void Arena::onRelease(pointer const obj, void(*const destroy)(pointer)) {
+	auto const cleanup = static_cast<ref<Cleanup>>(allocate(sizeof(Cleanup), alignof(Cleanup)));
+	cleanup->next		= cleanups;
+	cleanup->obj		= obj;
+	cleanup->destroy	= destroy;
+	cleanups = cleanup;
+}
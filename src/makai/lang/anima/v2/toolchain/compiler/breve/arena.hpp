@@ -0,0 +1,150 @@
+#ifndef MAKAILIB_ANIMA_V2_TOOLCHAIN_COMPILER_BREVE_ARENA_H
+#define MAKAILIB_ANIMA_V2_TOOLCHAIN_COMPILER_BREVE_ARENA_H
+
+#include "../../../../../../compat/ctl.hpp"
+
+namespace Makai::Anima::V2::Toolchain::Compiler::Breve {
+	/// @brief Compilation-scoped storage for syntax tree and intermediate nodes.
+	/// @details
+	///		Nodes get carved out of big chunks, and live for as long as the arena does.
+	///		They are never freed one by one: the arena's chunks are freed all at once, when the arena is.
+	///
+	///		Which arena gets used is decided by the arena currently active in the thread (see `Arena::Scope`).
+	///		If none is, nodes go into a global arena, which lives for as long as the program.
+	struct Arena {
+		/// @brief Reference to a node living in an arena.
+		/// @tparam T Node type.
+		/// @note
+		///		Does not own the node, so copying it costs nothing.
+		///		Dereferencing it when null throws, same as a `Makai::Instance` would.
+		template <class T>
+		struct Instance {
+			/// @brief Default constructor.
+			constexpr Instance() {}
+
+			/// @brief Constructs the reference from a node.
+			/// @param obj Node to reference. Must have been created through `create`, or be null.
+			constexpr Instance(ref<T> const obj): obj(obj) {}
+
+			/// @brief Creates a node in the active arena.
+			/// @tparam ...Args Argument types.
+			/// @param ...args Arguments to pass to the node's constructor.
+			/// @return Reference to node.
+			template <class... Args>
+			static Instance create(Args&&... args) {
+				return Arena::make<T>(::CTL::forward<Args>(args)...);
+			}
+
+			/// @brief Returns a pointer to the node.
+			/// @return Pointer to node.
+			constexpr ref<T> raw() const		{return obj;	}
+			/// @brief Returns a copy of the reference. Exists for parity with `Makai::Instance`.
+			/// @return Reference to node.
+			constexpr Instance asWeak() const	{return obj;	}
+			/// @brief Returns whether the reference is not null.
+			/// @return Whether reference is not null.
+			constexpr bool exists() const		{return obj;	}
+
+			constexpr explicit operator bool() const	{return obj;	}
+			constexpr bool operator!() const			{return !obj;	}
+
+			ref<T> operator->() const	{return &value();	}
+			T& operator*() const		{return value();	}
+
+			/// @brief Returns the node.
+			/// @return Node.
+			/// @throw Error::NullPointer if reference is null.
+			T& value() const {
+				if (!obj) [[unlikely]]
+					throw Error::NullPointer(
+						toString("Pointer reference of type '", TypeInfo<T>::name(), "' does not exist!"),
+						"Pointer might be null or nonexistent.",
+						"none",
+						CTL_CPP_UNKNOWN_SOURCE
+					);
+				return *obj;
+			}
+
+			constexpr bool operator==(Instance const& other) const	{return obj == other.obj;	}
+			constexpr auto operator<=>(Instance const& other) const	{return obj <=> other.obj;	}
+
+		private:
+			ref<T> obj = nullptr;
+		};
+
+		/// @brief Reference to a node living in an arena. Same as `Instance`, as no node owns another.
+		/// @tparam T Node type.
+		template <class T>
+		using Handle = Instance<T>;
+
+		/// @brief Owning handle to an arena. The arena gets freed along with the last handle to it.
+		using Owner = Makai::Instance<Arena>;
+
+		/// @brief Makes a new arena active in the current thread for as long as the scope lasts, if none already is.
+		/// @details
+		///		Scopes opened while an arena is already active (imports, for example) keep using that arena.
+		///		Once the outermost scope ends, its arena is freed, unless something else holds an `Owner` to it.
+		struct Scope {
+			Scope();
+			~Scope();
+
+			Scope(Scope const&)				= delete;
+			Scope& operator=(Scope const&)	= delete;
+
+		private:
+			Owner const previous;
+		};
+
+		/// @brief Size of a chunk, in bytes. Bigger allocations get a chunk of their own.
+		constexpr static usize CHUNK_SIZE = 64 * 1024;
+
+		Arena();
+		~Arena();
+
+		Arena(Arena const&)				= delete;
+		Arena& operator=(Arena const&)	= delete;
+
+		/// @brief Returns the arena active in the current thread.
+		/// @return Active arena, or null if none is.
+		static Owner active();
+
+		/// @brief Creates an object in the active arena, or in the global one if there is none.
+		/// @tparam T Object type.
+		/// @tparam ...Args Argument types.
+		/// @param ...args Arguments to pass to the object's constructor.
+		/// @return Created object.
+		template <class T, class... Args>
+		static ref<T> make(Args&&... args) {
+			auto& arena = current();
+			auto const obj = MX::construct(static_cast<ref<T>>(arena.allocate(sizeof(T), alignof(T))), ::CTL::forward<Args>(args)...);
+			arena.onRelease(obj, [] (pointer const obj) {MX::destruct(static_cast<ref<T>>(obj));});
+			return obj;
+		}
+
+		/// @brief Allocates a block of memory from the arena.
+		/// @param size Block size.
+		/// @param alignment Block alignment.
+		/// @return Allocated block.
+		pointer allocate(usize const size, usize const alignment);
+
+		/// @brief Returns how many bytes the arena is holding, across all of its chunks.
+		/// @return Size held.
+		usize size() const {return held;}
+
+	private:
+		struct Chunk;
+		struct Cleanup;
+
+		static Arena& current();
+
+		void onRelease(pointer const obj, void(*const destroy)(pointer));
+
+		ref<Chunk>		chunks		= nullptr;
+		ref<Cleanup>	cleanups	= nullptr;
+		ref<byte>		cursor		= nullptr;
+		ref<byte>		end			= nullptr;
+		usize			held		= 0;
+	};
+}
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef MAKAILIB_ANIMA_V2_TOOLCHAIN_COMPILER_BREVE_H
 #define MAKAILIB_ANIMA_V2_TOOLCHAIN_COMPILER_BREVE_H
 
+#include "arena.hpp"
 #include "intermediate.hpp"
 #include "compiler.hpp"
 #include "parser.hpp"
@@ -2,6 +2,8 @@
 #include "composer.hpp"
 #include "intermediate.hpp"
 #include "../../assembler/minima.hpp"
+#include "../../assembler/optimizer.hpp"
+#include "../../assembler/statistics.hpp"
 #include "node.hpp"
 #include "transformer.hpp"
 
@@ -10,15 +12,12 @@ namespace Core = Makai::Anima::V2::Core;
 using namespace Makai::Anima::V2::Toolchain;
 using namespace Compiler;
 
+using Assembler::Statistics;
+
 // TODO: This hellspawn
 
-Core::Module Breve::compile(
-	Makai::UTF8String const& fname,
-	Makai::UTF8String const& file,
-	Makai::UTF8String const& append
-) {
-	Assembler::BaseContext ctx;
-	Breve::Parser parser(ctx);
+static void tokenize(Assembler::BaseContext& ctx, Makai::UTF8String const& fname, Makai::UTF8String const& file) {
+	Statistics::Scope const pass("lex", fname);
 	Makai::Lexer::CStyle::TokenStream stream;
 	stream.open(file + "\n");
 	Makai::List<Assembler::BaseContext::Axiom> ax;
@@ -30,11 +29,50 @@ Core::Module Breve::compile(
 			stream.error().value().what
 		);
 	ctx.put(ax).pad();
-	Transformer::ATransformer::Context ctx2;
-	Transformer::TheEntireProgram tf;
-	Composer comp(ctx2);
-	tf.transform(ctx2, parser.parse());
-	return Assembler::Minima::assemble(fname, append + comp.toMinima());
+}
+
+static Breve::Node::Instance parse(Breve::Parser& parser, Makai::UTF8String const& fname) {
+	Statistics::Scope const pass("parse", fname);
+	return parser.parse();
+}
+
+static void transform(Breve::Transformer::ATransformer::Context& ctx, Breve::Node::Instance const& tree, Makai::UTF8String const& fname) {
+	Statistics::Scope const pass("transform", fname);
+	Breve::Transformer::TheEntireProgram tf;
+	tf.transform(ctx, tree);
+}
+
+static Makai::UTF8String compose(Breve::Transformer::ATransformer::Context& ctx, Makai::UTF8String const& fname) {
+	Statistics::Scope const pass("compose", fname);
+	Breve::Composer comp(ctx);
+	return comp.toMinima();
+}
+
+// TODO: Emit instructions straight from the IR, instead of re-lexing and assembling its Minima
+static Core::Module assemble(Makai::UTF8String const& fname, Makai::UTF8String const& text, Assembler::Optimizer::Level const optimization) {
+	auto const program = Assembler::Minima::assemble(fname, text);
+	Statistics::Scope const pass("optimize", fname);
+	return Assembler::Optimizer::optimize(program, optimization);
+}
+
+static Makai::UTF8String toMinima(Makai::UTF8String const& fname, Makai::UTF8String const& file) {
+	// Everything here is done with by the time the Minima gets assembled, so it gets released before that
+	Breve::Arena::Scope const arena;
+	Assembler::BaseContext ctx;
+	Breve::Parser parser(ctx);
+	tokenize(ctx, fname, file);
+	Breve::Transformer::ATransformer::Context ctx2;
+	transform(ctx2, parse(parser, fname), fname);
+	return compose(ctx2, fname);
+}
+
+Core::Module Breve::compile(
+	Makai::UTF8String const& fname,
+	Makai::UTF8String const& file,
+	Makai::UTF8String const& append,
+	Assembler::Optimizer::Level const optimization
+) {
+	return assemble(fname, append + toMinima(fname, file), optimization);
 }
 
 Makai::Data::Value Breve::compile(
@@ -42,51 +80,38 @@ Makai::Data::Value Breve::compile(
 	Makai::UTF8String const& file,
 	CompilationLevel const level,
 	bool const strip,
-	Makai::UTF8String const& append
+	Makai::UTF8String const& append,
+	Assembler::Optimizer::Level const optimization
 ) {
+	Arena::Scope const arena;
 	Assembler::BaseContext ctx;
 	Breve::Parser parser(ctx);
-	Makai::Lexer::CStyle::TokenStream stream;
-	stream.open(file + "\n");
-	Makai::List<Assembler::BaseContext::Axiom> ax;
-	while (stream.next())
-		ax.pushBack({stream.current(), true, fname});
-	if (!stream.ok())
-		throw Makai::Error::InvalidValue(
-			"Parsing failure!",
-			stream.error().value().what
-		);
-	ctx.put(ax).pad();
+	tokenize(ctx, fname, file);
 	switch (level) {
 		using enum Breve::CompilationLevel;
 		case CompilationLevel::AV2_TCB_CCL_PARSE_TREE: {
-			auto const i = parser.parse();
+			auto const i = parse(parser, fname);
 			return i->serialize();
 		}
 		case CompilationLevel::AV2_TCB_CCL_INTERMEDIATE: {
 			Transformer::ATransformer::Context ctx;
-			Transformer::TheEntireProgram tf;
-			tf.transform(ctx, parser.parse());
+			transform(ctx, parse(parser, fname), fname);
 			return ctx.serialize();
 		}
 		case CompilationLevel::AV2_TCB_CCL_MINIMA: {
 			Transformer::ATransformer::Context ctx;
-			Transformer::TheEntireProgram tf;
-			Composer comp(ctx);
-			tf.transform(ctx, parser.parse());
-			return comp.toMinima().toString();
+			transform(ctx, parse(parser, fname), fname);
+			return compose(ctx, fname).toString();
 		}
 		case CompilationLevel::AV2_TCB_CCL_FULL: {
 			Transformer::ATransformer::Context ctx;
-			Transformer::TheEntireProgram tf;
-			Composer comp(ctx);
-			tf.transform(ctx, parser.parse());
-			return Assembler::Minima::assemble(fname, append + comp.toMinima()).serialize(!strip);
+			transform(ctx, parse(parser, fname), fname);
+			return assemble(fname, append + compose(ctx, fname), optimization).serialize(!strip);
 		}
 	}
 	throw Makai::Error::InvalidValue(
-		"NO!",
-		stream.error().value().what
+		"Invalid compilation level!",
+		CTL_CPP_PRETTY_SOURCE
 	);
 }
 
@@ -95,21 +120,11 @@ Breve::File Breve::parseFile(
 	Makai::UTF8String const& fname,
 	Makai::UTF8String const& file
 ) {
+	Arena::Scope const arena;
 	Assembler::BaseContext ctx;
 	Breve::Parser parser(ctx);
-	Makai::Lexer::CStyle::TokenStream stream;
-	stream.open(file + "\n");
-	Makai::List<Assembler::BaseContext::Axiom> ax;
-	while (stream.next())
-		ax.pushBack({stream.current(), true, fname});
-	if (!stream.ok())
-		throw Makai::Error::InvalidValue(
-			"Parsing failure!",
-			stream.error().value().what
-		);
-	ctx.put(ax).pad();
+	tokenize(ctx, fname, file);
 	Transformer::ATransformer::Context compCtx;
-	Transformer::TheEntireProgram tf;
-	tf.transform(compCtx, parser.parse());
-	return {compCtx.root, compCtx.main.raw()};
+	transform(compCtx, parse(parser, fname), fname);
+	return {compCtx.root, compCtx.main.raw(), Arena::active()};
 }
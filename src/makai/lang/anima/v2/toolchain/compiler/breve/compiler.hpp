@@ -6,6 +6,7 @@
 #include "intermediate.hpp"
 #include "node.hpp"
 #include "transformer.hpp"
+#include "../../assembler/optimizer.hpp"
 
 namespace Makai::Anima::V2::Toolchain::Compiler::Breve {
 	enum class CompilationLevel {
@@ -20,13 +21,15 @@ namespace Makai::Anima::V2::Toolchain::Compiler::Breve {
 		UTF8String const& file,
 		CompilationLevel const level,
 		bool const strip = false,
-		UTF8String const& append = ""
+		UTF8String const& append = "",
+		Assembler::Optimizer::Level const optimization = Assembler::Optimizer::Level::AV2_TCA_OL_NONE
 	);
 
 	Core::Module compile(
 		UTF8String const& fname,
 		UTF8String const& file,
-		UTF8String const& append = ""
+		UTF8String const& append = "",
+		Assembler::Optimizer::Level const optimization = Assembler::Optimizer::Level::AV2_TCA_OL_NONE
 	);
 
 	File parseFile(
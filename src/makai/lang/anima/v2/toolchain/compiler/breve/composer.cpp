@@ -9,8 +9,8 @@ using namespace Makai::Anima::V2::Toolchain::Compiler::Breve;
 static void doType(Composer& composer, Namespace::TypeRef const& fn);
 
 static void doFunction(Composer& composer, Namespace::FunctionRef const& fn) {
-	if (composer.visitedFunctions.contains(fn)) return;
-	composer.visitedFunctions[fn] = true;
+	if (composer.visitedFunctions.contains(fn.raw())) return;
+	composer.visitedFunctions[fn.raw()] = true;
 	for (auto& ov: fn->overloads) {
 		Makai::UTF8String ovstr;
 		if (ov->variant.context == ExecutionContext::AV2_TCB_EC_COMPILE)
@@ -49,17 +49,17 @@ static void doFunction(Composer& composer, Namespace::FunctionRef const& fn) {
 
 static void doVariable(Composer& composer, Namespace::VariableRef const& var) {
 	if (!var->initializer) return;
-	if (!var->staticEntity && !composer.visited.contains(var->initializer)) {
+	if (!var->staticEntity && !composer.visited.contains(var->initializer.raw())) {
 		composer.top()->writeMainLine(var->initializer->impl->toString());
-		composer.visited[var->initializer] = true;
+		composer.visited[var->initializer.raw()] = true;
 		var->initializer->impl = null;
 	} else if (var->staticEntity)
 		composer.staticDefs.pushBack(var->initializer->impl);
 }
 
 static void doType(Composer& composer, Namespace::TypeRef const& type) {
-	if (composer.visitedTypes.contains(type)) return;
-	composer.visitedTypes[type] = true;
+	if (composer.visitedTypes.contains(type.raw())) return;
+	composer.visitedTypes[type.raw()] = true;
 	if (!type->flags.isBasic && !type->uses) return;
 	Makai::UTF8String decl;
 	decl += "@type " + type->name + " [\n ";
@@ -156,7 +156,7 @@ static void doNamespace(Composer& composer, Namespace::Instance const& ns) {
 	if (!ns) return;
 	composer.push();
 	for (auto& [name, sub]: ns->subspaces) {
-		if (composer.visited.contains(sub) && composer.visited[sub]) continue;
+		if (composer.visited.contains(sub.raw()) && composer.visited[sub.raw()]) continue;
 		if (!sub) continue;
 		if (sub->function) doFunction(composer, sub->function);
 		if (sub->variable) {
@@ -167,9 +167,9 @@ static void doNamespace(Composer& composer, Namespace::Instance const& ns) {
 		}
 		if (sub->type) doType(composer, sub->type);
 	}
-	if(composer.visited.contains(ns) && composer.visited[ns])
+	if(composer.visited.contains(ns.raw()) && composer.visited[ns.raw()])
 		return composer.pop();
-	composer.visited[ns] = true;
+	composer.visited[ns.raw()] = true;
 	for (auto& [name, sub]: ns->subspaces)
 		doNamespace(composer, sub);
 	composer.pop();
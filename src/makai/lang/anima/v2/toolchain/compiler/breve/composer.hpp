@@ -9,9 +9,9 @@ namespace Makai::Anima::V2::Toolchain::Compiler::Breve {
 	struct Composer {
 		Intermediate& inter;
 
-		Map<Namespace::Instance, bool> visited;
-		Map<Namespace::TypeRef, bool> visitedTypes;
-		Map<Namespace::FunctionRef, bool> visitedFunctions;
+		Map<ref<Namespace const>, bool> visited;
+		Map<ref<TypeDecl const>, bool> visitedTypes;
+		Map<ref<Function const>, bool> visitedFunctions;
 
 		UTF8StringList types;
 		UTF8StringList functions;
@@ -20,7 +20,7 @@ namespace Makai::Anima::V2::Toolchain::Compiler::Breve {
 
 		usize staticVarCount = 0;
 
-		Implementation::Instance impl = new Implementation();
+		Implementation::Instance impl = impl.create();
 
 		UTF8String toMinima();
 
@@ -31,7 +31,7 @@ namespace Makai::Anima::V2::Toolchain::Compiler::Breve {
 		List<Implementation::Instance> implStack;
 
 		void push() {
-			implStack.pushBack(new Implementation());
+			implStack.pushBack(Implementation::Instance::create());
 		}
 
 		void pop() {
@@ -95,9 +95,8 @@ Namespace::Instance Intermediate::push(UTF8StringList const& path) {
 }
 
 void Intermediate::pop(usize count) {
-	while (scopeStack.size() && count--) {
-		auto const scope = scopeStack.popBack();
-	}
+	while (scopeStack.size() && count--)
+		scopeStack.popBack();
 }
 
 void Implementation::addPreLine(UTF8String const& what) {
@@ -693,7 +692,7 @@ static Namespace::AttributeRef createBeforeAttribute() {
 	attrib->target = Attribute::Target::AV2_TAAT_FUNCTION;
 	attrib->globalMin = 0;
 	attrib->transform = ATTRIBUTE_TRANSFORMER() {
-		Makai::Handle<Function::Overload> fn;
+		Arena::Handle<Function::Overload> fn;
 		MAKAILIB_DEBUGLN_FULL("Overloads: ", ns->function->current.size());
 		for (auto const& ov: ns->function->current)
 			if (ov->arguments.empty()) {
@@ -716,7 +715,7 @@ static Namespace::AttributeRef createAfterAttribute() {
 	attrib->target = Attribute::Target::AV2_TAAT_FUNCTION;
 	attrib->globalMin = 0;
 	attrib->transform = ATTRIBUTE_TRANSFORMER() {
-		Makai::Handle<Function::Overload> fn;
+		Arena::Handle<Function::Overload> fn;
 		MAKAILIB_DEBUGLN_FULL("Overloads: ", ns->function->current.size());
 		for (auto const& ov: ns->function->current)
 			if (ov->arguments.empty()) {
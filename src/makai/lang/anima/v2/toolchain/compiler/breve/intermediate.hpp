@@ -14,7 +14,7 @@ namespace Makai::Anima::V2::Toolchain::Compiler::Breve {
 	};
 
 	struct Positioned {
-		Instance<Node> node;
+		Arena::Instance<Node> node;
 	};
 
 	enum class ExecutionContext: byte {
@@ -54,7 +54,7 @@ namespace Makai::Anima::V2::Toolchain::Compiler::Breve {
 
 	struct IComposable {
 		virtual ~IComposable() {}
-		virtual Instance<Implementation> compose() const = 0;
+		virtual Arena::Instance<Implementation> compose() const = 0;
 	};
 
 	struct IWritable {
@@ -89,7 +89,7 @@ namespace Makai::Anima::V2::Toolchain::Compiler::Breve {
 	};
 
 	struct Scoped {
-		Handle<Namespace> scope;
+		Arena::Handle<Namespace> scope;
 	};
 
 	struct ISerializable {
@@ -98,7 +98,7 @@ namespace Makai::Anima::V2::Toolchain::Compiler::Breve {
 	};
 
 	struct Implementation: IWritable, IComposable, ISerializable {
-		using Instance		= Instance<Implementation>;
+		using Instance		= Arena::Instance<Implementation>;
 		UTF8StringList pre, main, post;
 
 		void addPreLine(UTF8String const& what) override;
@@ -106,7 +106,7 @@ namespace Makai::Anima::V2::Toolchain::Compiler::Breve {
 		void addPostLine(UTF8String const& what) override;
 
 		Instance compose() const override {
-			auto const impl = new Implementation;
+			auto const impl = Instance::create();
 			impl->pre = pre;
 			impl->main = main;
 			impl->post = post;
@@ -122,21 +122,21 @@ namespace Makai::Anima::V2::Toolchain::Compiler::Breve {
 	};
 
 	struct Metadata {
-		using Instance = Instance<Metadata>;
+		using Instance = Arena::Instance<Metadata>;
 
-		Makai::Instance<Attribute>	attribute;
+		Arena::Instance<Attribute>	attribute;
 		Makai::Data::Value			value;
 	};
 
 	struct Namespace: Labeled, Positioned, IComposable, Visible, ISerializable {
-		using TypeRef		= Instance<TypeDecl>;
-		using FunctionRef	= Instance<Function>;
-		using VariableRef	= Instance<Variable>;
-		using AttributeRef	= Instance<Attribute>;
-		using TraitRef		= Instance<Trait>;
-		using PropertyRef	= Instance<Property>;
+		using TypeRef		= Arena::Instance<TypeDecl>;
+		using FunctionRef	= Arena::Instance<Function>;
+		using VariableRef	= Arena::Instance<Variable>;
+		using AttributeRef	= Arena::Instance<Attribute>;
+		using TraitRef		= Arena::Instance<Trait>;
+		using PropertyRef	= Arena::Instance<Property>;
 
-		using Instance		= Instance<Namespace>;
+		using Instance		= Arena::Instance<Namespace>;
 
 		usize varc = 0;
 
@@ -232,13 +232,14 @@ namespace Makai::Anima::V2::Toolchain::Compiler::Breve {
 			UTF8String						outEntry;
 			UTF8String						sigEntry;
 			UTF8String						dynlib;
-			Handle<TypeDecl>				methodOf;
+			Arena::Handle<TypeDecl>			methodOf;
 			Variant							variant;
 			bool							optional = false;
 			bool							hasImplementation = false;
 			bool							staticEntity = false;
-			Handle<Overload>				fullImpl;
+			Arena::Handle<Overload>			fullImpl;
 			Node::Instance					decl = nullptr;
+			List<Namespace::Instance>		scopeStack;
 
 			usize uses = 0;
 
@@ -252,7 +253,7 @@ namespace Makai::Anima::V2::Toolchain::Compiler::Breve {
 			virtual ~Overload();
 		};
 
-		using OverloadRef = Instance<Overload>;
+		using OverloadRef = Arena::Instance<Overload>;
 
 		List<OverloadRef> overloads;
 		List<OverloadRef> current;
@@ -271,20 +272,20 @@ namespace Makai::Anima::V2::Toolchain::Compiler::Breve {
 	};
 
 	struct Variable: Labeled, Positioned, Scoped, ISerializable {
-		Handle<TypeDecl>	type;
-		Namespace::Instance	initializer;
-		UTF8String			source;
-		Data::Value			value;
-		bool				defaulted = false;
-		bool				global = false;
-		bool				staticEntity = false;
-		Handle<TypeDecl>	fieldOf;
-		uint64				id = 0;
-		Handle<Namespace>	parentScope;
-		UTF8String			passBy = "move";
-		bool				hasValue = false;
-		Node::Instance		lastConsumer;
-		bool				isConstant = false;
+		Arena::Handle<TypeDecl>		type;
+		Namespace::Instance			initializer;
+		UTF8String					source;
+		Data::Value					value;
+		bool						defaulted = false;
+		bool						global = false;
+		bool						staticEntity = false;
+		Arena::Handle<TypeDecl>		fieldOf;
+		uint64						id = 0;
+		Arena::Handle<Namespace>	parentScope;
+		UTF8String					passBy = "move";
+		bool						hasValue = false;
+		Node::Instance				lastConsumer;
+		bool						isConstant = false;
 
 		ExecutionContext	context = ExecutionContext::AV2_TCB_EC_NONE;
 
@@ -407,7 +408,7 @@ namespace Makai::Anima::V2::Toolchain::Compiler::Breve {
 		Namespace::TypeRef		type;
 		Namespace::FunctionRef	getter;
 		Namespace::FunctionRef	setter;
-		Handle<TypeDecl>		fieldOf;
+		Arena::Handle<TypeDecl>	fieldOf;
 
 		Makai::Data::Value serialize() const override;
 
@@ -437,6 +438,8 @@ namespace Makai::Anima::V2::Toolchain::Compiler::Breve {
 	struct File {
 		Namespace::Instance		content;
 	 	Function::OverloadRef	main;
+		/// @brief Arena the file's contents live in. Keeps them alive for as long as the file is.
+		Arena::Owner			arena;
 	};
 
 	struct Intermediate: IWritable, ISerializable {
@@ -444,9 +447,9 @@ namespace Makai::Anima::V2::Toolchain::Compiler::Breve {
 
 		Namespace::Instance root = root.create();
 
-		List<Handle<Function::Overload>>	before;
-		Handle<Function::Overload>			main;
-		List<Handle<Function::Overload>>	after;
+		List<Arena::Handle<Function::Overload>>	before;
+		Arena::Handle<Function::Overload>		main;
+		List<Arena::Handle<Function::Overload>>	after;
 
 		void addPreLine(UTF8String const& what) override;
 		void addMainLine(UTF8String const& what) override;
@@ -3,12 +3,13 @@
 
 #include "../../assembler/assembler.hpp"
 #include "../../../core/core.hpp"
+#include "arena.hpp"
 
 namespace Makai::Anima::V2::Toolchain::Compiler::Breve {
 	using BaseContext = Assembler::BaseContext;
 
 	struct Node: ID::Identifiable<Node const, ID::VLUID> {
-		using Instance = Instance<Node>;
+		using Instance = Arena::Instance<Node>;
 
 		using ID::Identifiable<Node const, ID::VLUID>::id;
 
@@ -121,6 +121,15 @@ static Makai::Nullable<Makai::UTF8String> addToStack(
 	return null;
 }
 
+static Makai::Data::Value directValueOf(ATransformer::Context& context, Variable const& var) {
+	// Constants only get folded when their value is already of their type, so folding does not change the result's type
+	if (!(var.isCompiled() || (var.isConstant && !var.fieldOf)))
+		return {};
+	if (var.value.isUndefined() || context.basicTypeOf(var.value) != var.type)
+		return {};
+	return var.value;
+}
+
 static ATransformer::Result resolveSubfield(
 	ATransformer::Context& context,
 	Node::Instance const& node,
@@ -155,7 +164,6 @@ static ATransformer::Result resolveSubfield(
 	}
 	if (ns->property) {
 		if (ns->property->type->fields.contains(sub)) {
-			auto const f = ns->property->type->fields[sub];
 			auto const ov = ns->property->getter->overloadFromTypes(
 				Makai::List<Namespace::TypeRef>::from(ns->type.raw())
 			);
@@ -435,13 +443,13 @@ ATransformer::Result Aliasing::transform(Context& context, Node::Instance const&
 		auto const alias = context.pathOf(node->leftSide);
 		if (context.parent()->resolve(alias))
 			context.error("Symbol with this name already exists in the current scope!", node->leftSide);
-		auto const tmp = context.declare(alias);
+		context.declare(alias);
 		context.parent()->subspaces[alias.back()] = scope;
 		context.pop(alias.size());
 	} else {
 		if (context.parent()->resolve(UTF8StringList::from(scope->name)))
 			context.error("Symbol with this name already exists in the current scope!", node->leftSide);
-		auto const tmp = context.declare(UTF8StringList::from(scope->name));
+		context.declare(UTF8StringList::from(scope->name));
 		context.parent()->subspaces[scope->name] = scope;
 		context.pop(1);
 	}
@@ -481,7 +489,7 @@ ATransformer::Result StructureDecl::transform(Context& context, Node::Instance c
 		type.fields.append(base->fields);
 		type.methods.append(base->methods);
 		for (auto& [name, method]: base->methods) {
-			auto& ns = *(type.scope->subspaces[name] = new Namespace);
+			auto& ns = *(type.scope->subspaces[name] = Namespace::Instance::create());
 			ns.function = method;
 		}
 		scope->varc += base->scope->varc;
@@ -704,6 +712,15 @@ ATransformer::Result EnumDecl::transform(Context& context, Node::Instance const&
 	return {};
 }
 
+/// @brief Turns the last line written into a tail call, if it is a call whose result gets returned as-is.
+static void markTailCall(ATransformer::Context& context) {
+	// Inlined bodies have no frame of their own to reuse
+	if (context.functionStack.empty() || context.inlineStack.size()) return;
+	auto& main = context.top()->impl->main;
+	if (main.size() && main.back().sliced(0, 5) == " call ")
+		main.back() = " tail" + main.back();
+}
+
 ATransformer::Result Return::transform(Context& context, Node::Instance const& node) {
 	Expression expr;
 	auto const val = expr.transform(context, node->leftSide);
@@ -717,6 +734,8 @@ ATransformer::Result Return::transform(Context& context, Node::Instance const& n
 	else if (val.isStackTop() && val.isCopied()) {
 		context.top()->impl->writeMainLine("copy", *val.source, "-> top");
 	}
+	else if (val.isStackTop())
+		markTailCall(context);
 	context.top()->impl->writeMainLine("ret");
 	return {{"move top"}, val.scope, val.type};
 }
@@ -1050,26 +1069,27 @@ ATransformer::Result specialDirectResolve(
 	ATransformer::Result out;
 	if (kw == "as") {
 		if (auto const t = TypeDecl::stronger(value.type, type)) {
-			Makai::Data::Value val;
-			if (type->basic) {
+			Makai::Data::Value val = value.direct;
+			if (type->basic && value.direct.isScalar()) {
 				switch (*type->basic) {
-					default: val = value.direct;
-					case Core::BasicType::AV2_BT_BOOL: val = value.direct.getBoolean();
+					default: break;
+					case Core::BasicType::AV2_BT_BOOL: val = value.direct.getBoolean(); break;
 					case Core::BasicType::AV2_BT_INT8:
 					case Core::BasicType::AV2_BT_INT16:
 					case Core::BasicType::AV2_BT_INT32:
-					case Core::BasicType::AV2_BT_INT64: val = value.direct.getSigned();
+					case Core::BasicType::AV2_BT_INT64: val = value.direct.getSigned(); break;
 					case Core::BasicType::AV2_BT_UINT8:
 					case Core::BasicType::AV2_BT_UINT16:
 					case Core::BasicType::AV2_BT_UINT32:
-					case Core::BasicType::AV2_BT_UINT64: val = value.direct.getUnsigned();
+					case Core::BasicType::AV2_BT_UINT64: val = value.direct.getUnsigned(); break;
 					case Core::BasicType::AV2_BT_REAL32:
 					case Core::BasicType::AV2_BT_REAL64:
-					case Core::BasicType::AV2_BT_REAL128: val = value.direct.getReal();
-					case Core::BasicType::AV2_BT_STRING: val = value.direct.toString();
+					case Core::BasicType::AV2_BT_REAL128: val = value.direct.getReal(); break;
 				}
-			} else val = value.direct;
-			return {value.source, value.scope, type, value.direct, value.likelihood};
+			}
+			if (val.type() == value.direct.type())
+				return {value.source, value.scope, type, val, value.likelihood};
+			return {{val.toString()}, value.scope, type, val, value.likelihood};
 		}
 		else context.error("Value cannot be converted to the given type!", node);
 	} else if (kw == "is") {
@@ -1147,7 +1167,7 @@ ATransformer::Result InfixExpression::transform(Context& context, Node::Instance
 	}
 	if (!lhsHasBeenPushed)
 		context.top()->impl->writeMainLine("push", *lhs.source);
-	if ((lhs.type == rhs.type) && (!rhs.isCompilable() or rhs.direct.isString())) {
+	if (!rhs.isCompilable() or ((lhs.type == rhs.type) && rhs.direct.isString())) {
 		if (rhs.shouldBePushed())
 			context.top()->impl->writeMainLine("push", *rhs.source);
 		else if (rhs.isStackTop() && rhs.isCopied()) {
@@ -1237,6 +1257,7 @@ ATransformer::Result PathExpression::transform(Context& context, Node::Instance
 		if (ns->variable) {
 			result.type		= ns->variable->type.raw();
 			result.scope	= ns->variable->scope.raw();
+			result.direct	= directValueOf(context, *ns->variable);
 		} else result.scope = ns;
 		return result;
 	} if (node->leftSide->content == Node::Content::AV2_TANC_FN_CALL) {
@@ -1566,6 +1587,12 @@ ATransformer::Result FunctionDecl::transform(Context& context, Node::Instance co
 		current->decl = node->rightSide;
 		if (ovImpl.size())
 			current = current.create();
+		// Set up front when declared, so the function can call itself
+		if (retType) {
+			for (auto& ov: fn->current)
+				ov->result = retType;
+			current->result = retType;
+		}
 		context.functionStack.pushBack(current);
 		impl->impl->writePreLine("bind ref", argc, "[0 -> 0]");
 		impl->impl->writePreLine("clear", argc);
@@ -1580,6 +1607,9 @@ ATransformer::Result FunctionDecl::transform(Context& context, Node::Instance co
 		current->hasImplementation = true;
 		if (ovImpl.empty())
 			current->scope = context.top().asWeak();
+		// Only set once the body is done, so functions never get inlined into themselves
+		if (optional.empty())
+			first->scopeStack = context.scopeStack;
 		context.functionStack.popBack();
 	} else {
 		impl->impl->writePreLine("blit ref", argc, "[0 -> 0]");
@@ -1833,8 +1863,151 @@ ATransformer::Result Declaration::transform(Context& context, Node::Instance con
 	context.error("Invalid declaration!", node);
 }
 
-static Makai::Data::Value callDirect(ATransformer::Context& context, Function::Overload& ov, Makai::Data::Value::ArrayType const& args) {
-	// TODO: Direct functions
+static Node::Instance bodyExpressionOf(Node::Instance node) {
+	while (node && node->content == Node::Content::AV2_TANC_BLOCK && node->children.size() == 1)
+		node = node->children.front();
+	if (node && node->content == Node::Content::AV2_TANC_PREFIX_OP && node->base.text == "return")
+		node = node->leftSide;
+	return node;
+}
+
+/// @brief Returns how many nodes an expression is made of, or `-1` if it cannot be inlined.
+static usize inlineSizeOf(Node::Instance const& node) {
+	if (!node) return 0;
+	usize size = 1;
+	auto const add = [&] (Node::Instance const& sub) {
+		auto const subSize = inlineSizeOf(sub);
+		size = (size == usize(-1) || subSize == usize(-1)) ? -1 : size + subSize;
+	};
+	switch (node->content) {
+		case Node::Content::AV2_TANC_VALUE:
+		case Node::Content::AV2_TANC_NAME:
+			break;
+		case Node::Content::AV2_TANC_PATH:
+			add(node->leftSide);
+			break;
+		case Node::Content::AV2_TANC_PREFIX_OP:
+			// Would return from the caller, instead
+			if (node->base.text == "return") return -1;
+			add(node->leftSide);
+			break;
+		case Node::Content::AV2_TANC_INFIX_OP:
+			// Short-circuiting jumps to labels, which would get declared once per call site
+			if (isLogicOp(node)) return -1;
+			add(node->leftSide);
+			add(node->rightSide);
+			break;
+		case Node::Content::AV2_TANC_SUBSCRIPT:
+			add(node->leftSide);
+			add(node->rightSide);
+			break;
+		case Node::Content::AV2_TANC_FN_CALL:
+			add(node->leftSide);
+			for (auto const& arg: node->children)
+				add(arg);
+			break;
+		case Node::Content::AV2_TANC_BLOCK:
+			if (node->children.size() != 1) return -1;
+			add(node->children.front());
+			break;
+		default: return -1;
+	}
+	return size;
+}
+
+static Node::Instance inlineableBodyOf(ATransformer::Context& context, Function::OverloadRef const& ov) {
+	if (!context.inlineThreshold || ov->scopeStack.empty() || !ov->result)
+		return nullptr;
+	if (ov->variant.external != Function::Overload::Variant::External::AV2_TCB_FO_VE_NONE)
+		return nullptr;
+	// Also keeps mutually recursive functions from getting expanded forever
+	if (context.inlineStack.find(ov) != -1)
+		return nullptr;
+	auto const body = bodyExpressionOf(ov->decl);
+	if (!body || inlineSizeOf(body) > context.inlineThreshold)
+		return nullptr;
+	return body;
+}
+
+/// @brief Evaluates an overload's body with its arguments bound to the given direct values.
+/// @return Resulting direct value, or undefined if the body does not fold into one.
+static Makai::Data::Value evaluateCall(
+	ATransformer::Context& context,
+	Function::OverloadRef const& ov,
+	Node::Instance const& body,
+	Makai::Data::Value::ArrayType const& args
+) {
+	auto const previous = context.scopeStack;
+	// Never registered in its parent, so evaluating the same function again does not clash with it
+	Namespace::Instance const scope = scope.create("<eval>" + body->name());
+	for (auto const [arg, i]: Makai::Range::expand(ov->arguments)) {
+		Namespace::Instance const param = param.create(arg->name);
+		auto& var = *(param->variable = param->variable.create());
+		var.name		= arg->name;
+		var.type		= arg->type;
+		var.value		= args[i];
+		var.context		= ExecutionContext::AV2_TCB_EC_COMPILE;
+		var.isConstant	= true;
+		var.passBy		= "copy";
+		scope->subspaces[arg->name] = param;
+	}
+	context.scopeStack = ov->scopeStack;
+	context.scopeStack.pushBack(scope);
+	context.inlineStack.pushBack(ov);
+	// Whatever code gets generated stays in the scope, and gets thrown away along with it
+	auto const result = Expression().transform(context, body);
+	context.inlineStack.popBack();
+	context.scopeStack = previous;
+	return result.direct;
+}
+
+/// @brief Expands an overload's body in place of a call to it, with its arguments already on the stack.
+static ATransformer::Result inlineCall(
+	ATransformer::Context& context,
+	Function::OverloadRef const& ov,
+	Node::Instance const& body,
+	Node::Instance const& node
+) {
+	auto const caller	= context.top();
+	auto const previous	= context.scopeStack;
+	auto const argc		= ov->arguments.size();
+	Namespace::Instance const scope = scope.create("<inline>" + node->name());
+	// Same as what the function itself does on entry, so the body's code stays the same
+	scope->impl->writePreLine("enter", argc);
+	scope->impl->writePreLine("bind ref", argc, "[0 -> 0]");
+	scope->impl->writePreLine("clear", argc);
+	for (auto& arg: ov->arguments)
+		arg->fill();
+	context.scopeStack = ov->scopeStack;
+	context.scopeStack.pushBack(scope);
+	context.inlineStack.pushBack(ov);
+	auto const result = Expression().transform(context, body);
+	if (result.shouldBePushed())
+		scope->impl->writeMainLine("push", *result.source);
+	else if (result.isStackTop() && result.isCopied())
+		scope->impl->writeMainLine("copy", *result.source, "-> top");
+	scope->impl->writePostLine("end");
+	context.inlineStack.popBack();
+	context.scopeStack = previous;
+	caller->impl->writeMainLine(scope->impl->toString());
+	return {{"move top"}, ov->result->scope.raw(), ov->result};
+}
+
+static Makai::Data::Value callDirect(
+	ATransformer::Context& context,
+	Function::OverloadRef const& ov,
+	Makai::Data::Value::ArrayType const& args,
+	Node::Instance const& node
+) {
+	auto const body = bodyExpressionOf(ov->decl);
+	if (!body || ov->scopeStack.empty())
+		context.error("Function body cannot be evaluated at compile time!", node);
+	if (context.inlineStack.find(ov) != -1)
+		context.error("Direct functions cannot be recursive!", node);
+	auto const result = evaluateCall(context, ov, body, args);
+	if (result.isUndefined() && !ov->result->flags.hasNoResult)
+		context.error("Function call does not result in a direct value!", node);
+	return result;
 }
 
 ATransformer::Result Call::transform(Context& context, Node::Instance const& node) {
@@ -1888,7 +2061,8 @@ ATransformer::Result Call::transform(Context& context, Node::Instance const& nod
 		isMemFn = true;
 	}
 	auto& ov = *ovf;
-	++ov.fullImpl->uses;
+	if (!ov.result)
+		context.error("Function must declare its return type to be called from its own body!", node);
 	if (isMemFn) {
 		if (fn.isCompilable())
 			directArgs.insert(fn.direct, 0);
@@ -1897,16 +2071,33 @@ ATransformer::Result Call::transform(Context& context, Node::Instance const& nod
 		context.top()->impl->main[memspot] = pushAction + copyAction;
 	}
 	if (!runtimeCall && ov.variant.context > ExecutionContext::AV2_TCB_EC_RUNTIME) {
-		auto const ret = callDirect(context, ov, directArgs);
-		context.impl()->main.eraseRange(-dx, -1);
+		++ov.fullImpl->uses;
+		auto const ret = callDirect(context, ovf, directArgs, node);
+		while (context.impl()->main.size() > dx)
+			context.impl()->main.popBack();
 		if (ret.isUndefined())
 			return {.type = context.basicType("void")};
 		else if (ret.isObject())
 			return Expression().transform(context, context.evaluate(ret["eval"].getString()));
 		else return {{ret.isNull() ? "nil" : ret.toString()}, nullptr, context.basicTypeOf(ret), ret};
-	} else if (ov.variant.context < ExecutionContext::AV2_TCB_EC_COMPILE)
-		context.top()->impl->writeMainLine("call", ov.entry);
-	else context.error("It is forbidden to call a direct function with indirect arguments!", node);
+	} else if (ov.variant.context < ExecutionContext::AV2_TCB_EC_COMPILE) {
+		auto const body = inlineableBodyOf(context, ovf);
+		if (body && !runtimeCall && !isMemFn) {
+			auto const ret = evaluateCall(context, ovf, body, directArgs);
+			if (!ret.isUndefined() && context.basicTypeOf(ret) == ov.result) {
+				// The arguments are not needed anymore, as the call folded away
+				while (context.top()->impl->main.size() > memspot)
+					context.top()->impl->main.popBack();
+				return {{ret.toString()}, ov.result->scope.raw(), ov.result, ret};
+			}
+		}
+		if (body)
+			inlineCall(context, ovf, body, node);
+		else {
+			++ov.fullImpl->uses;
+			context.top()->impl->writeMainLine("call", ov.entry);
+		}
+	} else context.error("It is forbidden to call a direct function with indirect arguments!", node);
 	if (context.functionStack.size() && ov.variant.context == ExecutionContext::AV2_TCB_EC_RUNTIME) {
 		auto& ctx = context.functionStack.back()->variant.context;
 		if (ctx < ExecutionContext::AV2_TCB_EC_MIXED)
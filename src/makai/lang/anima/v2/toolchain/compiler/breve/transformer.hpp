@@ -77,9 +77,14 @@ namespace Makai::Anima::V2::Toolchain::Compiler::Breve::Transformer {
 
 			Context();
 
-			UTF8Dictionary<Namespace::TypeRef>			basics;
-			Map<Handle<TypeDecl>, Namespace::TypeRef>	arrays;
-			Map<Handle<TypeDecl>, Namespace::TypeRef>	nullables;
+			UTF8Dictionary<Namespace::TypeRef>					basics;
+			Map<Arena::Handle<TypeDecl>, Namespace::TypeRef>	arrays;
+			Map<Arena::Handle<TypeDecl>, Namespace::TypeRef>	nullables;
+
+			/// @brief Overloads currently being inlined, innermost last.
+			List<Function::OverloadRef>	inlineStack;
+			/// @brief Maximum size (in syntax tree nodes) a function's body can have to get inlined. Zero disables inlining.
+			usize						inlineThreshold = 16;
 
 			Node::Instance evaluate(UTF8String const& eval);
 		};
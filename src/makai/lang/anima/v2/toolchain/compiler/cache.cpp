@@ -0,0 +1,59 @@
+#include "cache.hpp"
+#include "../../../../../data/data.hpp"
+#include "../../../../../file/file.hpp"
+
+using namespace Makai::Anima::V2::Toolchain::Compiler;
+
+using namespace Makai::Anima::V2;
+
+Makai::String Cache::hash(String const& data) {
+	return Makai::Data::encode(
+		Makai::Data::hashed(data.toBytes()),
+		Makai::Data::EncodingType::ET_BASE16
+	);
+}
+
+Makai::String Cache::key(String const& source, StringList const& flags) {
+	// Anything that changes how a module gets compiled has to change its key
+	return hash(
+		Core::Info::ART_VER.serialize().get<String>()
+	+	":" + Core::Info::CONCERTO_VER.serialize().get<String>()
+	+	":" + flags.join(" ")
+	+	":" + source
+	);
+}
+
+Makai::Nullable<Core::Module> Cache::fetch(String const& key) const {
+	auto const path = directory + "/" + key;
+	if (!(OS::FS::exists(path + ".anpb") && OS::FS::exists(path + ".deps")))
+		return nullptr;
+	auto const dependencies = File::getFLOW(path + ".deps");
+	for (auto [file, fileHash]: dependencies.items())
+		if (!OS::FS::exists(file) || hash(File::getText(file)) != fileHash.getString())
+			return nullptr;
+	Nullable<Core::Module> result;
+	Core::BinaryFormat::fromFile(path + ".anpb")
+		.then([&] (auto const& module) {result = module;})
+	;
+	// Entries that fail to load are just rebuilt
+	return result;
+}
+
+void Cache::store(String const& key, Core::Module const& module, Dependencies const& dependencies) const {
+	auto const path = directory + "/" + key;
+	auto deps = Data::Value::object();
+	for (auto const& [file, fileHash]: dependencies)
+		deps[file] = fileHash;
+	Core::BinaryFormat::toBytes(module)
+		.then([&] (auto const& bytes) {
+			OS::FS::makeDirectory(directory);
+			File::saveBinary(path + ".anpb", bytes);
+			File::saveText(path + ".deps", deps.toFLOWString("  "));
+		})
+	;
+}
+
+void Cache::clear() const {
+	if (OS::FS::exists(directory))
+		OS::FS::remove(directory);
+}
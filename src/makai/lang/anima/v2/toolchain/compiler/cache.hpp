@@ -0,0 +1,48 @@
+#ifndef MAKAILIB_ANIMA_V2_TOOLCHAIN_COMPILER_CACHE_H
+#define MAKAILIB_ANIMA_V2_TOOLCHAIN_COMPILER_CACHE_H
+
+#include "../../core/core.hpp"
+
+namespace Makai::Anima::V2::Toolchain::Compiler {
+	/// @brief On-disk cache of compiled modules.
+	/// @details
+	///		Entries are keyed by a hash of the module's source, the toolchain version, and whatever flags it was compiled with.
+	///		Since a module also depends on whatever it imports, each entry also records the files that went into it,
+	///		and only gets reused if none of them changed since.
+	struct Cache {
+		/// @brief Files a module was built from, and the hash of their contents.
+		using Dependencies = Dictionary<String>;
+
+		/// @brief Constructs the cache.
+		/// @param directory Directory to store entries in. Gets created on first store.
+		Cache(String const& directory): directory(directory) {}
+
+		/// @brief Returns the hash of some data, as used by the cache.
+		/// @param data Data to hash.
+		/// @return Hash, as a filename-safe string.
+		static String hash(String const& data);
+
+		/// @brief Returns the key for a given source.
+		/// @param source Source code.
+		/// @param flags Flags that affect the compiled module.
+		/// @return Cache key.
+		static String key(String const& source, StringList const& flags);
+
+		/// @brief Fetches a module from the cache.
+		/// @param key Cache key.
+		/// @return Module, or null if not cached, or if any of the files it was built from changed.
+		Nullable<Core::Module> fetch(String const& key) const;
+		/// @brief Stores a module in the cache.
+		/// @param key Cache key.
+		/// @param module Module to store.
+		/// @param dependencies Files the module was built from, besides its source.
+		void store(String const& key, Core::Module const& module, Dependencies const& dependencies) const;
+		/// @brief Removes every entry in the cache.
+		void clear() const;
+
+		/// @brief Directory entries are stored in.
+		String const directory;
+	};
+}
+
+#endif
@@ -3,6 +3,8 @@
 
 #include "core.hpp"
 #include "project.hpp"
+#include "cache.hpp"
+#include "transpiler.hpp"
 #include "breve/breve.hpp"
 
 #endif
@@ -20,6 +20,7 @@ Makai::Data::Value Project::serialize() const {
 		case Language::AV2_TCPL_MINIMA:	out["lang"]	= "breve"; break;
 		case Language::AV2_TCPL_BREVE:	out["lang"]	= "minima"; break;
 	}
+	out["opt"]		= Assembler::Optimizer::nameOf(optimization);
 	if (!libraries.empty()) {
 		out["lib"] = out.object();
 		for (auto& [name, lib]: libraries) {
@@ -52,6 +53,11 @@ Project Project::deserialize(Makai::Data::Value const& v) {
 	if (lang == "breve")		out.language = Language::AV2_TCPL_BREVE;
 	else if (lang == "minima")	out.language = Language::AV2_TCPL_MINIMA;
 	else throw Makai::Error::NonexistentValue("Invali/unsupported project language!");
+	if (v.contains("opt")) {
+		auto const level = Assembler::Optimizer::levelFromName(v["opt"].getString());
+		if (level)	out.optimization = *level;
+		else throw Makai::Error::NonexistentValue("Invalid/unsupported optimization level!");
+	}
 	if (v.contains("lib")) {
 		auto const libraries = v["lib"].keys();
 		for (auto& lib: libraries) {
@@ -40,6 +40,8 @@ namespace Makai::Anima::V2::Toolchain::Compiler {
 		Type				type;
 		Language			language;
 
+		Assembler::Optimizer::Level	optimization	= Assembler::Optimizer::Level::AV2_TCA_OL_NONE;
+
 		Data::Value serialize() const;
 		static Project deserialize(Data::Value const& v);
 	};
@@ -0,0 +1,242 @@
+#include "transpiler.hpp"
+
+using namespace Makai;
+using namespace Makai::Anima::V2;
+using namespace Makai::Anima::V2::Toolchain::Compiler;
+
+using Core::Instruction;
+
+using Name		= Instruction::Name;
+using JumpMode	= Instruction::Leap::Mode;
+
+struct Section {
+	usize start;
+	usize end;
+
+	constexpr auto operator<=>(Section const& other) const	{return start <=> other.start;	}
+	constexpr bool operator==(Section const& other) const	{return start == other.start;	}
+};
+
+/// Where execution goes after an instruction.
+struct Exit {
+	/// Instruction index the engine would fetch after.
+	usize from;
+	/// Label to jump to.
+	usize to;
+};
+
+/// Whether the instruction gets skipped over during fetch (same as in the engine).
+static bool isFree(Instruction const& inst) {
+	return inst.name == Name::AV2_IN_NO_OP && inst.type;
+}
+
+/// Index of the instruction that gets executed, when fetching from a given index.
+static usize nextOf(Core::Bytecode const& code, usize at) {
+	while (at < code.size() && isFree(code[at])) ++at;
+	return at;
+}
+
+/// Jump/call target known ahead of time, if any (same as the engine resolves it).
+static Nullable<usize> targetOf(Core::Module const& module, usize const at) {
+	auto const& inst	= module.code[at];
+	auto const size		= module.code.size();
+	JumpMode mode = JumpMode::AV2_JM_TABLE_INDEX;
+	if (inst.name == Name::AV2_IN_JUMP) {
+		auto const leap = inst.getTypeAs<Instruction::Leap>();
+		if (leap.dyn) return null;
+		mode = leap.mode;
+	} else if (inst.name == Name::AV2_IN_CALL) {
+		auto const invocation = inst.getTypeAs<Instruction::Invocation>();
+		if (invocation.dynamic || invocation.external) return null;
+	} else return null;
+	if ((at + 1) >= size) return null;
+	auto const location = bitcast<uint64>(module.code[at + 1]);
+	switch (mode) {
+		case JumpMode::AV2_JM_TABLE_INDEX:
+			if (location < module.jumpTable.size()) return module.jumpTable[location];
+		break;
+		case JumpMode::AV2_JM_ABSOLUTE:
+			if (location < size) return location;
+		break;
+		case JumpMode::AV2_JM_RELATIVE: {
+			auto const to = (at + 1) + bitcast<int64>(location);
+			if (to < size) return to;
+		} break;
+	}
+	return null;
+}
+
+/// Whether the engine has to look at the scope or context mode after the instruction, before going on.
+static bool exitsAfter(Instruction const& inst) {
+	switch (inst.name) {
+		case Name::AV2_IN_HALT:
+		case Name::AV2_IN_MODE:
+		case Name::AV2_IN_RETURN:
+		case Name::AV2_IN_SCOPE_EXIT:	return true;
+		case Name::AV2_IN_CALL:			return inst.getTypeAs<Instruction::Invocation>().tail;
+		default: return false;
+	}
+}
+
+/// Splits the code into methods, and whatever lies between them.
+static List<Section> sectionsOf(Core::Module const& module) {
+	auto const size = module.code.size();
+	List<Section> methods;
+	for (auto const& method: module.detail.methods) {
+		if (method.flags.isExternal || !(method.entrypoint < module.jumpTable.size())) continue;
+		auto const start	= module.jumpTable[method.entrypoint];
+		auto const end		= start + method.size;
+		if (start < end && end <= size)
+			methods.pushBack({start, end});
+	}
+	methods.sort();
+	List<Section> result;
+	usize at = 0;
+	for (auto const& method: methods) {
+		// Overlapping methods would have their code compiled twice
+		if (method.start < at) continue;
+		if (method.start > at) result.pushBack({at, method.start});
+		result.pushBack(method);
+		at = method.end;
+	}
+	if (at < size) result.pushBack({at, size});
+	return result;
+}
+
+static String escaped(String const& str) {
+	String result;
+	for (auto const c: str) {
+		if (c == '\\' || c == '"') result.pushBack('\\');
+		result.pushBack(c);
+	}
+	return result;
+}
+
+/// Whether the assumed type is one precompiled code operates on in place (same as `Runtime::Precompiled::canCompare`).
+static bool isFastType(Core::BasicType const type) {
+	return type >= Core::BasicType::AV2_BT_INT8 && type <= Core::BasicType::AV2_BT_REAL64;
+}
+
+/// Call to whatever runs the instruction in the generated code.
+static String stepOf(Core::Module const& module, usize const at) {
+	auto const& inst = module.code[at];
+	auto const hasImmediate = (at + 1) < module.code.size();
+	switch (inst.name) {
+		case Name::AV2_IN_OP: {
+			auto const op = inst.getTypeAs<Instruction::Operation>();
+			auto const fast =
+				op.sameType
+			&&	isFastType(op.assume)
+			&&	(op.op == Core::Operator::AV2_BOP_ADD || op.op == Core::Operator::AV2_BOP_SUB || op.op == Core::Operator::AV2_BOP_MUL)
+			&&	(!op.immediate || hasImmediate)
+			;
+			if (fast) return toString(
+				"Precompiled::operate<Core::Operator(", enumcast(op.op), "), Core::BasicType(", enumcast(op.assume), "), ",
+				op.immediate ? "true" : "false", ">(engine, ", at, ")"
+			);
+		} break;
+		case Name::AV2_IN_COMPARE: {
+			auto const comp = inst.getTypeAs<Instruction::Comparison>();
+			if (comp.sameType && isFastType(comp.assume) && (!comp.immediate || hasImmediate)) return toString(
+				"Precompiled::compare<Core::Comparator(", enumcast(comp.comp), "), Core::BasicType(", enumcast(comp.assume), "), ",
+				comp.immediate ? "true" : "false", ">(engine, ", at, ")"
+			);
+		} break;
+		case Name::AV2_IN_CALL: {
+			auto const invocation = inst.getTypeAs<Instruction::Invocation>();
+			if (invocation.external && !invocation.dynamic && hasImmediate) return toString(
+				"Precompiled::invoke<", bitcast<uint64>(module.code[at + 1]), "ull, ", inst.type, "u>(engine, ", at, ")"
+			);
+		} break;
+		default: break;
+	}
+	return toString("Precompiled::step<Name(", enumcast(inst.name), ")>(engine, ", at, ")");
+}
+
+static String translateSection(Core::Module const& module, Section const& section, usize const index) {
+	auto const& code = module.code;
+	// Instructions in the section, as far as their sizes can be told
+	List<usize> labels;
+	List<bool> isLabel(section.end - section.start, false);
+	for (usize at = section.start; at < section.end;) {
+		auto const length = code[at].size();
+		if (!length) break;
+		if (!isFree(code[at])) {
+			labels.pushBack(at);
+			isLabel[at - section.start] = true;
+		}
+		at += *length;
+	}
+	auto const labelOf = [&] (usize const to) -> Nullable<usize> {
+		auto const next = nextOf(code, to);
+		if (next >= section.start && next < section.end && isLabel[next - section.start])
+			return next;
+		return null;
+	};
+	String out = toString("static void section", index, "(Engine& engine, usize const at) {\n");
+	out += "\tswitch (at) {\n";
+	for (auto const at: labels)
+		out += toString("\t\tcase ", at, ":\tgoto i", at, ";\n");
+	out += "\t\tdefault:\treturn Precompiled::interpret(engine, at);\n";
+	out += "\t}\n";
+	for (auto const at: labels) {
+		auto const& inst	= code[at];
+		auto const step		= stepOf(module, at);
+		out += toString("i", at, ":\t// ", Instruction::asString(inst.name), "\n");
+		// Wherever execution goes next, by the index the engine would fetch from
+		List<Exit> exits;
+		if (!exitsAfter(inst)) {
+			auto const last = at + *inst.size() - 1;
+			if (auto const to = labelOf(last + 1))
+				exits.pushBack({last, *to});
+			if (auto const target = targetOf(module, at); target && *target != last)
+				if (auto const to = labelOf(*target + 1))
+					exits.pushBack({*target, *to});
+		}
+		if (exits.empty()) {
+			out += toString("\t", step, ";\n\treturn;\n");
+			continue;
+		}
+		out += toString("\tswitch (", step, ") {\n");
+		for (auto const& exit: exits)
+			out += toString("\t\tcase ", exit.from, ":\tgoto i", exit.to, ";\n");
+		out += "\t}\n\treturn;\n";
+	}
+	out += "}\n";
+	return out;
+}
+
+String Transpiler::translate(Core::Module const& module) {
+	auto const sections = sectionsOf(module);
+	String out = toString(
+		"// Generated from module \"", escaped(module.name), "\" by the Anima toolchain. Do not edit.\n",
+		"#include <makai/makai.hpp>\n",
+		"\n",
+		"using namespace Makai::Anima::V2;\n",
+		"\n",
+		"using Runtime::Engine;\n",
+		"using Runtime::Precompiled;\n",
+		"\n",
+		"using Name = Core::Instruction::Name;\n"
+	);
+	for (auto const& [section, i]: Range::expand(sections))
+		out += "\n" + translateSection(module, section, i);
+	out += "\nstatic Precompiled::Section const SECTIONS[] = {\n";
+	for (auto const& [section, i]: Range::expand(sections))
+		out += toString("\t{", section.start, ", ", section.end, ", section", i, "},\n");
+	out += "};\n";
+	out += toString(
+		"\n",
+		"struct Program: Precompiled::Library {\n",
+		"\tProgram(): Library({\n",
+		"\t\t", module.fingerprint(), "ull,\n",
+		"\t\tMakai::List<Precompiled::Section>(SECTIONS, sizeof(SECTIONS) / sizeof(Precompiled::Section))\n",
+		"\t}) {}\n",
+		"\n",
+		"\tMakai::String name() const override {return \"", escaped(module.name), "\";}\n",
+		"};\n",
+		"\n",
+		"AV2_Library(Program);\n"
+	);
+	return out;
+}
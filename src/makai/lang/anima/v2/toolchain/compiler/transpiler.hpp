@@ -0,0 +1,23 @@
+#ifndef MAKAILIB_ANIMA_V2_TOOLCHAIN_COMPILER_TRANSPILER_H
+#define MAKAILIB_ANIMA_V2_TOOLCHAIN_COMPILER_TRANSPILER_H
+
+#include "../../core/core.hpp"
+
+namespace Makai::Anima::V2::Toolchain::Compiler {
+	/// @brief Translates modules into C++, for them to be compiled ahead of time.
+	/// @details
+	///		The generated translation unit builds into a dynamic library holding the module's code as `Runtime::Precompiled`,
+	///		which the engine then runs in place of interpreting the module.
+	///
+	///		Every method in the module becomes a function of its own.
+	///		Arithmetic and comparisons on values of a known basic type, and calls to natives known ahead of time, get typed fast paths.
+	///		Code outside of them (or all of it, if the module's symbols were stripped) gets split across functions covering whatever lies between methods.
+	struct Transpiler {
+		/// @brief Translates a module into C++.
+		/// @param module Module to translate.
+		/// @return C++ translation unit.
+		static String translate(Core::Module const& module);
+	};
+}
+
+#endif
@@ -5,70 +5,232 @@ using namespace Makai::Lexer;
 using namespace Makai::Lexer::CStyle;
 using enum TokenStream::Token::Type;
 
+namespace {
+	/// @brief Classification of a single source byte.
+	struct ByteClass {
+		enum Flag: uint8 {
+			LBC_SPACE	= 1 << 0,
+			LBC_NUMBER	= 1 << 1,
+			LBC_WORD	= 1 << 2,
+		};
+
+		/// @brief Flags for every byte. Bytes outside of ASCII get none, as they need to be decoded first.
+		As<uint8[256]> flags	= {};
+		/// @brief Size of the character every byte starts, same as `UTF::U8Char` decodes it.
+		As<uint8[256]> width	= {};
+
+		constexpr ByteClass() {
+			for (usize i = 0; i < 256; ++i) {
+				uint8 sz = 1;
+				if (i & 0b1000'0000)
+					while (((i << sz) & 0b1000'0000) && sz < 4) ++sz;
+				width[i] = sz;
+			}
+			for (char c: {'\n', '\v', '\t', '\r', ' ', '\0'})	flags[uint8(c)] |= LBC_SPACE;
+			for (char c = '0'; c <= '9'; ++c)	flags[uint8(c)] |= LBC_NUMBER;
+			for (char c = 'A'; c <= 'Z'; ++c)	flags[uint8(c)] |= LBC_WORD;
+			for (char c = 'a'; c <= 'z'; ++c)	flags[uint8(c)] |= LBC_WORD;
+			flags[uint8('_')] |= LBC_WORD;
+		}
+	};
+
+	constexpr ByteClass const BYTES;
+
+	/// @brief Unicode ranges considered to be word characters.
+	constexpr As<uint32[16][2]> const WORD_RANGES = {
+		{0x00C0, 0x00D6},
+		{0x00D8, 0x00F6},
+		{0x0590, 0x05FF},
+		{0x0600, 0x077F},
+		{0x0780, 0x07BF},
+		{0x0800, 0x086F},
+		{0x08A0, 0x1FFF},
+		{0x2800, 0x28FF},
+		{0x2C00, 0x2FEF},
+		{0x3040, 0x31FF},
+		{0x3300, 0x4DBF},
+		{0x4E00, 0x9FFF},
+		{0x13000, 0x1467F},
+		{0x20000, 0x2EE5F},
+		{0x2F800, 0x2FA1F},
+		{0x30000, 0x3347F},
+	};
+
+	// Word-at-a-time scanning, used to skip through runs of plain ASCII.
+	// Every mask has the high bit of a byte set if said byte matches, and expects a word with no bytes outside of ASCII.
+
+	constexpr uint64 const ONES		= 0x0101'0101'0101'0101ull;
+	constexpr uint64 const HIGHS	= ONES * 0x80;
+
+	constexpr uint64 equalTo(uint64 const word, uint8 const c) {
+		uint64 const diff = word ^ (ONES * c);
+		return ~(((diff & ~HIGHS) + ~HIGHS) | diff | ~HIGHS);
+	}
+
+	constexpr uint64 inRange(uint64 const word, uint8 const lo, uint8 const hi) {
+		return (word + ONES * (0x80 - lo)) & ~(word + ONES * (0x7F - hi)) & HIGHS;
+	}
+
+	constexpr uint64 blanks(uint64 const word) {
+		return
+			equalTo(word, ' ')
+		|	equalTo(word, '\t')
+		|	equalTo(word, '\v')
+		|	equalTo(word, '\r')
+		|	equalTo(word, '\0')
+		;
+	}
+
+	constexpr uint64 identifiers(uint64 const word) {
+		return
+			inRange(word, '0', '9')
+		|	inRange(word, 'A', 'Z')
+		|	inRange(word, 'a', 'z')
+		|	equalTo(word, '_')
+		;
+	}
+
+	constexpr uint64 numbers(uint64 const word) {
+		return identifiers(word) | equalTo(word, '.');
+	}
+
+	constexpr uint64 lineCommentBody(uint64 const word) {
+		return ~equalTo(word, '\n') & HIGHS;
+	}
+
+	constexpr uint64 blockCommentBody(uint64 const word) {
+		return ~(equalTo(word, '\n') | equalTo(word, '*')) & HIGHS;
+	}
+
+	/// @brief Returns how many bytes, from the start of the word in memory, match the mask.
+	constexpr usize leading(uint64 const mask) {
+		if (mask == HIGHS) return 8;
+		#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+		return __builtin_ctzll(~mask & HIGHS) >> 3;
+		#else
+		return __builtin_clzll(~mask & HIGHS) >> 3;
+		#endif
+	}
+}
+
 struct TokenStream::Lexer {
-	UTF8String const source;
-	UTF8String stream = source;
+	String const	source;
+	cstring const	end		= source.data() + source.size();
+	cstring			cursor	= source.data();
 
-	usize total		= source.size();
+	usize index		= 0;
 	usize curLine	= 0;
 	usize curCol	= 0;
 
-	Lexer(UTF8String const& src): source(src), stream(src), total(src.size()) {}
+	Lexer(String const& src): source(src) {}
 
 	bool empty() const {
-		return stream.empty();
+		return cursor >= end;
+	}
+
+	UTF::U8Char at(cstring const pos) const {
+		if (pos >= end) return {};
+		uint8 const lead = *pos;
+		if (lead < 0x80) return UTF::U8Char(uint32(lead));
+		return UTF::U8Char(pos, end);
+	}
+
+	cstring after(cstring const pos) const {
+		auto const next = pos + BYTES.width[uint8(*pos)];
+		return next < end ? next : end;
 	}
 
 	UTF::U8Char next() {
 		if (empty()) return {};
-		stream.popBack();
+		cursor = after(cursor);
 		if (empty()) return {};
+		++index;
 		++curCol;
-		if (stream.back() == UTF::U8Char{'\n'}) {
+		auto const ch = now();
+		if (ch == UTF::U8Char{'\n'}) {
 			++curLine;
 			curCol = 0;
 		}
-		return stream.back();
+		return ch;
 	}
 
-	UTF::U8Char peek(usize const ahead = 0) const {
-		if ((ahead + 2) < stream.size())
-			return stream[- ahead - 2];
-		return {};
+	UTF::U8Char peek() const {
+		if (empty()) return {};
+		auto const next = after(cursor);
+		if (next >= end || after(next) >= end) return {};
+		return at(next);
 	}
 
 	UTF::U8Char now() const {
-		if (empty()) return {};
-		return stream.back();
+		return at(cursor);
+	}
+
+	/// @brief Skips over bytes matching a mask, a word at a time, for as long as the source is plain ASCII.
+	/// @note Masks must not match newlines, as only the one skipping stops at gets counted.
+	template<class T>
+	void skip(T const& mask) {
+		usize count = 0;
+		while (end - cursor > 8) {
+			uint64 word;
+			MX::memcpy(&word, cursor, 8);
+			if (word & HIGHS) break;
+			auto const run = leading(mask(word));
+			cursor	+= run;
+			count	+= run;
+			if (run < 8) break;
+		}
+		if (!count) return;
+		index	+= count;
+		curCol	+= count;
+		if (now() == UTF::U8Char{'\n'}) {
+			++curLine;
+			curCol = 0;
+		}
+	}
+
+	/// @brief Returns whether a given point in the source up to the current position is plain ASCII, with no null characters.
+	bool plainFrom(cstring start) const {
+		for (; cursor - start >= 8; start += 8) {
+			uint64 word;
+			MX::memcpy(&word, start, 8);
+			if ((word & HIGHS) || equalTo(word, '\0')) return false;
+		}
+		for (; start < cursor; ++start)
+			if (*start <= '\0') return false;
+		return true;
+	}
+
+	/// @brief Returns the value for the text between a given point in the source and the current position.
+	/// @note Plain ASCII gets copied straight from the source, as it would come out the same as encoding the text back.
+	String valueFrom(cstring const start, UTF8String const& text) const {
+		if (plainFrom(start)) return String(start, cursor - start);
+		return text.toString();
+	}
+
+	/// @brief Returns the text between a given point in the source and the current position.
+	UTF8String textFrom(cstring const start) const {
+		if (cursor <= start) return {};
+		if (*(cursor-1) != '\0')
+			return UTF8String(start, cursor - start);
+		// Spans ending in a null character would have it taken as the terminator
+		UTF8String result;
+		for (auto pos = start; pos < cursor; pos = after(pos))
+			result.pushBack(at(pos));
+		return result;
 	}
 };
 
 static bool isNumberChar(UTF::U8Char const ch) {
-	if (ch >= UTF::U8Char{'0'} && ch <= UTF::U8Char{'9'}) return true;
-	return false;
+	auto const id = ch.value();
+	return id < 0x80 && (BYTES.flags[id] & ByteClass::LBC_NUMBER);
 }
 
 static bool isWordChar(UTF::U8Char const ch) {
-	if (ch >= UTF::U8Char{'A'} && ch <= UTF::U8Char{'Z'}) return true;
-	if (ch >= UTF::U8Char{'a'} && ch <= UTF::U8Char{'z'}) return true;
-	if (ch == UTF::U8Char{'_'}) return true;
+	auto const id = ch.value();
+	if (id < 0x80) return BYTES.flags[id] & ByteClass::LBC_WORD;
 	// Unicode Hell, don't even bother checking
-	if (ch >= UTF::U8Char{"\u00C0"} && ch <= UTF::U8Char{"\u00D6"}) return true;
-	if (ch >= UTF::U8Char{"\u00D8"} && ch <= UTF::U8Char{"\u00F6"}) return true;
-	if (ch >= UTF::U8Char{"\u0590"} && ch <= UTF::U8Char{"\u05FF"}) return true;
-	if (ch >= UTF::U8Char{"\u0600"} && ch <= UTF::U8Char{"\u077F"}) return true;
-	if (ch >= UTF::U8Char{"\u0780"} && ch <= UTF::U8Char{"\u07BF"}) return true;
-	if (ch >= UTF::U8Char{"\u0800"} && ch <= UTF::U8Char{"\u086F"}) return true;
-	if (ch >= UTF::U8Char{"\u08A0"} && ch <= UTF::U8Char{"\u1FFF"}) return true;
-	if (ch >= UTF::U8Char{"\u2800"} && ch <= UTF::U8Char{"\u28FF"}) return true;
-	if (ch >= UTF::U8Char{"\u2C00"} && ch <= UTF::U8Char{"\u2FEF"}) return true;
-	if (ch >= UTF::U8Char{"\u3040"} && ch <= UTF::U8Char{"\u31FF"}) return true;
-	if (ch >= UTF::U8Char{"\u3300"} && ch <= UTF::U8Char{"\u4DBF"}) return true;
-	if (ch >= UTF::U8Char{"\u4E00"} && ch <= UTF::U8Char{"\u9FFF"}) return true;
-	if (ch >= UTF::U8Char{"\U00013000"} && ch <= UTF::U8Char{"\U0001467F"}) return true;
-	if (ch >= UTF::U8Char{"\U00020000"} && ch <= UTF::U8Char{"\U0002EE5F"}) return true;
-	if (ch >= UTF::U8Char{"\U0002F800"} && ch <= UTF::U8Char{"\U0002FA1F"}) return true;
-	if (ch >= UTF::U8Char{"\U00030000"} && ch <= UTF::U8Char{"\U0003347F"}) return true;
+	for (auto const& range: WORD_RANGES)
+		if (id >= range[0] && id <= range[1]) return true;
 	return false;
 }
 
@@ -82,13 +244,8 @@ static bool isOtherNumberChar(UTF::U8Char const ch) {
 }
 
 static bool isSpaceChar(UTF::U8Char const ch) {
-	if (ch == UTF::U8Char{'\n'}) return true;
-	if (ch == UTF::U8Char{'\v'}) return true;
-	if (ch == UTF::U8Char{'\t'}) return true;
-	if (ch == UTF::U8Char{'\r'}) return true;
-	if (ch == UTF::U8Char{' '}) return true;
-	if (ch == UTF::U8Char{}) return true;
-	return false;
+	auto const id = ch.value();
+	return id < 0x80 && (BYTES.flags[id] & ByteClass::LBC_SPACE);
 }
 
 static UTF::U8Char unescape(UTF::U8Char const ch) {
@@ -101,37 +258,58 @@ static UTF::U8Char unescape(UTF::U8Char const ch) {
 }
 
 static UTF8String parseString(TokenStream::Lexer& lexer, UTF::U8Char const delim = {'\"'}) {
+	// Closing quotes outside of ASCII can't show up in a plain ASCII run
+	uint8 const stop = delim.value() < 0x80 ? delim.value() : '\\';
+	auto const body = [stop] (uint64 const word) {
+		return ~(equalTo(word, stop) | equalTo(word, '\\') | equalTo(word, '\n')) & HIGHS;
+	};
 	UTF8String result;
-	while (!lexer.empty() && lexer.now() != delim) {
-		if (lexer.now() == UTF::U8Char{'\\'})
+	bool escaped = false;
+	auto segment = lexer.cursor;
+	while (!lexer.empty()) {
+		lexer.skip(body);
+		if (lexer.empty() || lexer.now() == delim) break;
+		if (lexer.now() == UTF::U8Char{'\\'}) {
+			result.appendBack(lexer.textFrom(segment));
 			result.pushBack(unescape(lexer.next()));
-		else result.pushBack(lexer.now());
-		lexer.next();
-		if (lexer.now() == delim) break;
+			lexer.next();
+			segment = lexer.cursor;
+			escaped = true;
+		} else lexer.next();
 	}
+	if (!escaped) return lexer.textFrom(segment);
+	result.appendBack(lexer.textFrom(segment));
 	//MAKAILIB_DEBUGLN_FULL("String: ", result);
 	return result;
 }
 
 static UTF8String parseID(TokenStream::Lexer& lexer) {
-	UTF8String result;
-	while (!lexer.empty() && isIdentifierChar(lexer.now())) {
-		result.pushBack(lexer.now());
+	auto const start = lexer.cursor;
+	while (!lexer.empty()) {
+		lexer.skip(identifiers);
+		if (!isIdentifierChar(lexer.now())) break;
 		lexer.next();
 	}
-	return result;
+	return lexer.textFrom(start);
 }
 
 static UTF8String parseNumber(TokenStream::Lexer& lexer) {
-	UTF8String result;
-	while (isIdentifierChar(lexer.now()) || isOtherNumberChar(lexer.now()) || lexer.now() == UTF::U8Char{'_'}) {
-		if (lexer.now() == UTF::U8Char{'_'}) {
-			lexer.next();
-			continue;
-		}
-		result.pushBack(lexer.now());
+	auto const start = lexer.cursor;
+	while (!lexer.empty()) {
+		lexer.skip(numbers);
+		auto const ch = lexer.now();
+		if (!(isIdentifierChar(ch) || isOtherNumberChar(ch))) break;
 		lexer.next();
 	}
+	bool separated = false;
+	for (auto pos = start; pos < lexer.cursor && !separated; ++pos)
+		separated = *pos == '_';
+	if (!separated) return lexer.textFrom(start);
+	// Digit separators get dropped
+	UTF8String result;
+	for (auto pos = start; pos < lexer.cursor; pos = lexer.after(pos))
+		if (lexer.at(pos) != UTF::U8Char{'_'})
+			result.pushBack(lexer.at(pos));
 	return result;
 }
 
@@ -329,42 +507,52 @@ static void parseOperator(TokenStream::Lexer& lexer, TokenStream::Token& tok) {
 }
 
 static Makai::UTF8String parseBlockComment(TokenStream::Lexer& lexer) {
-	Makai::UTF8String out;
 	lexer.next();
 	lexer.next();
-	while (!(lexer.now() == UTF::U8Char{'*'} && lexer.peek() == UTF::U8Char{'/'})) {
-		out.pushBack(lexer.now());
+	auto const start = lexer.cursor;
+	while (!lexer.empty()) {
+		lexer.skip(blockCommentBody);
+		if (lexer.now() == UTF::U8Char{'*'} && lexer.peek() == UTF::U8Char{'/'}) break;
 		lexer.next();
 	}
+	auto const out = lexer.textFrom(start);
 	lexer.next();
 	lexer.next();
 	return out;
 }
 
 static Makai::UTF8String parseLineComment(TokenStream::Lexer& lexer) {
-	Makai::UTF8String out;
 	lexer.next();
 	lexer.next();
-	while (lexer.now() != UTF::U8Char{'\n'}) {
-		out.pushBack(lexer.now());
+	auto const start = lexer.cursor;
+	while (!lexer.empty()) {
+		lexer.skip(lineCommentBody);
+		if (lexer.now() == UTF::U8Char{'\n'}) break;
+		lexer.next();
+	}
+	return lexer.textFrom(start);
+}
+
+static void skipSpaces(TokenStream::Lexer& lexer) {
+	while (!lexer.empty()) {
+		lexer.skip(blanks);
+		if (!isSpaceChar(lexer.now())) break;
 		lexer.next();
 	}
-	return out;
 }
 
 bool TokenStream::next() {
 	if (!lexer || isFinished) return false;
-	while (isSpaceChar(lexer->now()) && !lexer->empty())
-		lexer->next();
+	skipSpaces(*lexer);
 	if (lexer->empty()) {
 		isFinished = true;
 		return false;
 	}
-	UTF::U8String lexeme;
 	curToken = {.at = position()};
+	auto const start = lexer->cursor;
 	//MAKAILIB_DEBUGLN_FULL("Char: ", (char)lexer->now().value(), ", next: ", (char)lexer->peek().value());
 	if (isNumberChar(lexer->now()) || ((lexer->now() == UTF::U8Char{'.'}) && isNumberChar(lexer->peek()))) {
-		lexeme = parseNumber(*lexer);
+		auto const lexeme = parseNumber(*lexer);
 		try {
 			if (lexeme.find({'.'}) == -1) {
 				curToken.type = Token::Type::LTS_TT_INTEGER;
@@ -377,37 +565,32 @@ bool TokenStream::next() {
 			err = Error{e.what(), curToken.at, lexeme};
 			isFinished = true;
 		}
+		curToken.text = lexeme;
 	}
 	else if (lexer->now() == UTF::U8Char{'/'} && lexer->peek() == UTF::U8Char{'*'}) {
-		lexeme = parseBlockComment(*lexer);
-		curToken.text = lexeme;
-		curToken.value = curToken.text.toString();
-		curToken.type = LTS_TT_BLOCK_COMMENT;
+		curToken.text	= parseBlockComment(*lexer);
+		curToken.value	= curToken.text.toString();
+		curToken.type	= LTS_TT_BLOCK_COMMENT;
 	}
 	else if (lexer->now() == UTF::U8Char{'/'} && lexer->peek() == UTF::U8Char{'/'}) {
-		lexeme = parseLineComment(*lexer);
-		curToken.text = lexeme;
-		curToken.value = curToken.text.toString();
-		curToken.type = LTS_TT_LINE_COMMENT;
+		curToken.text	= parseLineComment(*lexer);
+		curToken.value	= lexer->valueFrom(start + 2, curToken.text);
+		curToken.type	= LTS_TT_LINE_COMMENT;
 	}
 	else if (isWordChar(lexer->now())) {
-		lexeme = parseID(*lexer);
-		curToken.text = lexeme;
-		curToken.value = curToken.text.toString();
-		curToken.type = LTS_TT_IDENTIFIER;
+		curToken.text	= parseID(*lexer);
+		curToken.value	= lexer->valueFrom(start, curToken.text);
+		curToken.type	= LTS_TT_IDENTIFIER;
 	}
 	else if (closingQuote(lexer->now()) != UTF::U8Char{}) {
 		auto const quot = closingQuote(lexer->now());
 		curToken.type = stringType(lexer->now());
 		lexer->next();
-		lexeme = parseString(*lexer, quot);
-		curToken.text	= lexeme;
+		curToken.text	= parseString(*lexer, quot);
 		curToken.value	= curToken.text.toString();
 		lexer->next();
 	}
 	else parseOperator(*lexer, curToken);
-	if (lexeme.size())
-		curToken.text = lexeme;
 	if (lexer->empty())
 		isFinished = true;
 	//MAKAILIB_DEBUGLN_FULL("Type: ", Token::asName(curToken.type));
@@ -436,7 +619,7 @@ TokenStream::Position TokenStream::position() const {
 
 usize TokenStream::location() const {
 	if (!lexer) return -1;
-	return lexer->total - lexer->source.size();
+	return lexer->index;
 }
 
 void TokenStream::assertOK() const {
@@ -451,12 +634,18 @@ void TokenStream::assertOK() const {
 }
 
 TokenStream::TokenStream(UTF8String const& source)	{open(source);	}
+TokenStream::TokenStream(String const& source)		{open(source);	}
 TokenStream::TokenStream()							{				}
 TokenStream::~TokenStream()							{close();		}
 
 CStyle::TokenStream& TokenStream::open(UTF8String const& source) {
 	if (lexer) return *this;
-	lexer.bind(new Lexer{source.reversed()});
+	return open(source.toString());
+}
+
+CStyle::TokenStream& TokenStream::open(String const& source) {
+	if (lexer) return *this;
+	lexer.bind(new Lexer{source});
 	//MAKAILIB_DEBUGLN_FULL("Source size: ", lexer->source.size());
 	err = nullptr;
 	isFinished = false;
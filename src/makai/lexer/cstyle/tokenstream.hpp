@@ -279,12 +279,24 @@ namespace Makai::Lexer::CStyle {
 		/// @note Source is copied, so there's no need to keep it around.
 		TokenStream(UTF8String const& source);
 
+		/// @brief Opens the token stream.
+		/// @param source Source content to process, as UTF-8 bytes.
+		/// @note Source is copied, so there's no need to keep it around.
+		TokenStream(String const& source);
+
 		/// @brief Opens the token stream.
 		/// @param source Source content to process.
 		/// @return Reference to self.
 		/// @note Source is copied, so there's no need to keep it around.
 		TokenStream& open(UTF8String const& source);
 
+		/// @brief Opens the token stream.
+		/// @param source Source content to process, as UTF-8 bytes.
+		/// @return Reference to self.
+		/// @note Source is copied, so there's no need to keep it around.
+		///		The lexer works directly on the bytes, so this avoids a round trip through `UTF8String`.
+		TokenStream& open(String const& source);
+
 		/// @brief Closes the token stream.
 		/// @return Reference to self.
 		TokenStream& close();
@@ -281,7 +281,8 @@ namespace Makai::Tool::Arch {
 		/// @brief Archive file structure.
 		Data::Value		fstruct;
 		/// @brief Synchronization barrier for thread safety.
-		mutable Mutex	sync;
+		/// @note Recursive, as locked methods call into each other.
+		mutable Mutex	sync{true};
 	};
 }
 
@@ -0,0 +1,77 @@
+#include <makai/makai.hpp>
+#include <thread>
+#include <vector>
+
+using Makai::Anima::V2::Core::Pool;
+
+constexpr usize THREADS	= 4;
+constexpr usize BLOCKS	= 4096;
+constexpr usize ROUNDS	= 16;
+
+static void expect(bool const condition, Makai::String const& what) {
+	if (!condition) throw Makai::Error::FailedAction(what, CTL_CPP_PRETTY_SOURCE);
+}
+
+static std::vector<pointer> allocateBlocks(Pool& pool, usize const offset) {
+	Pool::Scope const scope(pool);
+	std::vector<pointer> blocks;
+	for (usize i = 0; i < BLOCKS; ++i)
+		blocks.push_back(Pool::acquire(8 + ((i + offset) % (Pool::MAX_BLOCK_SIZE + 64)), i & 1));
+	return blocks;
+}
+
+static void releaseFromThreads(std::vector<pointer> const& blocks) {
+	std::vector<std::thread> threads;
+	for (usize t = 0; t < THREADS; ++t)
+		threads.emplace_back([&, t] {
+			for (usize i = t; i < blocks.size(); i += THREADS)
+				Pool::release(blocks[i]);
+		});
+	for (auto& thread: threads)
+		thread.join();
+}
+
+void testCrossThreadRelease() {
+	Pool::Handle pool;
+	for (usize round = 0; round < ROUNDS; ++round) {
+		auto const blocks = allocateBlocks(*pool, round);
+		expect(pool->statistics().liveBlocks == BLOCKS, "Live block count is wrong after allocating!");
+		// Allocates from the owning thread while other threads release into the same pool.
+		std::vector<pointer> more;
+		std::thread releaser([&] {releaseFromThreads(blocks);});
+		more = allocateBlocks(*pool, round + 1);
+		releaser.join();
+		releaseFromThreads(more);
+		auto const stats = pool->statistics();
+		expect(stats.liveBlocks == 0, "Blocks were lost across threads!");
+		expect(stats.liveObjects == 0, "Objects were lost across threads!");
+		expect(stats.heapBlocks == 0, "Heap blocks were lost across threads!");
+	}
+	pool->trim();
+	expect(pool->statistics().slabs == 0, "Pool did not trim!");
+}
+
+void testRetiredPool() {
+	// The pool outlives its handle, and gets freed by whichever thread releases its last block.
+	for (usize round = 0; round < ROUNDS; ++round) {
+		std::vector<pointer> blocks;
+		{
+			Pool::Handle pool;
+			blocks = allocateBlocks(*pool, round);
+		}
+		releaseFromThreads(blocks);
+	}
+}
+
+int main() {
+	DEBUGLN("Running app ", __FILE__, "...");
+	try {
+		testCrossThreadRelease();
+		testRetiredPool();
+		DEBUGLN("Pool tests passed!");
+	} catch (Makai::Error::Generic const& e) {
+		DEBUGLN(e.report());
+		return 1;
+	}
+	return 0;
+}
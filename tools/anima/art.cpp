@@ -84,8 +84,11 @@ struct ARTE: Makai::Anima::V2::Runtime::Engine {
 
 	ARTE(
 		bool const allowDynlibs	= false,
-		BuiltinAPI const bapi	= {false, false}
-	): Engine(Config{allowDynlibs}), bapi(bapi) {
+		BuiltinAPI const bapi	= {false, false},
+		bool const jit			= false,
+		bool const profile		= false,
+		Makai::String const& precompiled = ""
+	): Engine(Config{.allowDynamicLibraries = allowDynlibs, .jit = jit, .profile = profile, .precompiled = precompiled}), bapi(bapi) {
 	}
 
 	void onLoad() override {
@@ -113,6 +116,9 @@ struct ARTEMain: Makai::AMain {
 		cfg["add-sources"]		= cfg.array();
 		cfg["bapi:console"]		= false;
 		cfg["bapi:time"]		= false;
+		cfg["jit"]				= false;
+		cfg["profile"]			= "";
+		cfg["precompiled"]		= "";
 		return cfg;
 	}
 
@@ -124,6 +130,9 @@ struct ARTEMain: Makai::AMain {
 		tl["i"]		= "add-sources";
 		tl["BA:C"]	= "bapi-console";
 		tl["BA:T"]	= "bapi-time";
+		tl["J"]		= "jit";
+		tl["p"]		= "profile";
+		tl["aot"]	= "precompiled";
 	}
 
 	ARTEMain(Makai::CLI::Parser& cli): AMain(cli) {
@@ -143,18 +152,31 @@ struct ARTEMain: Makai::AMain {
 		));
 	}
 
+	static void saveProfile(ARTE const& engine, Makai::String const& path) {
+		auto const profile = engine.profile();
+		if (!profile) return;
+		auto const report = profile->report();
+		Makai::File::saveText(path + ".flow",	report.toFLOWString("  "));
+		Makai::File::saveText(path + ".json",	report.toJSONString("  "));
+		Makai::File::saveText(path + ".folded",	profile->stacks());
+	}
+
 	void run(Makai::Data::Value const& args) override {
 		if (args.fetch("help", false)) {
 			writeLine("Anima RunTime - V" + VER.serialize().get<Makai::String>());
 			writeLine("Available commands:");
-			writeLine("art <program> [-BA:C] [-BA:T] [-DL] [-B] [-S]");
+			writeLine("art <program> [-BA:C] [-BA:T] [-DL] [-B] [-S] [-J] [-p <output>] [-aot <precompiled-library>]");
 		} else {
+			auto const precompiled = args["precompiled"].getString();
 			ARTE engine{
-				args["allow-dynlibs"].getBoolean(),
+				args["allow-dynlibs"].getBoolean() || !precompiled.empty(),
 				{
 					args["bapi-console"].getBoolean(),
 					args["bapi-time"].getBoolean()
-				}
+				},
+				args.fetch("jit", false),
+				!args["profile"].getString().empty(),
+				precompiled
 			};
 			Makai::Anima::V2::Core::Module file;
 			if (!args.fetch("script", false)) {
@@ -162,7 +184,7 @@ struct ARTEMain: Makai::AMain {
 				Makai::String fpath = args["__args"][0].getString();
 				if (Makai::OS::FS::exists(fpath + ext[args.fetch("binary-first", false)]))
 					file = Makai::File::getFLOW(fpath + ext[args.fetch("binary-first", false)]);
-				else Makai::Anima::V2::Core::BinaryFormat::fromBytes(Makai::File::getBinary(fpath + ext[!args.fetch("binary-first", false)]))
+				else Makai::Anima::V2::Core::BinaryFormat::fromFile(fpath + ext[!args.fetch("binary-first", false)])
 					.then([&] (auto const e) {file = e;})
 					.onError([&] (auto const e) {throw Makai::Error::FailedAction(e.message, CTL_CPP_PRETTY_SOURCE);})
 				;
@@ -257,6 +279,7 @@ struct ARTEMain: Makai::AMain {
 				DEBUGLN("Frame!");
 			}
 			DEBUGLN("</art:output>");
+			saveProfile(engine, args["profile"].getString());
 			engine.error().then(handleError);
 		}
 	}
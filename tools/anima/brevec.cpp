@@ -17,6 +17,9 @@ static Makai::Data::Value configBase() {
 	cfg["level"]	= "full";
 	cfg["binary"]	= false;
 	cfg["pretty"]	= false;
+	cfg["optimize"]	= "none";
+	cfg["cache"]	= "";
+	cfg["time-passes"]	= false;
 	return cfg;
 }
 
@@ -29,12 +32,29 @@ static void translationBase(Makai::CLI::Parser::Translation& tl) {
 	tl["P"]	= "pretty";
 	tl["B"]	= "binary";
 	tl["p"]	= "pipe";
+	tl["O"]	= "optimize";
+	tl["c"]	= "cache";
+	tl["T"]	= "time-passes";
+}
+
+static Assembler::Optimizer::Level optimizationLevel(Makai::Data::Value const& opt) {
+	if (opt.isBoolean())
+		return opt.get<bool>() ? Assembler::Optimizer::Level::AV2_TCA_OL_FULL : Assembler::Optimizer::Level::AV2_TCA_OL_NONE;
+	auto const level = Assembler::Optimizer::levelFromName(opt.getString());
+	if (!level) throw Makai::Error::InvalidValue("Invalid optimization level \"" + opt.getString() + "\"!");
+	return *level;
+}
+
+static void reportPasses(Assembler::Statistics const& stats, Makai::Data::Value const& cfg) {
+	DEBUG(stats.summary());
+	if (cfg["time-passes"].isString())
+		Makai::File::saveText(cfg["time-passes"].getString(), stats.report().toFLOWString("  "));
 }
 
 static void doHelpMessage() {
 	DEBUGLN("Breve Compiler - V" + VER.serialize().get<Makai::String>());
 	DEBUGLN("Usage:");
-	DEBUGLN(R"(    brevec <file> [--output <name>] [-l <compilation-level>] [--src "[<source-dirs> ...]"] [-W] [-S])");
+	DEBUGLN(R"(    brevec <file> [--output <name>] [-l <compilation-level>] [--src "[<source-dirs> ...]"] [-O | --optimize <none|basic|full>] [-W] [-S] [-c | --cache <cache-dir>] [-T | --time-passes <report-file>])");
 }
 
 int main(int argc, char** argv) try {
@@ -43,20 +63,29 @@ int main(int argc, char** argv) try {
 	Makai::CLI::Parser cli(argc, argv);
 	translationBase(cli.tl);
 	auto cfg = cli.parse(configBase());
-	Transformer::Import::importer = [dirs = Makai::FLOW::parse(cfg["src"].getString()).getArray().toList<Makai::String>()] (auto const path) -> File {
+	Compiler::Cache::Dependencies dependencies;
+	Transformer::Import::importer = [dirs = Makai::FLOW::parse(cfg["src"].getString()).getArray().toList<Makai::String>(), &dependencies] (auto const path) -> File {
 		static Makai::Dictionary<File> cache;
+		auto const load = [&] (Makai::String const& fpath) {
+			auto const text = Makai::File::getText(fpath);
+			dependencies[fpath] = Compiler::Cache::hash(text);
+			return cache[path] = parseFile(fpath, text);
+		};
 		if (path.empty()) throw Makai::Error::FailedAction("Module name is empty!");
 		if (cache.contains(path)) return cache[path];
 		if (Makai::OS::FS::exists(path + ".bv"))
-			return cache[path] = parseFile(path + ".bv", Makai::File::getText(path + ".bv"));
+			return load(path + ".bv");
 		auto const brevecDir = Makai::OS::FS::sourceLocation() + "/anima/breve/lib";
 		if (Makai::OS::FS::exists(brevecDir + "/" + path + ".bv"))
-			return cache[path] = parseFile(brevecDir + "/" + path + ".bv", Makai::File::getText(brevecDir + "/" + path + ".bv"));
+			return load(brevecDir + "/" + path + ".bv");
 		for (auto& dir: dirs)
 			if (Makai::OS::FS::exists(dir + "/" + path + ".bv"))
-				return cache[path] = parseFile(dir + "/" + path + ".bv", Makai::File::getText(dir + "/" + path + ".bv"));
+				return load(dir + "/" + path + ".bv");
 		throw Makai::Error::FailedAction("Failed to find module '" + path + "'");
 	};
+	Assembler::Statistics stats;
+	if (!cfg["time-passes"].isBoolean() || cfg["time-passes"].get<bool>())
+		Assembler::Statistics::active = &stats;
 	if (cfg["help"])
 		doHelpMessage();
 	else {
@@ -81,6 +110,7 @@ int main(int argc, char** argv) try {
 				.splitAtLast('.').front()
 		);
 		auto const outPath = Makai::OS::FS::currentDirectory() + "/" + outName;
+		auto const optimization = optimizationLevel(cfg["optimize"]);
 		DEBUGLN("Level: ", level);
 		if (level == "parse-tree" || level == "parse") {
 			Makai::File::saveText(
@@ -97,11 +127,34 @@ int main(int argc, char** argv) try {
 				outPath + ".min",
 				compile(outName, cfg.contains("pipe") ? file : Makai::File::getText(file), CompilationLevel::AV2_TCB_CCL_MINIMA).getString()
 			);
+		} else if (level == "native" || level == "cpp") {
+			Makai::File::saveText(
+				outPath + ".cpp",
+				Compiler::Transpiler::translate(compile(outName, cfg.contains("pipe") ? file : Makai::File::getText(file), "", optimization))
+			);
 		} else {
 			Makai::Data::Value::Padding pad;
 			if (cfg.fetch("pretty", false))
 				pad = Makai::String("  ");
-			auto const out = compile(outName, cfg.contains("pipe") ? file : Makai::File::getText(file));
+			auto const source = cfg.contains("pipe") ? file : Makai::File::getText(file);
+			auto const cacheDir = cfg.fetch<Makai::String>("cache", "");
+			Core::Module out;
+			if (cacheDir.empty())
+				out = compile(outName, source, "", optimization);
+			else {
+				Compiler::Cache const cache(cacheDir);
+				auto const key = Compiler::Cache::key(
+					source,
+					Makai::StringList::from(outName, Assembler::Optimizer::nameOf(optimization), cfg["src"].getString())
+				);
+				if (auto const cached = cache.fetch(key)) {
+					DEBUGLN("Up to date, using cached module");
+					out = *cached;
+				} else {
+					out = compile(outName, source, "", optimization);
+					cache.store(key, out, dependencies);
+				}
+			}
 			if (cfg.fetch("binary", false))
 				Core::BinaryFormat::toBytes(out, cfg.fetch("strip", false))
 					.then(
@@ -122,6 +175,8 @@ int main(int argc, char** argv) try {
 				out.serialize(!cfg.fetch("strip", false)).toFLOWString(pad)
 			);
 		}
+		if (Assembler::Statistics::active)
+			reportPasses(stats, cfg);
 	}
 	return 0;
 } catch (Makai::Error::Generic const& e) {
@@ -4,6 +4,10 @@
 #include <makai/main.hpp>
 #include "base.cc"
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 using namespace Makai::Anima::V2;
 
 using namespace Toolchain;
@@ -37,8 +41,11 @@ constexpr auto const MAINFILE_MIN = R"###()###";
 constexpr auto const PROJ_GITIGNORE = R"###(
 output/*
 lib/*
+.cache/*
 )###";
 
+constexpr auto const MODULE_CACHE = ".cache/modules";
+
 struct ConcertoMain: Makai::AMain {
 	using Project = Makai::Anima::V2::Toolchain::Compiler::Project;
 
@@ -49,6 +56,8 @@ struct ConcertoMain: Makai::AMain {
 		cfg["type"]		= "prog";
 		cfg["lang"]		= "breve";
 		cfg["bin"]		= true;
+		cfg["jobs"]		= 0;
+		cfg["time-passes"]	= false;
 		return cfg;
 	}
 
@@ -56,6 +65,8 @@ struct ConcertoMain: Makai::AMain {
 		tl["H"]	= "help";
 		tl["W"]	= "write";
 		tl["B"]	= "bin";
+		tl["j"]	= "jobs";
+		tl["T"]	= "time-passes";
 	}
 
 	ConcertoMain(Makai::CLI::Parser& cli): AMain(cli) {
@@ -105,6 +116,108 @@ struct ConcertoMain: Makai::AMain {
 		Makai::File::saveText(projName + "/.gitignore", PROJ_GITIGNORE);
 	}
 
+	struct Library {
+		Makai::String		path;
+		Makai::String		name;
+		Makai::StringList	imports;
+		int					result	= 0;
+		Makai::String		failure;
+	};
+
+	static usize jobCount(Makai::Data::Value const& args) {
+		usize const jobs = args["jobs"].isString() ? Makai::toUnsignedInt(args["jobs"].getString()) : 0;
+		if (jobs) return jobs;
+		return Makai::Math::max<usize>(std::thread::hardware_concurrency(), 1);
+	}
+
+	static Makai::StringList sourceFilesIn(Makai::String const& folder) {
+		auto files = Makai::OS::FS::filesIn(folder);
+		for (auto const& sub: Makai::OS::FS::foldersIn(folder))
+			files.appendBack(sourceFilesIn(sub));
+		return files;
+	}
+
+	/// Returns the modules a library's sources import from, by the first part of their import path.
+	static Makai::StringList importsOf(Makai::String const& path, Project const& project) {
+		Makai::StringList imports;
+		for (auto const& src: project.sources)
+			for (auto const& file: sourceFilesIn(path + "/" + src))
+				for (auto const& match: Makai::Regex::find(Makai::File::getText(file), R"re(\bimport\s+[A-Za-z_][\w.]*)re"))
+					imports.pushBack(Makai::Regex::replace(match.match, R"re(^import\s+)re", "").splitAtFirst('.').front());
+		for (auto const& [name, lib]: project.libraries)
+			imports.pushBack(name);
+		return imports;
+	}
+
+	/// Builds whatever libraries are not built yet, in dependency order, running independent ones concurrently.
+	void buildLibraries(Makai::String const& target, usize const jobs) {
+		auto cache = Makai::OS::FS::exists("lib/.cache/.cache")
+		?	Makai::File::getFLOW("lib/.cache/.cache")
+		:	Makai::FLOW::Value::object();
+		;
+		Makai::List<Library> pending;
+		auto libs = Makai::OS::FS::foldersIn("lib");
+		libs.sort();
+		for (auto& lib: libs) {
+			auto const folder = Makai::OS::FS::childPath(lib);
+			if (folder.empty() || folder.front() == '.' || cache.contains(lib)) continue;
+			auto const project = Project::deserialize(Makai::File::getFLOW(lib + "/project.flow"));
+			pending.pushBack({lib, project.name, importsOf(lib, project)});
+		}
+		while (!pending.empty()) {
+			// Anything that does not import a library still waiting to be built can be built right away
+			Makai::List<Library> wave, rest;
+			for (auto& lib: pending) {
+				bool ready = true;
+				for (auto const& other: pending)
+					if (&other != &lib && lib.imports.find(other.name) != -1)
+						ready = false;
+				(ready ? wave : rest).pushBack(lib);
+			}
+			if (wave.empty())
+				error("Circular dependency between libraries [" + pending.toList<Makai::String>([] (auto const& lib) {return lib.name;}).join(", ") + "]!");
+			std::atomic<usize> next = 0;
+			auto const work = [&] {
+				// Exceptions cannot leave a worker, so failing to launch a build gets recorded as a failed build
+				for (usize i; (i = next++) < wave.size();) try {
+					wave[i].result = Makai::OS::launch(
+						Makai::OS::FS::sourceLocation() + Makai::OS::FS::asExecutable("/concerto"),
+						Makai::OS::FS::currentDirectory() + "/" + wave[i].path,
+						Makai::StringList::from("build", target, "-j", Makai::toString(jobs))
+					);
+				} catch (Makai::Error::Generic const& e) {
+					wave[i].result	= -1;
+					wave[i].failure	= e.message;
+				} catch (...) {
+					wave[i].result	= -1;
+					wave[i].failure	= "could not launch build";
+				}
+			};
+			std::vector<std::thread> workers;
+			for (usize i = 1; i < Makai::Math::min(jobs, wave.size()); ++i)
+				workers.emplace_back(work);
+			work();
+			for (auto& worker: workers)
+				worker.join();
+			// Results get collected in the same order regardless of which build finished first
+			Makai::StringList failed;
+			for (auto& lib: wave) {
+				if (lib.result) {
+					failed.pushBack(lib.failure.empty() ? lib.name : (lib.name + " (" + lib.failure + ")"));
+					continue;
+				}
+				cache[lib.path] = true;
+				auto const outDir = "lib/.cache/" + Makai::OS::FS::childPath(lib.path);
+				Makai::OS::FS::makeDirectory(outDir);
+				Makai::OS::FS::copy(lib.path + "/output/*", outDir);
+			}
+			Makai::File::saveText("lib/.cache/.cache", cache.toFLOWString("  "));
+			if (!failed.empty())
+				error("Failed to build libraries [" + failed.join(", ") + "]!");
+			pending = rest;
+		}
+	}
+
 	void doBuild(Makai::Data::Value const& args) {
 		if (args["__args"].size() < 2)
 			error("Missing build target!");
@@ -125,38 +238,32 @@ struct ConcertoMain: Makai::AMain {
 			} break;
 			case Project::Type::AV2_TCPT_BIN_PROGRAM:
 			case Project::Type::AV2_TCPT_WEB_PROGRAM: {
-				if (Makai::OS::FS::isDirectory("lib")) {
-					auto cache = Makai::OS::FS::exists("lib/.cache/.cache")
-					?	Makai::File::getFLOW("lib/.cache/.cache")
-					:	Makai::FLOW::Value::object();
-					;
-					auto const libs = Makai::OS::FS::foldersIn("lib");
-					for (auto& lib: libs) {
-						if (cache.contains(lib)) continue;
-						cache[lib] = true;
-						Makai::OS::launch(
-							Makai::OS::FS::sourceLocation() + Makai::OS::FS::asExecutable("/concerto"),
-							Makai::OS::FS::currentDirectory() + "/" + lib,
-							Makai::StringList::from("build", target)
-						);
-						auto const outDir = "lib/.cache/" + Makai::OS::FS::childPath(lib);
-						Makai::OS::FS::makeDirectory(outDir);
-						Makai::OS::FS::copy(lib + "/output/*", outDir);
-					}
-					Makai::File::saveText("lib/.cache/.cache", cache.toFLOWString("  "));
+				if (Makai::OS::FS::isDirectory("lib"))
+					buildLibraries(target, jobCount(args));
+				auto compilerArgs = Makai::StringList::from(
+					project.main,
+					"-S",
+					project.type == Project::Type::AV2_TCPT_BIN_PROGRAM ? "-B" : "",
+					"-o",
+					"../output/" +  project.name,
+					"--optimize",
+					Assembler::Optimizer::nameOf(project.optimization),
+					"-s",
+					"[" + project.sources.join(" ") + (Makai::OS::FS::isDirectory("lib/.cache") ? " lib/.cache" : "") + "]"
+				);
+				if (project.language == Project::Language::AV2_TCPL_BREVE) {
+					// Unchanged programs get pulled from the module cache, instead of being rebuilt
+					compilerArgs.appendBack(Makai::StringList::from("--cache", Makai::OS::FS::currentDirectory() + "/" + MODULE_CACHE));
+					auto const& timePasses = args["time-passes"];
+					if (timePasses.isString())
+						compilerArgs.appendBack(Makai::StringList::from("--time-passes", Makai::OS::FS::absolute(timePasses.getString())));
+					else if (timePasses.get<bool>())
+						compilerArgs.pushBack("-T");
 				}
 				Makai::OS::launch(
 					Makai::OS::FS::sourceLocation() + "/" + Makai::OS::FS::asExecutable(compiler),
 					Makai::OS::FS::currentDirectory() + "/src",
-					Makai::StringList::from(
-						project.main,
-						"-S",
-						project.type == Project::Type::AV2_TCPT_BIN_PROGRAM ? "-B" : "",
-						"-o",
-						"../output/" +  project.name,
-						"-s",
-						"[" + project.sources.join(" ") + (Makai::OS::FS::isDirectory("lib/.cache") ? " lib/.cache" : "") + "]"
-					)
+					compilerArgs
 				);
 			} break;
 			case Project::Type::AV2_TCPT_EXECUTABLE:
@@ -168,14 +275,17 @@ struct ConcertoMain: Makai::AMain {
 		if (args["__args"].size() < 2)
 			error("Missing cache action!");
 		auto const verb = args["__args"][1].getString();
-		if (verb == "clear") Makai::OS::FS::remove("lib/.cache");
+		if (verb == "clear") {
+			Makai::OS::FS::remove("lib/.cache");
+			Compiler::Cache(MODULE_CACHE).clear();
+		}
 		else error("Invalid cache action [" + verb + "]!");
 	}
 
 	void doHelp(Makai::Data::Value const& args) {
 		writeLine("Concerto - V" + VER.serialize().get<Makai::String>());
 		writeLine("Available commands:");
-		writeLine("concerto <action>");
+		writeLine("concerto <action> [-j <jobs>] [-T | --time-passes <report-file>]");
 	}
 
 	void run(Makai::Data::Value const& args) override {
@@ -187,6 +297,7 @@ struct ConcertoMain: Makai::AMain {
 			auto const verb = args["__args"][0].getString();
 			if (verb == "create")		doCreate(args);
 			else if (verb == "build")	doBuild(args);
+			else if (verb == "cache")	doCache(args);
 			else error("Invalid action [" + verb + "]!");
 		}
 	}
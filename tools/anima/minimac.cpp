@@ -11,6 +11,7 @@ static Makai::Data::Value configBase() {
 	cfg["link"]		= cfg.array();
 	cfg["strip"]	= false;
 	cfg["pretty"]	= false;
+	cfg["optimize"]	= "none";
 	return cfg;
 }
 
@@ -21,12 +22,21 @@ static void translationBase(Makai::CLI::Parser::Translation& tl) {
 	tl["S"]	= "strip";
 	tl["P"]	= "pretty";
 	tl["p"]	= "pipe";
+	tl["O"]	= "optimize";
+}
+
+static Assembler::Optimizer::Level optimizationLevel(Makai::Data::Value const& opt) {
+	if (opt.isBoolean())
+		return opt.get<bool>() ? Assembler::Optimizer::Level::AV2_TCA_OL_FULL : Assembler::Optimizer::Level::AV2_TCA_OL_NONE;
+	auto const level = Assembler::Optimizer::levelFromName(opt.getString());
+	if (!level) throw Makai::Error::InvalidValue("Invalid optimization level \"" + opt.getString() + "\"!");
+	return *level;
 }
 
 static void doHelpMessage() {
 	DEBUGLN("Minima Compiler - V" + VER.serialize().get<Makai::String>());
 	DEBUGLN("Usage:");
-	DEBUGLN(R"(minimac (<file> OR -p <code>) [--output <name>] [--link "[<modules> ...]"])");
+	DEBUGLN(R"(minimac (<file> OR -p <code>) [--output <name>] [--link "[<modules> ...]"] [-O | --optimize <none|basic|full>])");
 	DEBUGLN("init");
 }
 
@@ -51,7 +61,10 @@ int main(int argc, char** argv) try {
 				.splitAtLast('.').front()
 		);
 		auto const outPath = Makai::OS::FS::currentDirectory() + "/" + outName;
-		auto const out = Assembler::Minima::assemble(outName, file, cfg["strip"]);
+		auto const out = Assembler::Optimizer::optimize(
+			Assembler::Minima::assemble(outName, file, cfg["strip"]),
+			optimizationLevel(cfg["optimize"])
+		);
 		DEBUGLN("Done!");
 		Makai::Data::Value::Padding pad;
 		if (cfg.fetch("pretty", false))